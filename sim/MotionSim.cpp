@@ -0,0 +1,616 @@
+/*
+      This file is part of Smoothie (http://smoothieware.org/). The motion control part is heavily based on Grbl (https://github.com/simen/grbl).
+      Smoothie is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+      Smoothie is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+      You should have received a copy of the GNU General Public License along with Smoothie. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "MotionSim.h"
+#include "sim_hal.h"
+
+#include "libs/Kernel.h"
+#include "libs/StepTicker.h"
+#include "libs/StepperMotor.h"
+#include "libs/StreamOutputPool.h"
+#include "modules/robot/Robot.h"
+#include "modules/robot/Conveyor.h"
+#include "modules/robot/Planner.h"
+#include "modules/robot/InputShaper.h"
+#include "modules/robot/arm_solutions/BaseSolution.h"
+#include "mbed.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <string.h>
+#include <cfloat>
+
+// furthest the shaped motors may be from the analytic shaped motion, in steps. The segmenter only works out the shaped
+// position at the end of each segment and the steps are spread evenly over it, so it is off by a little in between
+#define SHAPER_MAX_ERROR 3.0
+// the same for the extruders with pressure advance, the advance is only worked out at the end of each segment too
+#define ADVANCE_MAX_ERROR 2.0
+// segments the advance is given to settle once it could have caught up, as the segmenter only changes it per segment
+#define ADVANCE_SETTLE_SEGMENTS 4
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+static inline uint64_t cycle_count() { return __rdtsc(); }
+#else
+// no cycle counter available so fall back to nanoseconds
+static inline uint64_t cycle_count()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+#endif
+
+MotionSim::MotionSim(uint32_t slice_us)
+{
+    this->slice_us= slice_us;
+    n_motors= 0;
+}
+
+void MotionSim::on_module_loaded()
+{
+    register_for_event(ON_IDLE);
+
+    n_motors= THEROBOT->get_number_registered_motors();
+    for (size_t i = 0; i < axis.size(); ++i) {
+        axis[i].last_step= i < n_motors ? THEROBOT->actuators[i]->get_current_step() : 0;
+        axis[i].steps= 0;
+        axis[i].last_step_time= -1;
+        axis[i].min_step_interval= DBL_MAX;
+        axis[i].window_start= -1;
+        axis[i].window_steps= 0;
+        axis[i].window_max= 0;
+    }
+    THEROBOT->get_axis_position(path_end);
+}
+
+void MotionSim::on_idle(void *)
+{
+    auto start= std::chrono::steady_clock::now();
+    double end= sim_hal_get_time_us() + slice_us;
+    while(sim_hal_get_time_us() < end) {
+        run_tick();
+    }
+    host_seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// one period of the step timer, TIMER0 fires and TIMER1 fires afterwards if it was started by step_tick
+// the match register is read back after step_tick as that is when the next interrupt is due
+void MotionSim::run_tick()
+{
+    StepTicker *st= THEKERNEL->step_ticker;
+    double now= sim_hal_get_time_us();
+    if(!realtime_commands.empty()) run_realtime_commands(now);
+
+    if(track_laser && now >= next_laser_sample) {
+        // what the laser did before it was driven from the step ticker, the trapezoid rate of the fastest motor every 1ms
+        const Block *b= st->get_current_block();
+        float ratio= 0;
+        if(b != nullptr && !st->is_segment_mode()) {
+            auto pm= std::max_element(b->steps.begin(), b->steps.begin() + n_motors) - b->steps.begin();
+            ratio= b->get_trapezoid_rate(pm) / b->nominal_rate;
+        }
+        laser_sampled.update(now, b, ratio);
+        next_laser_sample= now + 1000;
+    }
+
+    // anything pended from the main loop runs before the tick, and what the tick pended runs once it has returned
+    sim_hal_run_pendsv();
+    uint64_t c= cycle_count();
+    st->step_tick();
+    c= cycle_count() - c;
+    sim_hal_run_pendsv();
+
+    ++ticks;
+    const Block *b= st->get_current_block();
+    bool running= b != nullptr;
+    if(running && b != last_block) {
+        ++blocks;
+        if(track_shaper || track_advance) add_planned_block(b, now);
+    }
+    last_block= b;
+    if(running || was_running) {
+        ++active_ticks;
+        step_cycles += c;
+        if(c > step_cycles_max) step_cycles_max= c;
+    }
+
+    uint32_t depth= THECONVEYOR->get_queue_depth();
+    queue_depth_sum += depth;
+    if(depth > queue_depth_max) queue_depth_max= depth;
+    // blocks are waiting but the step ticker is not being fed
+    if(!running && depth > 0) ++starved_ticks;
+    was_running= running;
+
+    if(LPC_TIM1->TCR == 1) {
+        c= cycle_count();
+        st->unstep_tick();
+        c= cycle_count() - c;
+        LPC_TIM1->TCR= 0;
+        ++unstep_calls;
+        unstep_cycles += c;
+        if(c > unstep_cycles_max) unstep_cycles_max= c;
+    }
+
+    bool moved= false;
+    for (uint8_t m = 0; m < n_motors; ++m) {
+        int32_t pos= THEROBOT->actuators[m]->get_current_step();
+        if(pos == axis[m].last_step) continue;
+        if(m <= Z_AXIS) moved= true;
+
+        // there can only be one step per tick
+        axis[m].steps += std::abs(pos - axis[m].last_step);
+        axis[m].last_step= pos;
+        if(axis[m].last_step_time >= 0) {
+            double dt= now - axis[m].last_step_time;
+            if(dt < axis[m].min_step_interval) axis[m].min_step_interval= dt;
+        }
+        axis[m].last_step_time= now;
+        if(track_advance) {
+            if(axis[m].window_start < 0 || now - axis[m].window_start >= segment_ticks * 1e6 / THEKERNEL->step_ticker->get_frequency()) {
+                axis[m].window_start= now;
+                axis[m].window_steps= 0;
+            }
+            if(++axis[m].window_steps > axis[m].window_max) axis[m].window_max= axis[m].window_steps;
+        }
+        if(holding) holds.back().stopped= now;
+        if(step_log != nullptr) fprintf(step_log, "%1.2f,%d,%d\n", now, m, pos);
+    }
+    if(moved && track_path) check_path();
+    if(!planned_blocks.empty()) {
+        // the oldest block is not needed once the next one started further back than the shapers look
+        while(planned_blocks.size() > 1 && planned_blocks[1].start < now - history_us) planned_blocks.pop_front();
+        if(track_shaper) check_shaper(now);
+        if(track_advance) check_advance(now);
+    }
+
+    // the timer runs at SystemCoreClock/4
+    sim_hal_set_time_us(now + LPC_TIM0->MR0 * 4e6 / SystemCoreClock);
+}
+
+void MotionSim::set_track_laser(bool flag)
+{
+    track_laser= flag;
+    if(flag) {
+        THEKERNEL->step_ticker->speed_fnc= [this](const Block *b, float ratio, uint16_t pixel) {
+            laser_isr.update(sim_hal_get_time_us(), b, ratio);
+            raster.update(b, pixel);
+        };
+    }
+}
+
+void MotionSim::laser_track_t::update(double now, const Block *b, float r)
+{
+    distance += ratio * nominal_speed * (now - time) / 1e6;
+    time= now;
+    if(b != block) {
+        if(mm > 0) {
+            double e= fabs(distance - mm) / mm;
+            if(e > error_max) error_max= e;
+            error_sum += e;
+            ++blocks;
+        }
+        block= b;
+        mm= (b != nullptr && b->is_g123) ? b->millimeters : 0;
+        nominal_speed= (b != nullptr) ? b->nominal_speed : 0;
+        distance= 0;
+    }
+    ratio= r;
+}
+
+void MotionSim::laser_track_t::report(const char *name) const
+{
+    if(blocks == 0) return;
+    THEKERNEL->streams->printf("laser energy per mm (%s): max error %1.2f%%, mean %1.2f%% over %lu blocks\n", name, error_max * 100, error_sum / blocks * 100, (unsigned long)blocks);
+}
+
+void MotionSim::raster_track_t::update(const Block *b, uint16_t p)
+{
+    if(b != block) {
+        // the last one must have got to its last pixel
+        if(block != nullptr && pixel != last_pixel) ++errors;
+        block= (b != nullptr && b->raster != nullptr) ? b : nullptr;
+        if(block == nullptr) return;
+        ++lines;
+        ++pixels;
+        if(p != 0) ++errors;
+        pixel= p;
+        last_pixel= b->raster->power.size() - 1;
+
+    } else if(block != nullptr && p != pixel) {
+        if(p != pixel + 1) ++errors;
+        pixel= p;
+        ++pixels;
+    }
+}
+
+void MotionSim::raster_track_t::report() const
+{
+    if(lines == 0) return;
+    THEKERNEL->streams->printf("raster: %lu scan lines, %llu pixels, %lu out of order\n", (unsigned long)lines, (unsigned long long)pixels, (unsigned long)errors);
+}
+
+// the same calls the consoles make for the real time characters, the conveyor ramps the time scale on idle
+void MotionSim::run_realtime_commands(double now)
+{
+    while(!realtime_commands.empty() && realtime_commands.front().time_us <= now) {
+        const realtime_command_t& r= realtime_commands.front();
+        if(r.cmd == '!') {
+            if(!holding) holds.push_back({now, now, -1});
+            holding= true;
+            THEKERNEL->set_feed_hold(true);
+        } else if(r.cmd == '~') {
+            if(holding) holds.back().resumed= now;
+            holding= false;
+            THEKERNEL->set_feed_hold(false);
+        } else {
+            THECONVEYOR->set_feed_override(r.percent / 100.0F);
+        }
+        realtime_commands.pop_front();
+    }
+}
+
+void MotionSim::add_realtime_command(double time_us, char cmd, float percent)
+{
+    auto i= realtime_commands.begin();
+    while(i != realtime_commands.end() && i->time_us <= time_us) ++i;
+    realtime_commands.insert(i, {time_us, cmd, percent});
+}
+
+void MotionSim::add_planned_block(const Block *b, double now)
+{
+    if(planned_blocks.empty() && history_us == 0) {
+        segment_ticks= floorf(THEKERNEL->step_ticker->get_frequency() * THECONVEYOR->get_step_segment_ms() / 1000.0F);
+        if(segment_ticks < 1) segment_ticks= 1;
+        for (int i = 0; i < 3; ++i) {
+            history_us= std::max(history_us, THECONVEYOR->get_shaper(i).get_duration() * 1e6);
+        }
+        // and the block before for the advance it ended with
+        history_us += 2 * segment_ticks * 1e6 / THEKERNEL->step_ticker->get_frequency();
+    }
+
+    planned_block_t s;
+    s.start= now;
+    s.block= *b;
+    s.block.raster= nullptr;
+    if(!planned_blocks.empty()) {
+        const planned_block_t &prev= planned_blocks.back();
+        double end= prev.start + prev.block.total_move_ticks * 1e6 / THEKERNEL->step_ticker->get_frequency();
+        for (uint8_t m = 0; m < n_motors; ++m) {
+            int32_t n= prev.block.steps[m];
+            s.base[m]= prev.base[m] + (prev.block.direction_bits[m] ? -n : n);
+        }
+        // after a stop the shaped motion has caught up and the advance is back to 0,
+        // so where the motors are is where the next block starts from
+        if(now - end > history_us) planned_blocks.clear();
+    }
+    if(planned_blocks.empty()) {
+        for (uint8_t m = 0; m < n_motors; ++m) s.base[m]= THEROBOT->actuators[m]->get_current_step();
+    }
+    planned_blocks.push_back(s);
+}
+
+// steps motor m of block b has made by tick t as the segmenter cuts it, at the end of each segment,
+// with an extruder's pressure advance of k seconds times its planned rate added when it extrudes along an XYZ move
+static double segment_steps(const Block& b, uint8_t m, double t, float k)
+{
+    double n= (t >= b.total_move_ticks) ? b.steps[m] : floorf(b.get_steps_at(t) / b.steps_event_count * b.steps[m] + 0.5F);
+    if(k > 0 && (b.steps[X_AXIS] | b.steps[Y_AXIS] | b.steps[Z_AXIS]) != 0 && !b.direction_bits[m]) {
+        // the rate at the end of the block is its exit speed
+        double f= THEKERNEL->step_ticker->get_frequency();
+        double rate;
+        if(t >= b.total_move_ticks) rate= b.exit_speed / b.millimeters * b.steps_event_count / f;
+        else rate= (b.get_steps_at(t + 0.5) - b.get_steps_at(std::max(t - 0.5, 0.0))) / (t + 0.5 - std::max(t - 0.5, 0.0));
+        n += round(k * f * rate * b.steps[m] / b.steps_event_count);
+    }
+    return n;
+}
+
+// planned position of motor m at tick of block b that starts from base, with the advance of k seconds
+double MotionSim::planned_position(const planned_block_t& b, uint8_t m, double tick, float k)
+{
+    double n= segment_steps(b.block, m, tick, k);
+    return b.base[m] + (b.block.direction_bits[m] ? -n : n);
+}
+
+// planned position of motor m at time t, the trapezoid or S-curve of the block it was in sampled at the segment ends
+// and straight in between, which is the motion the shapers are given. With advance an extruder's pressure advance is
+// added. False for the XYZ motors on arcs as they do not go in a straight line
+bool MotionSim::planned_at(uint8_t m, double t, double& u, bool advance) const
+{
+    float k= advance ? THEROBOT->actuators[m]->get_pressure_advance() : 0;
+    for (auto i= planned_blocks.rbegin(); i != planned_blocks.rend(); ++i) {
+        if(i->start > t) continue;
+        const Block &b= i->block;
+        double tick= (t - i->start) * THEKERNEL->step_ticker->get_frequency() / 1e6;
+        if(tick >= b.total_move_ticks && k == 0) {
+            u= planned_position(*i, m, b.total_move_ticks, k);
+        } else if(b.is_arc && m <= Z_AXIS) {
+            return false;
+        } else {
+            // the last segment takes in what would be less than half a segment after it
+            tick= std::min(tick, (double)b.total_move_ticks);
+            double t0= floor(tick / segment_ticks) * segment_ticks;
+            if(t0 > 0 && t0 + segment_ticks / 2 >= b.total_move_ticks) t0 -= segment_ticks;
+            double t1= t0 + segment_ticks;
+            if(t1 + segment_ticks / 2 >= b.total_move_ticks) t1= b.total_move_ticks;
+            // the first segment starts from the advance the block before ended with
+            auto prev= i + 1;
+            double u0= (t0 == 0 && k > 0 && prev != planned_blocks.rend()) ? planned_position(*prev, m, prev->block.total_move_ticks, k)
+                                                                          : planned_position(*i, m, t0, k);
+            u= u0 + (planned_position(*i, m, t1, k) - u0) * (tick - t0) / (t1 - t0);
+        }
+        return true;
+    }
+    // before the first block it was at rest
+    u= planned_blocks.front().base[m];
+    return true;
+}
+
+// the shaped position is the sum of each impulse times the unshaped position that long ago
+void MotionSim::check_shaper(double now)
+{
+    for (uint8_t m = 0; m < 3 && m < n_motors; ++m) {
+        const InputShaper &sh= THECONVEYOR->get_shaper(m);
+        if(!sh.is_enabled()) continue;
+        double y= 0;
+        bool ok= true;
+        for (int i = 0; i < sh.n && ok; ++i) {
+            double u;
+            ok= planned_at(m, now - sh.time[i] * 1e6, u, false);
+            y += sh.amplitude[i] * u;
+        }
+        if(!ok) {
+            ++shaper.skipped;
+            continue;
+        }
+        shaper.update(m, now, (int32_t)THEROBOT->actuators[m]->get_current_step() - y);
+    }
+}
+
+// an extruder with pressure advance must be on its planned position plus the advance, once the advance could have got
+// there. Where the extruder's acceleration or max rate held it back it is only checked once it has caught up
+void MotionSim::check_advance(double now)
+{
+    for (uint8_t m = 0; m < n_motors; ++m) {
+        StepperMotor *a= THEROBOT->actuators[m];
+        if(!a->is_extruder() || a->get_pressure_advance() <= 0) continue;
+        double y, u;
+        planned_at(m, now, y, true);
+        planned_at(m, now, u, false);
+
+        advance_follower_t &f= follower[m];
+        if(!f.started) f= {true, y, 0, u, now, now};
+        double dt= now - f.time;
+        if(dt > 0) {
+            // in steps and us
+            double spm= a->get_steps_per_mm();
+            double acc= a->get_acceleration() * spm / 1e12;
+            double max_rate= a->get_max_rate() * spm / 1e6;
+            double planned_rate= (u - f.planned) / dt;
+            double r= y - (f.position + u - f.planned);
+            double want= r / dt;
+            if(acc > 0) {
+                double stop= sqrt(2 * acc * fabs(r));
+                want= std::max(-stop, std::min(want, stop));
+                want= std::max(f.rate - acc * dt, std::min(want, f.rate + acc * dt));
+            }
+            if(max_rate > 0) want= std::max(-max_rate - planned_rate, std::min(want, max_rate - planned_rate));
+            double d= (r < 0) ? std::max(r, std::min(want * dt, 0.0)) : std::min(r, std::max(want * dt, 0.0));
+            f.position += u - f.planned + d;
+            f.rate= d / dt;
+            f.planned= u;
+            f.time= now;
+        }
+        if(fabs(y - f.position) > 0.5) f.caught_up= -1;
+        else if(f.caught_up < 0) f.caught_up= now;
+
+        if(f.caught_up >= 0 && now - f.caught_up >= ADVANCE_SETTLE_SEGMENTS * segment_ticks * 1e6 / THEKERNEL->step_ticker->get_frequency()) {
+            advance.update(m, now, (int32_t)a->get_current_step() - y);
+        } else {
+            ++advance.held_back;
+        }
+    }
+}
+
+void MotionSim::error_track_t::update(uint8_t m, double now, double e)
+{
+    e= fabs(e);
+    if(e > error_max) {
+        error_max= e;
+        time= now;
+        motor= m;
+    }
+    ++samples;
+}
+
+void MotionSim::error_track_t::report(const char *name) const
+{
+    THEKERNEL->streams->printf("%s: max error %1.2f steps on motor %d at %1.1f ms, %llu samples", name, error_max, motor, time / 1000,
+        (unsigned long long)samples);
+    if(skipped > 0) THEKERNEL->streams->printf(", %llu on arcs not checked", (unsigned long long)skipped);
+    if(held_back > 0) THEKERNEL->streams->printf(", %llu held back by the extruder's limits", (unsigned long long)held_back);
+    THEKERNEL->streams->printf("\n");
+}
+
+static inline double sq(double x) { return x * x; }
+
+// squared distance of p from the line, t is where p projects onto it, 0 at the start and 1 at the end
+static double distance_to_line(const float p[], const MotionSim::path_line_t& l, double& t)
+{
+    double d[3], v[3], dd= 0, vd= 0;
+    for (int j = 0; j < 3; ++j) {
+        d[j]= l.end[j] - l.start[j];
+        v[j]= p[j] - l.start[j];
+        dd += d[j] * d[j];
+        vd += v[j] * d[j];
+    }
+    t= dd > 0 ? vd / dd : 1;
+    double c= std::min(1.0, std::max(0.0, t));
+    double e= 0;
+    for (int j = 0; j < 3; ++j) {
+        e += (v[j] - c * d[j]) * (v[j] - c * d[j]);
+    }
+    return e;
+}
+
+// distance of the effector from the move being stepped, the effector position is found from the actuator
+// steps with the arm solution so this is the real error of the segmented path
+void MotionSim::check_path()
+{
+    ActuatorCoordinates ac;
+    for (size_t i = X_AXIS; i <= Z_AXIS; i++) {
+        ac[i]= THEROBOT->actuators[i]->get_current_position();
+    }
+    float p[3];
+    THEROBOT->arm_solution->actuator_to_cartesian(ac, p);
+
+    // a long move may still be being queued, the segments queued so far are on it so they are checked as the last move
+    path_line_t queuing;
+    memcpy(queuing.start, path_end, sizeof(path_end));
+    for (size_t i = X_AXIS; i <= Z_AXIS; i++) {
+        ac[i]= THEROBOT->actuators[i]->get_last_milestone();
+    }
+    THEROBOT->arm_solution->actuator_to_cartesian(ac, queuing.end);
+
+    // the effector passes through the end of every move, so only move on to the next one once the end of this one
+    // was reached, a later move that crosses this one must not be picked
+    double t;
+    double best= distance_to_line(p, path.empty() ? queuing : path[0], t);
+    while(!path.empty()) {
+        const float *end= path[0].end;
+        if(t >= 1 || (sq(p[0] - end[0]) + sq(p[1] - end[1]) + sq(p[2] - end[2])) < sq(0.05)) path_end_reached= true;
+        if(!path_end_reached) break;
+
+        double tn;
+        double e= distance_to_line(p, path.size() > 1 ? path[1] : queuing, tn);
+        if(e > best) break;
+        path.pop_front();
+        path_end_reached= false;
+        best= e;
+        t= tn;
+    }
+
+    best= sqrt(best);
+    path_error_sum += best;
+    ++path_samples;
+    if(best > path_error_max) path_error_max= best;
+}
+
+// called after each gcode line, counts the trapezoids the planner calculated for it
+void MotionSim::line_done()
+{
+    if(track_path) {
+        path_line_t l;
+        memcpy(l.start, path_end, sizeof(path_end));
+        THEROBOT->get_axis_position(l.end);
+        if(memcmp(l.start, l.end, sizeof(l.end)) != 0) {
+            path.push_back(l);
+            memcpy(path_end, l.end, sizeof(path_end));
+        }
+    }
+
+    uint32_t n= THEKERNEL->planner->get_trapezoid_count() - last_trapezoid_count;
+    last_trapezoid_count += n;
+    if(n == 0) return;
+    trapezoid_lines++;
+    if(n > trapezoid_line_max) trapezoid_line_max= n;
+}
+
+void MotionSim::report() const
+{
+    StreamOutputPool *s= THEKERNEL->streams;
+    double sim_seconds= sim_hal_get_time_us() / 1e6;
+    s->printf("simulated time: %1.3f s, %llu step ticks (%llu active)\n", sim_seconds, (unsigned long long)ticks, (unsigned long long)active_ticks);
+    if(host_seconds > 0) {
+        s->printf("host rate: %1.0f step ticks/s (%1.1fx real time)\n", ticks / host_seconds, sim_seconds / host_seconds);
+    }
+    if(active_ticks > 0) {
+        s->printf("step_tick cycles: mean %1.1f, max %llu\n", (double)step_cycles / active_ticks, (unsigned long long)step_cycles_max);
+    }
+    if(unstep_calls > 0) {
+        s->printf("unstep_tick cycles: mean %1.1f, max %llu\n", (double)unstep_cycles / unstep_calls, (unsigned long long)unstep_cycles_max);
+    }
+    if(ticks > 0) {
+        s->printf("queue depth: mean %1.2f, max %lu of %lu, starved step ticks %llu\n", (double)queue_depth_sum / ticks, (unsigned long)queue_depth_max,
+            (unsigned long)THECONVEYOR->get_queue_size(), (unsigned long long)starved_ticks);
+    }
+    THECONVEYOR->dump_stats(s);
+    s->printf("blocks: %lu\n", (unsigned long)blocks);
+    if(path_samples > 0) {
+        s->printf("path error: max %1.4f mm, mean %1.4f mm\n", path_error_max, path_error_sum / path_samples);
+    }
+    if(track_laser) {
+        laser_isr.report("step ticker");
+        laser_sampled.report("1ms sampling");
+        raster.report();
+    }
+    if(track_shaper) shaper.report("input shaping");
+    if(track_advance) {
+        advance.report("pressure advance");
+        for (uint8_t m = 0; m < n_motors; ++m) {
+            if(THEROBOT->actuators[m]->is_extruder()) s->printf("pressure advance: most steps in a segment on motor %d %lu\n", m, (unsigned long)axis[m].window_max);
+        }
+    }
+    for(auto& h : holds) {
+        s->printf("feed hold at %1.1f ms: stopped after %1.1f ms", h.requested / 1000, (h.stopped - h.requested) / 1000);
+        if(h.resumed >= 0) s->printf(", resumed at %1.1f ms\n", h.resumed / 1000);
+        else s->printf("\n");
+    }
+    if(trapezoid_lines > 0) {
+        uint32_t n= THEKERNEL->planner->get_trapezoid_count();
+        s->printf("trapezoids: %lu, mean %1.1f per move line, max %lu\n", (unsigned long)n, (double)n / trapezoid_lines, (unsigned long)trapezoid_line_max);
+    }
+    for (uint8_t m = 0; m < n_motors; ++m) {
+        double max_rate= axis[m].min_step_interval < DBL_MAX ? 1e6 / axis[m].min_step_interval : 0;
+        s->printf("motor %d: %llu steps, position %ld, max rate %1.0f steps/s\n", m, (unsigned long long)axis[m].steps, (long)axis[m].last_step, max_rate);
+    }
+}
+
+// the step ticker must have issued exactly the steps the planner asked for
+bool MotionSim::check() const
+{
+    bool ok= true;
+    for (uint8_t m = 0; m < n_motors; ++m) {
+        StepperMotor *a= THEROBOT->actuators[m];
+        if((int32_t)a->get_current_step() != a->get_last_milestone_steps()) {
+            THEKERNEL->streams->printf("FAIL motor %d: at step %ld expected %ld\n", m, (long)(int32_t)a->get_current_step(), (long)a->get_last_milestone_steps());
+            ok= false;
+        }
+        if(a->is_moving()) {
+            THEKERNEL->streams->printf("FAIL motor %d: still moving\n", m);
+            ok= false;
+        }
+    }
+    if(track_shaper && (shaper.samples == 0 || shaper.error_max > SHAPER_MAX_ERROR)) {
+        THEKERNEL->streams->printf("FAIL input shaping: %1.2f steps from the analytic shaped motion\n", shaper.error_max);
+        ok= false;
+    }
+    if(track_advance && (advance.samples == 0 || advance.error_max > ADVANCE_MAX_ERROR)) {
+        THEKERNEL->streams->printf("FAIL pressure advance: %1.2f steps from the planned extrusion plus the advance\n", advance.error_max);
+        ok= false;
+    }
+    for (uint8_t m = 0; track_advance && m < n_motors; ++m) {
+        // the steps of a segment are spread over its events, so one either side of it
+        StepperMotor *a= THEROBOT->actuators[m];
+        if(!a->is_extruder()) continue;
+        double limit= a->get_max_rate() * a->get_steps_per_mm() * segment_ticks / THEKERNEL->step_ticker->get_frequency() + 2;
+        if(axis[m].window_max > limit) {
+            THEKERNEL->streams->printf("FAIL pressure advance: motor %d made %lu steps in a segment, its max rate allows %1.0f\n", m,
+                (unsigned long)axis[m].window_max, limit);
+            ok= false;
+        }
+    }
+    if(THEKERNEL->step_ticker->get_segment_underruns() > 0) {
+        THEKERNEL->streams->printf("FAIL segments: ran out %lu times part way through a block\n", (unsigned long)THEKERNEL->step_ticker->get_segment_underruns());
+        ok= false;
+    }
+    if(raster.errors > 0) {
+        THEKERNEL->streams->printf("FAIL raster: %lu pixels out of order\n", (unsigned long)raster.errors);
+        ok= false;
+    }
+    return ok;
+}
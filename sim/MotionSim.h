@@ -0,0 +1,184 @@
+/*
+      This file is part of Smoothie (http://smoothieware.org/). The motion control part is heavily based on Grbl (https://github.com/simen/grbl).
+      Smoothie is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+      Smoothie is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+      You should have received a copy of the GNU General Public License along with Smoothie. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "libs/Module.h"
+#include "ActuatorCoordinates.h"
+#include "modules/robot/Block.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <array>
+#include <deque>
+
+// Drives the StepTicker ISRs from the idle loop, each call to on_idle advances simulated time by one slice.
+// The time between step_tick calls is taken from the TIMER0 match register, so event scheduling is simulated too.
+// Collects the stats used to benchmark the planner and the step generation
+class MotionSim : public Module {
+    public:
+        MotionSim(uint32_t slice_us);
+        void on_module_loaded();
+        void on_idle(void *);
+
+        void set_step_log(FILE *fp) { step_log= fp; }
+        void set_track_path(bool flag) { track_path= flag; }
+        void set_track_laser(bool flag);
+        void set_track_shaper(bool flag) { track_shaper= flag; }
+        void set_track_advance(bool flag) { track_advance= flag; }
+        void line_done();
+        // a real time command at a simulated time, '!' feed hold, '~' resume, or a feed override in percent
+        void add_realtime_command(double time_us, char cmd, float percent);
+        void report() const;
+        bool check() const;
+
+        // an XYZ move as it was requested
+        struct path_line_t {
+            float start[3];
+            float end[3];
+        };
+
+    private:
+        void run_tick();
+        void check_path();
+
+        // integrates the speed a laser would follow over each G1-G3 block, the distance it gives should be the length
+        // of the block, otherwise the energy per mm is off
+        struct laser_track_t {
+            const void *block;
+            double mm;
+            double nominal_speed;
+            double distance;
+            double ratio;
+            double time;
+            double error_max;
+            double error_sum;
+            uint32_t blocks;
+            void update(double now, const Block *b, float r);
+            void report(const char *name) const;
+        };
+
+        // the pixels of each raster block must be reported in order, from the first to the last
+        struct raster_track_t {
+            const void *block;
+            uint16_t pixel;
+            uint16_t last_pixel;
+            uint32_t lines;
+            uint64_t pixels;
+            uint32_t errors;
+            void update(const Block *b, uint16_t p);
+            void report() const;
+        };
+        void run_realtime_commands(double now);
+
+        // input shaping and pressure advance, the blocks are kept from when the step ticker started them so the shaped
+        // and advanced motion can be worked out from the planned one and compared with the steps the motors actually made
+        struct planned_block_t {
+            double start;
+            Block block;
+            std::array<int32_t, k_max_actuators> base;  // planned position of each motor at the start
+        };
+        struct error_track_t {
+            double error_max;
+            double time;
+            uint8_t motor;
+            uint64_t samples;
+            uint64_t skipped;
+            uint64_t held_back;
+            void update(uint8_t m, double now, double e);
+            void report(const char *name) const;
+        };
+        void add_planned_block(const Block *b, double now);
+        static double planned_position(const planned_block_t& b, uint8_t m, double tick, float k);
+        bool planned_at(uint8_t m, double t, double& u, bool advance) const;
+        void check_advance(double now);
+        // where an extruder's advance could have got to by now, following the planned one no faster than the
+        // extruder's acceleration and max rate allow
+        struct advance_follower_t {
+            bool started;
+            double position;
+            double rate;
+            double planned;
+            double time;
+            double caught_up;
+        };
+        void check_shaper(double now);
+
+        struct realtime_command_t {
+            double time_us;
+            char cmd;
+            float percent;
+        };
+
+        // feed holds as they happened, the time they stopped is the last step after the request
+        struct hold_t {
+            double requested;
+            double stopped;
+            double resumed;
+        };
+
+        struct axis_stats_t {
+            int32_t last_step;
+            uint64_t steps;
+            double last_step_time;
+            double min_step_interval;
+            // most steps in a segment's time, only counted with the advance tracked
+            double window_start;
+            uint32_t window_steps;
+            uint32_t window_max;
+        };
+
+        std::array<axis_stats_t, k_max_actuators> axis;
+
+        // the moves in the order they were queued, the front one is the one being stepped
+        std::deque<path_line_t> path;
+        std::deque<realtime_command_t> realtime_commands;
+        std::deque<hold_t> holds;
+        laser_track_t laser_isr{};
+        laser_track_t laser_sampled{};
+        raster_track_t raster{};
+        std::deque<planned_block_t> planned_blocks;
+        double history_us{0};       // how far back the blocks are needed, the longest shaper and two segments
+        double segment_ticks{1};
+        error_track_t shaper{};
+        error_track_t advance{};
+        std::array<advance_follower_t, k_max_actuators> follower{};
+        double next_laser_sample{0};
+        float path_end[3];
+        FILE *step_log{nullptr};
+
+        uint32_t slice_us;
+
+        uint64_t ticks{0};
+        uint64_t active_ticks{0};
+        uint64_t starved_ticks{0};
+        uint64_t step_cycles{0};
+        uint64_t step_cycles_max{0};
+        uint64_t unstep_calls{0};
+        uint64_t unstep_cycles{0};
+        uint64_t unstep_cycles_max{0};
+        uint64_t queue_depth_sum{0};
+        uint32_t queue_depth_max{0};
+        double host_seconds{0};
+        uint32_t last_trapezoid_count{0};
+        uint32_t trapezoid_lines{0};
+        uint32_t trapezoid_line_max{0};
+        uint32_t blocks{0};
+        const void *last_block{nullptr};
+        double path_error_max{0};
+        double path_error_sum{0};
+        uint64_t path_samples{0};
+
+        uint8_t n_motors;
+        bool was_running{false};
+        bool track_path{false};
+        bool track_laser{false};
+        bool track_shaper{false};
+        bool track_advance{false};
+        bool path_end_reached{false};
+        bool holding{false};
+};
@@ -0,0 +1,210 @@
+/*
+      This file is part of Smoothie (http://smoothieware.org/). The motion control part is heavily based on Grbl (https://github.com/simen/grbl).
+      Smoothie is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+      Smoothie is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+      You should have received a copy of the GNU General Public License along with Smoothie. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+This is part of the host simulator, it replaces Kernel.cpp and only brings up the motion pipeline
+(Conveyor, Robot, Planner and StepTicker) and the laser's raster scan lines, everything else is left out.
+*/
+
+#include "SimKernel.h"
+
+#include "libs/Kernel.h"
+#include "libs/Module.h"
+#include "libs/Config.h"
+#include "libs/nuts_bolts.h"
+#include "libs/StreamOutputPool.h"
+#include "libs/StepTicker.h"
+#include "libs/PublicData.h"
+#include "libs/Profiler.h"
+#include "libs/ConfigSources/FirmConfigSource.h"
+#include "modules/robot/Planner.h"
+#include "modules/robot/Robot.h"
+#include "modules/robot/Conveyor.h"
+#include "modules/tools/laser/LaserRaster.h"
+#include "modules/tools/extruder/ExtruderMaker.h"
+#include "checksumm.h"
+#include "ConfigValue.h"
+#include "utils.h"
+
+#include <string>
+#include <fstream>
+#include <sstream>
+
+#define base_stepping_frequency_checksum            CHECKSUM("base_stepping_frequency")
+#define microseconds_per_step_pulse_checksum        CHECKSUM("microseconds_per_step_pulse")
+#define step_event_scheduling_checksum              CHECKSUM("step_event_scheduling")
+
+Kernel* Kernel::instance;
+
+Kernel::Kernel(){
+    halted= false;
+    feed_hold= false;
+    use_leds= false;
+    grbl_mode= false;
+    ok_per_line= true;
+
+    instance= this; // setup the Singleton instance of the kernel
+
+    this->serial= nullptr;
+    this->gcode_dispatch= nullptr;
+    this->robot= nullptr;
+    this->planner= nullptr;
+    this->config= nullptr;
+    this->conveyor= nullptr;
+    this->configurator= nullptr;
+    this->simpleshell= nullptr;
+    this->slow_ticker= nullptr;
+    this->adc= nullptr;
+
+    this->streams = new StreamOutputPool();
+    this->current_path   = "/";
+
+    this->step_ticker = new StepTicker();
+}
+
+// there is nothing to report homing from so this is a cut down version
+std::string Kernel::get_query_string()
+{
+    std::string str;
+    str.append("<");
+    if(halted) {
+        str.append("Alarm,");
+    }else if(this->conveyor->is_idle()) {
+        str.append("Idle,");
+    }else{
+        str.append("Run,");
+    }
+
+    char buf[128];
+    Robot::wcs_t mpos= robot->get_axis_position();
+    size_t n= snprintf(buf, sizeof(buf), "%1.4f,%1.4f,%1.4f", std::get<X_AXIS>(mpos), std::get<Y_AXIS>(mpos), std::get<Z_AXIS>(mpos));
+    str.append("MPos:").append(buf, n);
+    str.append(">\r\n");
+    return str;
+}
+
+// Add a module to Kernel. We don't actually hold a list of modules we just call its on_module_loaded
+void Kernel::add_module(Module* module){
+    module->on_module_loaded();
+}
+
+// Adds a hook for a given module and event
+void Kernel::register_for_event(_EVENT_ENUM id_event, Module *mod){
+    this->hooks[id_event].push_back(mod);
+}
+
+// Call a specific event with an argument
+void Kernel::call_event(_EVENT_ENUM id_event, void * argument){
+    bool was_idle= true;
+    if(id_event == ON_HALT) {
+        this->halted= (argument == nullptr);
+        was_idle= conveyor->is_idle();
+    }
+
+    // send to all registered modules
+    if(Profiler::is_enabled()) {
+        Profiler::call_event(id_event, hooks[id_event], argument);
+    } else {
+        for (auto m : hooks[id_event]) {
+            (m->*kernel_callback_functions[id_event])(argument);
+        }
+    }
+
+    if(id_event == ON_HALT && this->halted && !was_idle) {
+        this->robot->reset_position_from_current_actuator_position();
+    }
+}
+
+bool Kernel::kernel_has_event(_EVENT_ENUM id_event, Module *mod)
+{
+    for (auto m : hooks[id_event]) {
+        if(m == mod) return true;
+    }
+    return false;
+}
+
+void Kernel::unregister_for_event(_EVENT_ENUM id_event, Module *mod)
+{
+    for (auto i = hooks[id_event].begin(); i != hooks[id_event].end(); ++i) {
+        if(*i == mod) {
+            hooks[id_event].erase(i);
+            return;
+        }
+    }
+}
+
+// the config file is read into memory with any overridden settings replaced, so runs can be compared without editing it
+static std::string config_text;
+
+bool sim_kernel_setup(const char *config_file, const std::vector<std::string>& overrides)
+{
+    std::ifstream in(config_file);
+    if(!in) {
+        THEKERNEL->streams->printf("config file not found: %s\n", config_file);
+        return false;
+    }
+
+    std::vector<std::string> keys;
+    for(auto& o : overrides) {
+        keys.push_back(o.substr(0, o.find_first_of(" =")));
+    }
+
+    std::string line;
+    while(std::getline(in, line)) {
+        std::istringstream ss(line);
+        std::string key;
+        ss >> key;
+        bool overridden= false;
+        for(auto& k : keys) {
+            if(k == key) overridden= true;
+        }
+        if(!overridden) config_text.append(line).append("\n");
+    }
+    for(auto& o : overrides) {
+        std::string l= o;
+        size_t eq= l.find('=');
+        if(eq != std::string::npos) l[eq]= ' ';
+        config_text.append(l).append("\n");
+    }
+
+    THEKERNEL->config= new Config(new FirmConfigSource("sim", config_text.data(), config_text.data() + config_text.size()));
+    THEKERNEL->config->config_cache_load();
+
+    // Configure the step ticker
+    THEKERNEL->base_stepping_frequency = THEKERNEL->config->value(base_stepping_frequency_checksum)->by_default(100000)->as_number();
+    float microseconds_per_step_pulse = THEKERNEL->config->value(microseconds_per_step_pulse_checksum)->by_default(1)->as_number();
+    THEKERNEL->step_ticker->set_frequency( THEKERNEL->base_stepping_frequency );
+    THEKERNEL->step_ticker->set_unstep_time( microseconds_per_step_pulse );
+    THEKERNEL->step_ticker->set_event_scheduling( THEKERNEL->config->value(step_event_scheduling_checksum)->by_default(false)->as_bool() );
+
+    // Core motion modules
+    THEKERNEL->add_module( THEKERNEL->conveyor = new Conveyor() );
+    THEKERNEL->add_module( THEKERNEL->robot    = new Robot()    );
+    THEKERNEL->planner = new Planner();
+
+    // M660 raster scan lines, they need no laser to be queued and stepped
+    THEKERNEL->add_module( new LaserRaster() );
+
+    // Extruders, so the E steps and their pressure advance are stepped too
+    ExtruderMaker *em = new ExtruderMaker();
+    em->load_tools();
+    delete em;
+
+    THEKERNEL->config->config_cache_clear();
+
+    // start the timers and interrupts
+    THEKERNEL->conveyor->start(THEROBOT->get_number_registered_motors());
+    THEKERNEL->step_ticker->start();
+
+    return true;
+}
+
+void sim_kernel_teardown()
+{
+    delete THEKERNEL->config;
+    THEKERNEL->config= nullptr;
+}
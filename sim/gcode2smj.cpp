@@ -0,0 +1,136 @@
+/*
+      This file is part of Smoothie (http://smoothieware.org/). The motion control part is heavily based on Grbl (https://github.com/simen/grbl).
+      Smoothie is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+      Smoothie is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+      You should have received a copy of the GNU General Public License along with Smoothie. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+Compiles a Gcode file into a CompiledJob the Player can play without parsing it.
+
+Each line is parsed with the firmware's own Gcode class. A line that is a single G0-G3 with only the words a move
+takes becomes a move record, with XYZ, IJK and F in millimeters. Every other line is kept as text without its
+comments, and so are moves with Z between a G10 and G11 firmware retract, the extruder has to see those to cancel its
+z lift. The job is taken to start in G21, G20 and G21 in it are followed.
+
+usage: gcode2smj in.gcode out.smj
+*/
+
+#include "CompiledJob.h"
+#include "MoveWords.h"
+#include "Gcode.h"
+#include "libs/StreamOutput.h"
+
+#include <ctype.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <fstream>
+
+static int modal_group_1= 0;
+static bool inch_mode= false;
+static bool retracted= false;
+
+// follows the modal state the firmware would have after a line, the same splitting GcodeDispatch does
+static void track_line(std::string line)
+{
+    while(line.size() > 0) {
+        size_t nextcmd = line.find_first_of("GM", 2);
+        std::string single_command = line.substr(0, nextcmd);
+        line = nextcmd == std::string::npos ? "" : line.substr(nextcmd);
+
+        Gcode gcode(single_command, &StreamOutput::NullStream);
+        if(gcode.has_g && gcode.g <= 3) modal_group_1= gcode.g;
+        if(gcode.has_g && gcode.g == 20) inch_mode= true;
+        if(gcode.has_g && gcode.g == 21) inch_mode= false;
+        if(gcode.has_g && (gcode.g == 10 || gcode.g == 11) && !gcode.has_letter('L')) retracted= gcode.g == 10;
+    }
+}
+
+// a G0-G3 on its own, with only the words in MoveWords
+static bool compilable(const std::string& line, const Gcode& gcode)
+{
+    if(!gcode.has_g || gcode.g > 3 || gcode.subcode != 0 || line.find_first_of("GM", 2) != std::string::npos) return false;
+
+    for (size_t i = 1; i < line.size(); ++i) {
+        char c= line[i];
+        if(!isalpha(c)) continue;
+        if(strchr(MoveWords::letters, c) == nullptr || (c == 'Z' && retracted)) return false;
+    }
+    return true;
+}
+
+int main(int argc, char *argv[])
+{
+    if(argc != 3) {
+        fprintf(stderr, "usage: gcode2smj in.gcode out.smj\n");
+        return 1;
+    }
+
+    std::ifstream in(argv[1]);
+    if(!in) {
+        fprintf(stderr, "cannot read %s\n", argv[1]);
+        return 1;
+    }
+    FILE *out= fopen(argv[2], "wb");
+    if(out == nullptr) {
+        fprintf(stderr, "cannot write %s\n", argv[2]);
+        return 1;
+    }
+    fwrite(CompiledJob::magic, 1, CompiledJob::header_size, out);
+
+    std::string line;
+    unsigned long n_lines= 0, n_moves= 0, n_text= 0, in_bytes= 0, out_bytes= CompiledJob::header_size;
+    while(std::getline(in, line)) {
+        ++n_lines;
+        in_bytes += line.size() + (in.eof() ? 0 : 1);
+
+        // the board skips a line this long whatever is in it, comments included
+        if(!line.empty() && line.back() == '\r') line.pop_back();
+        if(line.size() > LineReader::max_line) {
+            fprintf(stderr, "%s:%lu: line is too long to be played, it is left out\n", argv[1], n_lines);
+            continue;
+        }
+
+        size_t comment = line.find_first_of(";(");
+        if(comment != std::string::npos) line = line.substr(0, comment);
+        while(!line.empty() && isspace(line.back())) line.pop_back();
+        size_t start= line.find_first_not_of(" \t");
+        if(start == std::string::npos) continue;
+        line= line.substr(start);
+
+        char first_char = line[0];
+        if(first_char == 'X' || first_char == 'Y' || first_char == 'Z' || first_char == 'A' || first_char == 'F') {
+            // modal command, it is written with the G0-G3 it means so the board does not need to know it
+            line= "G" + std::to_string(modal_group_1) + " " + line;
+        }
+
+        uint8_t record[CompiledJob::max_record + LineReader::max_line + 2];
+        size_t size;
+        Gcode gcode(line, &StreamOutput::NullStream);
+        if(compilable(line, gcode)) {
+            size= CompiledJob::write_move(gcode.g, MoveWords(&gcode, inch_mode), record);
+            ++n_moves;
+
+        } else if(line.size() <= LineReader::max_line) {
+            size= CompiledJob::write_line(line.data(), line.size(), record);
+            ++n_text;
+
+        } else {
+            // only when the G0-G3 put in front of a modal line took it over
+            fprintf(stderr, "%s:%lu: line is too long to be played, it is left out\n", argv[1], n_lines);
+            continue;
+        }
+
+        track_line(line);
+        fwrite(record, 1, size, out);
+        out_bytes += size;
+    }
+
+    if(fclose(out) != 0) {
+        fprintf(stderr, "cannot write %s\n", argv[2]);
+        return 1;
+    }
+    printf("%s: %lu lines, %lu moves and %lu text lines, %lu bytes from %lu\n", argv[2], n_lines, n_moves, n_text, out_bytes, in_bytes);
+    return 0;
+}
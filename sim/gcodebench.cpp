@@ -0,0 +1,91 @@
+/*
+      This file is part of Smoothie (http://smoothieware.org/). The motion control part is heavily based on Grbl (https://github.com/simen/grbl).
+      Smoothie is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+      Smoothie is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+      You should have received a copy of the GNU General Public License along with Smoothie. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+Lines per second the Gcode parser gets through on job files.
+
+Each line is parsed and then asked for its arguments the way Robot and the extruder ask for them on a move, over and
+over for about a second a file. The lines are read in first, without their comments, so only the parser is timed.
+
+usage: gcodebench file.gcode ...
+*/
+
+#include "Gcode.h"
+#include "libs/StreamOutput.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <string>
+#include <vector>
+
+static double now()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static bool read_lines(const char *file, std::vector<std::string>& lines)
+{
+    FILE *fp= fopen(file, "r");
+    if(fp == nullptr) return false;
+    char buf[256];
+    while(fgets(buf, sizeof(buf), fp) != nullptr) {
+        buf[strcspn(buf, ";(\r\n")]= '\0';
+        if(buf[0] == 'G' || buf[0] == 'M' || buf[0] == 'T') lines.push_back(buf);
+    }
+    fclose(fp);
+    return true;
+}
+
+// what a move costs after the parse, Robot looks for each axis and the modal letters, the extruder for E
+static float use(const Gcode& gc)
+{
+    static const char letters[]= "XYZEFIJKRSP";
+    float sum= gc.get_num_args();
+    for (const char *l = letters; *l; ++l) {
+        if(gc.has_letter(*l)) sum += gc.get_value(*l);
+    }
+    return sum;
+}
+
+int main(int argc, char *argv[])
+{
+    if(argc < 2) {
+        fprintf(stderr, "usage: gcodebench file.gcode ...\n");
+        return 1;
+    }
+
+    volatile float sink= 0;
+    for (int f = 1; f < argc; ++f) {
+        std::vector<std::string> lines;
+        if(!read_lines(argv[f], lines)) {
+            fprintf(stderr, "cannot read %s\n", argv[f]);
+            return 1;
+        }
+        if(lines.empty()) continue;
+
+        size_t bytes= 0;
+        for (auto& l : lines) bytes += l.size();
+
+        uint64_t parsed= 0;
+        double start= now(), elapsed;
+        do {
+            for (auto& l : lines) {
+                Gcode gc(l, &StreamOutput::NullStream);
+                sink= sink + use(gc);
+            }
+            parsed += lines.size();
+            elapsed= now() - start;
+        } while(elapsed < 1.0);
+
+        printf("%-28s %6lu lines %8.0f lines/s %6.0f ns/line %6.1f MB/s\n", argv[f], (unsigned long)lines.size(), parsed / elapsed,
+            elapsed * 1e9 / parsed, parsed / lines.size() * bytes / elapsed * 1e-6);
+    }
+    return 0;
+}
@@ -0,0 +1,152 @@
+/*
+      This file is part of Smoothie (http://smoothieware.org/). The motion control part is heavily based on Grbl (https://github.com/simen/grbl).
+      Smoothie is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+      Smoothie is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+      You should have received a copy of the GNU General Public License along with Smoothie. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Host simulator replacement for the LPC17xx peripheral headers.
+// Only the registers touched by the motion code are modelled, they are plain memory
+// so the firmware can write them as usual and the simulator can read them back.
+
+#ifndef __LPC17xx_H__
+#define __LPC17xx_H__
+
+#include <stdint.h>
+
+typedef enum IRQn {
+    NonMaskableInt_IRQn           = -14,
+    MemoryManagement_IRQn         = -12,
+    BusFault_IRQn                 = -11,
+    UsageFault_IRQn               = -10,
+    SVCall_IRQn                   = -5,
+    DebugMonitor_IRQn             = -4,
+    PendSV_IRQn                   = -2,
+    SysTick_IRQn                  = -1,
+    WDT_IRQn                      = 0,
+    TIMER0_IRQn                   = 1,
+    TIMER1_IRQn                   = 2,
+    TIMER2_IRQn                   = 3,
+    TIMER3_IRQn                   = 4,
+    UART0_IRQn                    = 5,
+    UART1_IRQn                    = 6,
+    UART2_IRQn                    = 7,
+    UART3_IRQn                    = 8,
+    PWM1_IRQn                     = 9,
+    SPI_IRQn                      = 13,
+    SSP0_IRQn                     = 14,
+    SSP1_IRQn                     = 15,
+    EINT3_IRQn                    = 21,
+    ADC_IRQn                      = 22,
+    USB_IRQn                      = 24,
+    DMA_IRQn                      = 26,
+    ENET_IRQn                     = 28,
+    RIT_IRQn                      = 29,
+} IRQn_Type;
+
+typedef struct {
+    volatile uint32_t FIODIR;
+    uint32_t RESERVED0[3];
+    volatile uint32_t FIOMASK;
+    volatile uint32_t FIOPIN;
+    volatile uint32_t FIOSET;
+    volatile uint32_t FIOCLR;
+} LPC_GPIO_TypeDef;
+
+typedef struct {
+    volatile uint32_t IR;
+    volatile uint32_t TCR;
+    volatile uint32_t TC;
+    volatile uint32_t PR;
+    volatile uint32_t PC;
+    volatile uint32_t MCR;
+    volatile uint32_t MR0;
+    volatile uint32_t MR1;
+    volatile uint32_t MR2;
+    volatile uint32_t MR3;
+    volatile uint32_t CCR;
+    volatile uint32_t CR0;
+    volatile uint32_t CR1;
+    volatile uint32_t EMR;
+    volatile uint32_t CTCR;
+} LPC_TIM_TypeDef;
+
+typedef struct {
+    volatile uint32_t PCONP;
+    volatile uint32_t PCLKSEL0;
+    volatile uint32_t PCLKSEL1;
+} LPC_SC_TypeDef;
+
+typedef struct {
+    volatile uint32_t WDMOD;
+    volatile uint32_t WDTC;
+    volatile uint32_t WDFEED;
+    volatile uint32_t WDTV;
+    volatile uint32_t WDCLKSEL;
+} LPC_WDT_TypeDef;
+
+typedef struct {
+    volatile uint32_t CTRL;
+    volatile uint32_t CYCCNT;
+} DWT_Type;
+
+typedef struct {
+    volatile uint32_t DHCSR;
+    volatile uint32_t DCRSR;
+    volatile uint32_t DCRDR;
+    volatile uint32_t DEMCR;
+} CoreDebug_Type;
+
+// only the PendSV pending bit, the simulator runs PendSV_Handler() when it sees it set
+typedef struct {
+    volatile uint32_t ICSR;
+} SCB_Type;
+
+#define DWT_CTRL_CYCCNTENA_Msk      (1UL << 0)
+#define CoreDebug_DEMCR_TRCENA_Msk  (1UL << 24)
+#define SCB_ICSR_PENDSVSET_Msk      (1UL << 28)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern LPC_GPIO_TypeDef sim_gpio[5];
+extern LPC_TIM_TypeDef sim_timer[4];
+extern LPC_SC_TypeDef sim_sc;
+extern LPC_WDT_TypeDef sim_wdt;
+extern uint32_t SystemCoreClock;
+extern CoreDebug_Type sim_coredebug;
+extern SCB_Type sim_scb;
+// CYCCNT reads the host's cycle counter
+DWT_Type *sim_dwt(void);
+
+void NVIC_EnableIRQ(IRQn_Type IRQn);
+void NVIC_DisableIRQ(IRQn_Type IRQn);
+void NVIC_SetPriority(IRQn_Type IRQn, uint32_t priority);
+uint32_t NVIC_GetPriority(IRQn_Type IRQn);
+void NVIC_SetPriorityGrouping(uint32_t PriorityGroup);
+void NVIC_SetPendingIRQ(IRQn_Type IRQn);
+void NVIC_SystemReset(void);
+void __disable_irq(void);
+void __enable_irq(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#define LPC_GPIO0 (&sim_gpio[0])
+#define LPC_GPIO1 (&sim_gpio[1])
+#define LPC_GPIO2 (&sim_gpio[2])
+#define LPC_GPIO3 (&sim_gpio[3])
+#define LPC_GPIO4 (&sim_gpio[4])
+#define LPC_TIM0  (&sim_timer[0])
+#define LPC_TIM1  (&sim_timer[1])
+#define LPC_TIM2  (&sim_timer[2])
+#define LPC_TIM3  (&sim_timer[3])
+#define LPC_SC    (&sim_sc)
+#define LPC_WDT   (&sim_wdt)
+#define DWT       (sim_dwt())
+#define CoreDebug (&sim_coredebug)
+#define SCB       (&sim_scb)
+
+#endif
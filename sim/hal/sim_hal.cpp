@@ -0,0 +1,122 @@
+/*
+      This file is part of Smoothie (http://smoothieware.org/). The motion control part is heavily based on Grbl (https://github.com/simen/grbl).
+      Smoothie is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+      Smoothie is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+      You should have received a copy of the GNU General Public License along with Smoothie. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Host implementation of the handful of HAL calls the motion code makes
+
+#include "sim_hal.h"
+#include "sLPC17xx.h"
+#include "mbed.h"
+#include "mri.h"
+#include "MRI_Hooks.h"
+#include "platform_memory.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <signal.h>
+#include <chrono>
+
+LPC_GPIO_TypeDef sim_gpio[5];
+LPC_TIM_TypeDef sim_timer[4];
+LPC_SC_TypeDef sim_sc;
+LPC_WDT_TypeDef sim_wdt;
+uint32_t SystemCoreClock= 100000000;
+CoreDebug_Type sim_coredebug;
+SCB_Type sim_scb;
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+static inline uint32_t host_cycles() { return __rdtsc(); }
+#else
+// no cycle counter available so fall back to nanoseconds
+static inline uint32_t host_cycles()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+#endif
+
+// the profiler's cycle counts are host cycles, so they only compare with each other
+DWT_Type *sim_dwt(void)
+{
+    static DWT_Type dwt;
+    dwt.CYCCNT= host_cycles();
+    return &dwt;
+}
+
+// there is no embedded config.default in the simulator, the config always comes from a file so these are never read
+char _binary_config_default_start;
+char _binary_config_default_end;
+
+// AHB0 and AHB1 are the two 16K banks of the LPC1768, here all of it is free for the pools
+static uint8_t sim_ahb0[16384] __attribute__((aligned(8)));
+static uint8_t sim_ahb1[16384] __attribute__((aligned(8)));
+static MemoryPool sim_ahb0_pool(sim_ahb0, sizeof(sim_ahb0));
+static MemoryPool sim_ahb1_pool(sim_ahb1, sizeof(sim_ahb1));
+static struct sim_pools_init {
+    sim_pools_init() { _AHB0= &sim_ahb0_pool; _AHB1= &sim_ahb1_pool; }
+} sim_pools;
+
+static double sim_time_us= 0;
+
+void sim_hal_set_time_us(double us) { sim_time_us= us; }
+double sim_hal_get_time_us() { return sim_time_us; }
+
+// the signal standing in for the interrupts, masked while they are disabled
+static int interrupt_signal= 0;
+
+void sim_hal_set_interrupt_signal(int sig) { interrupt_signal= sig; }
+
+static void mask_interrupt_signal(int how)
+{
+    if(interrupt_signal == 0) return;
+    sigset_t set;
+    sigemptyset(&set);
+    sigaddset(&set, interrupt_signal);
+    sigprocmask(how, &set, nullptr);
+}
+
+extern "C" void PendSV_Handler(void);
+
+void sim_hal_run_pendsv()
+{
+    if((SCB->ICSR & SCB_ICSR_PENDSVSET_Msk) == 0) return;
+    SCB->ICSR= 0;
+    PendSV_Handler();
+}
+
+extern "C" {
+
+uint32_t us_ticker_read(void) { return (uint32_t)sim_time_us; }
+
+// waits are busy loops on the target, there is nothing to wait for here
+void wait(float s) {}
+void wait_ms(int ms) {}
+void wait_us(int us) {}
+
+void NVIC_EnableIRQ(IRQn_Type IRQn) {}
+void NVIC_DisableIRQ(IRQn_Type IRQn) {}
+void NVIC_SetPriority(IRQn_Type IRQn, uint32_t priority) {}
+uint32_t NVIC_GetPriority(IRQn_Type IRQn) { return 0; }
+void NVIC_SetPriorityGrouping(uint32_t PriorityGroup) {}
+void NVIC_SetPendingIRQ(IRQn_Type IRQn) {}
+void NVIC_SystemReset(void) { exit(0); }
+void __disable_irq(void) { mask_interrupt_signal(SIG_BLOCK); }
+void __enable_irq(void) { mask_interrupt_signal(SIG_UNBLOCK); }
+
+void __debugbreak(void)
+{
+    fprintf(stderr, "__debugbreak() hit at simulated time %1.1f us\n", sim_time_us);
+    abort();
+}
+
+int __mriPlatform_CommUartIndex(void) { return 0; }
+
+void __mriPlatform_EnteringDebuggerHook() {}
+void __mriPlatform_LeavingDebuggerHook() {}
+void set_high_on_debug(int port, int pin) {}
+void set_low_on_debug(int port, int pin) {}
+
+}
@@ -0,0 +1,23 @@
+/*
+      This file is part of Smoothie (http://smoothieware.org/). The motion control part is heavily based on Grbl (https://github.com/simen/grbl).
+      Smoothie is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+      Smoothie is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+      You should have received a copy of the GNU General Public License along with Smoothie. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <stdint.h>
+
+// Simulated wall clock shared by us_ticker_read() and the simulation harness.
+// It only moves when the harness runs step ticks, so all the firmware timeouts
+// (queue_delay_time_ms, G4 dwell, safe_delay) run in simulated time.
+void sim_hal_set_time_us(double us);
+double sim_hal_get_time_us();
+
+// Stress tests can run the ISRs from a timer signal, so they interrupt the main thread like they do on the board.
+// __disable_irq() and __enable_irq() then block and unblock that signal
+void sim_hal_set_interrupt_signal(int sig);
+
+// runs PendSV_Handler() if it has been pended, as the board does once no other interrupt is active
+void sim_hal_run_pendsv();
@@ -0,0 +1,193 @@
+/*
+      This file is part of Smoothie (http://smoothieware.org/). The motion control part is heavily based on Grbl (https://github.com/simen/grbl).
+      Smoothie is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+      Smoothie is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+      You should have received a copy of the GNU General Public License along with Smoothie. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+Stress test of the block handoff between the planner and the step ticker.
+
+The step ticker runs from a timer signal, so like TIMER0 on the board it interrupts the planner at any instruction and
+runs to completion before the planner carries on. The main thread queues short random moves and while it waits for room
+in the queue it replans every queued block over and over, alternating between two sets of speeds so consecutive
+trapezoids differ. It fails if the trapezoid a block was taken with is written to while the step ticker runs it, if the
+step ticker never took a block part way through a replan, or if the motors do not end where the planner put them.
+
+usage: handoff config [moves]
+*/
+
+#include "SimKernel.h"
+#include "sim_hal.h"
+
+#include "libs/Kernel.h"
+#include "libs/Module.h"
+#include "libs/StepTicker.h"
+#include "libs/StepperMotor.h"
+#include "libs/StreamOutput.h"
+#include "libs/StreamOutputPool.h"
+#include "modules/robot/Block.h"
+#include "modules/robot/Conveyor.h"
+#include "modules/robot/Robot.h"
+#include "Gcode.h"
+
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <string>
+#include <vector>
+
+// step ticks run per timer signal and the signal interval, a tick is 10us at the default 100KHz
+#define TICKS_PER_INTERRUPT 20
+#define INTERRUPT_US 50
+
+class StdoutStream : public StreamOutput {
+    public:
+        int puts(const char *str) { return fputs(str, stdout); }
+};
+
+// only touched from the signal handler until it is stopped
+static struct {
+    const Block *block;
+    const Block::trapezoid_t *trapezoid;
+    Block::trapezoid_t taken;   // copy of the trapezoid the step ticker took the block with
+    uint32_t blocks;
+    uint32_t changed;           // blocks whose trapezoid was written to while they were stepped
+} isr;
+
+// the parts of a trapezoid the step ticker only reads
+static bool same_plan(const Block::trapezoid_t& a, const Block::trapezoid_t& b)
+{
+    if(a.accelerate_until != b.accelerate_until || a.decelerate_after != b.decelerate_after || a.total_move_ticks != b.total_move_ticks) return false;
+    for (uint8_t m = 0; m < Block::n_actuators; ++m) {
+        if(a.tick_info[m].deceleration_change != b.tick_info[m].deceleration_change || a.tick_info[m].plateau_rate != b.tick_info[m].plateau_rate) return false;
+    }
+    return true;
+}
+
+static void check_block_end()
+{
+    if(isr.block == nullptr) return;
+    if(!same_plan(isr.taken, *isr.trapezoid)) ++isr.changed;
+    ++isr.blocks;
+}
+
+// the step ticker interrupt
+static void step_interrupt(int)
+{
+    StepTicker *st= THEKERNEL->step_ticker;
+    for (int i = 0; i < TICKS_PER_INTERRUPT; ++i) {
+        const Block *b= st->get_current_block();
+        if(b != nullptr && b != isr.block) {
+            isr.block= b;
+            isr.trapezoid= st->get_current_trapezoid();
+            isr.taken= *isr.trapezoid;
+        }
+
+        st->step_tick();
+        st->unstep_tick();
+
+        if(st->get_current_block() != b) {
+            check_block_end();
+            isr.block= nullptr;
+        }
+    }
+    sim_hal_set_time_us(sim_hal_get_time_us() + TICKS_PER_INTERRUPT * 1e6 / st->get_frequency());
+}
+
+// replans all the queued blocks the step ticker has not taken, from idle so it runs whenever the queue is full
+class Replanner : public Module {
+    public:
+        void on_module_loaded() { register_for_event(ON_IDLE); }
+        void on_idle(void *)
+        {
+            float f= (passes++ & 1) ? 0.8F : 1.0F;
+            Block *b;
+            for (unsigned int n = 0; (b= THECONVEYOR->get_planned_block(n)) != nullptr; ++n) {
+                if(b->is_ticking) continue;
+                ++replans;
+                if(!b->calculate_trapezoid(b->entry_speed * f, b->exit_speed * f)) ++lost;
+            }
+        }
+
+        uint32_t passes{0};
+        uint32_t replans{0};
+        uint32_t lost{0};       // taken by the step ticker part way through being replanned
+};
+
+static void run_line(const char *line)
+{
+    Gcode g(line, &StreamOutput::NullStream);
+    THEKERNEL->call_event(ON_GCODE_RECEIVED, &g);
+}
+
+int main(int argc, char *argv[])
+{
+    if(argc < 2) {
+        fprintf(stderr, "usage: handoff config [moves]\n");
+        return 1;
+    }
+    int moves= argc > 2 ? atoi(argv[2]) : 500;
+
+    Kernel *kernel= new Kernel();
+    StdoutStream out;
+    kernel->streams->append_stream(&out);
+
+    // the trapezoids are only used when the step ticker is not fed segments
+    std::vector<std::string> overrides{"step_segment_ms=0", "step_event_scheduling=false"};
+    if(!sim_kernel_setup(argv[1], overrides)) return 1;
+
+    Replanner *replanner= new Replanner();
+    kernel->add_module(replanner);
+
+    sim_hal_set_interrupt_signal(SIGALRM);
+    signal(SIGALRM, step_interrupt);
+    struct itimerval it;
+    it.it_interval.tv_sec= 0;
+    it.it_interval.tv_usec= INTERRUPT_US;
+    it.it_value= it.it_interval;
+    setitimer(ITIMER_REAL, &it, nullptr);
+
+    // short moves in random directions at random speeds, so the junctions and the replanned speeds keep changing
+    uint32_t seed= 12345;
+    auto rnd= [&seed]() { seed= seed * 1103515245 + 12345; return (seed >> 8) / 16777216.0F; };
+    float x= 50, y= 50;
+    char buf[64];
+    run_line("G90");
+    for (int i = 0; i < moves; ++i) {
+        x= std::min(std::max(x + (rnd() - 0.5F) * 4, 0.0F), 100.0F);
+        y= std::min(std::max(y + (rnd() - 0.5F) * 4, 0.0F), 100.0F);
+        snprintf(buf, sizeof(buf), "G1 X%1.3f Y%1.3f F%d", x, y, 600 + (int)(rnd() * 11400));
+        run_line(buf);
+        kernel->call_event(ON_MAIN_LOOP);
+        kernel->call_event(ON_IDLE);
+    }
+    kernel->conveyor->wait_for_idle();
+
+    memset(&it, 0, sizeof(it));
+    setitimer(ITIMER_REAL, &it, nullptr);
+    signal(SIGALRM, SIG_IGN);
+
+    printf("blocks: %lu, replanned %lu times, %lu of them taken by the step ticker part way through\n", (unsigned long)isr.blocks,
+        (unsigned long)replanner->replans, (unsigned long)replanner->lost);
+
+    bool ok= isr.blocks > 0 && replanner->lost > 0;
+    if(replanner->lost == 0) printf("FAIL the step ticker never interrupted a replan\n");
+    if(isr.changed > 0) {
+        printf("FAIL %lu blocks had their trapezoid changed while they were stepped\n", (unsigned long)isr.changed);
+        ok= false;
+    }
+    for (uint8_t m = 0; m < THEROBOT->get_number_registered_motors(); ++m) {
+        StepperMotor *a= THEROBOT->actuators[m];
+        if((int32_t)a->get_current_step() != a->get_last_milestone_steps()) {
+            printf("FAIL motor %d: at step %ld expected %ld\n", m, (long)(int32_t)a->get_current_step(), (long)a->get_last_milestone_steps());
+            ok= false;
+        }
+    }
+
+    if(!ok) return 1;
+    printf("PASS\n");
+    return 0;
+}
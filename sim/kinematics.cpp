@@ -0,0 +1,128 @@
+/*
+      This file is part of Smoothie (http://smoothieware.org/). The motion control part is heavily based on Grbl (https://github.com/simen/grbl).
+      Smoothie is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+      Smoothie is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+      You should have received a copy of the GNU General Public License along with Smoothie. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+Checks the delta_fast_kinematics inverse kinematics of the delta arm solutions against the float versions,
+over the whole build volume of a few different geometries.
+
+usage: kinematics
+*/
+
+#include "libs/Kernel.h"
+#include "libs/Config.h"
+#include "libs/StreamOutputPool.h"
+#include "libs/ConfigSources/FirmConfigSource.h"
+#include "arm_solutions/LinearDeltaSolution.h"
+#include "arm_solutions/RotaryDeltaSolution.h"
+
+#include <stdio.h>
+#include <math.h>
+#include <string>
+
+// the largest allowed difference, mm for the linear delta and degrees for the rotary delta
+#define LINEAR_DELTA_MAX_ERROR 0.001
+#define ROTARY_DELTA_MAX_ERROR 0.001
+
+static Config *make_config(const std::string& text)
+{
+    static std::string config_text;
+    config_text= text;
+    Config *config= new Config(new FirmConfigSource("kinematics", config_text.data(), config_text.data() + config_text.size()));
+    config->config_cache_load();
+    return config;
+}
+
+struct result_t {
+    double max_error;
+    float at[3];
+    unsigned long points;
+};
+
+// compares the two solutions at every point of the grid that the reference can reach,
+// min_height skips the points where an actuator is less than that above z, only used for the linear delta
+static result_t compare(BaseSolution *reference, BaseSolution *fast, float radius, float zmin, float zmax, float xy_step, float z_step, float min_height)
+{
+    result_t r{0, {0, 0, 0}, 0};
+    for (float z = zmin; z <= zmax; z += z_step) {
+        for (float x = -radius; x <= radius; x += xy_step) {
+            for (float y = -radius; y <= radius; y += xy_step) {
+                if(x * x + y * y > radius * radius) continue;
+                float c[3]= {x, y, z};
+                ActuatorCoordinates a, b;
+                reference->cartesian_to_actuator(c, a);
+                fast->cartesian_to_actuator(c, b);
+                if(isnan(a[0]) || isnan(a[1]) || isnan(a[2])) continue;
+                if(a[0] - z < min_height || a[1] - z < min_height || a[2] - z < min_height) continue;
+                for (int i = 0; i < 3; ++i) {
+                    double e= fabs((double)a[i] - b[i]);
+                    if(e > r.max_error) {
+                        r.max_error= e;
+                        r.at[0]= x; r.at[1]= y; r.at[2]= z;
+                    }
+                }
+                ++r.points;
+            }
+        }
+    }
+    return r;
+}
+
+static bool check_linear_delta(const std::string& geometry, float radius)
+{
+    Config *config= make_config(geometry);
+    LinearDeltaSolution reference(config);
+    delete config;
+    config= make_config(geometry + "delta_fast_kinematics true\n");
+    LinearDeltaSolution fast(config);
+    delete config;
+
+    BaseSolution::arm_options_t options;
+    reference.get_optional(options, true);
+    // with the arms near horizontal both versions lose all precision, a delta can't be used there anyway
+    // so the build volume is where all the arms are at least 20 degrees above horizontal
+    result_t r= compare(&reference, &fast, radius, -50, 350, 0.7F, 50, options['L'] * sinf(20 * M_PI / 180));
+    bool ok= r.points > 0 && r.max_error <= LINEAR_DELTA_MAX_ERROR;
+    printf("linear delta L%1.1f R%1.1f A%1.1f D%1.1f: max error %1.6f mm at %1.1f,%1.1f,%1.1f over %lu points %s\n",
+           options['L'], options['R'], options['A'], options['D'], r.max_error, r.at[0], r.at[1], r.at[2], r.points, ok ? "ok" : "FAIL");
+    return ok;
+}
+
+static bool check_rotary_delta(const std::string& geometry, float radius, float zmin, float zmax)
+{
+    Config *config= make_config(geometry);
+    RotaryDeltaSolution reference(config);
+    delete config;
+    config= make_config(geometry + "delta_fast_kinematics true\n");
+    RotaryDeltaSolution fast(config);
+    delete config;
+
+    BaseSolution::arm_options_t options;
+    reference.get_optional(options, true);
+    result_t r= compare(&reference, &fast, radius, zmin, zmax, 1.3F, 10, -INFINITY);
+    bool ok= r.points > 0 && r.max_error <= ROTARY_DELTA_MAX_ERROR;
+    printf("rotary delta E%1.1f F%1.1f RE%1.1f RF%1.1f: max error %1.6f degrees at %1.1f,%1.1f,%1.1f over %lu points %s\n",
+           options['A'], options['B'], options['C'], options['D'], r.max_error, r.at[0], r.at[1], r.at[2], r.points, ok ? "ok" : "FAIL");
+    return ok;
+}
+
+int main(int argc, char *argv[])
+{
+    new Kernel();
+
+    bool ok= true;
+    ok= check_linear_delta("", 124) && ok;
+    ok= check_linear_delta("arm_length 300\narm_radius 160\n", 160) && ok;
+    ok= check_linear_delta("arm_length 215\narm_radius 105\ndelta_tower1_offset 0.5\ndelta_tower1_angle -0.3\ndelta_tower3_angle 0.2\n", 105) && ok;
+    ok= check_linear_delta("arm_length 440\narm_radius 220\n", 220) && ok;
+
+    ok= check_rotary_delta("", 150, -100, 100) && ok;
+    ok= check_rotary_delta("delta_mirror_xy false\ndelta_re 300\n", 150, -100, 100) && ok;
+
+    if(!ok) return 1;
+    printf("PASS\n");
+    return 0;
+}
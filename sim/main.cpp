@@ -0,0 +1,217 @@
+/*
+      This file is part of Smoothie (http://smoothieware.org/). The motion control part is heavily based on Grbl (https://github.com/simen/grbl).
+      Smoothie is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+      Smoothie is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+      You should have received a copy of the GNU General Public License along with Smoothie. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+Host simulator for the motion pipeline.
+
+Runs gcode files through Robot, Planner, Conveyor and the StepTicker ISRs with a stubbed HAL,
+simulated time only advances when the idle loop runs so the results are deterministic.
+
+usage: smoothiesim -c config [-D key=value] [-s slice_us] [-r lines_per_s] [-o steps.csv] [-e ms:cmd] [--check] [--path] [--laser] [--shaper] [--advance] [--profile] file.gcode ...
+
+A file made by gcode2smj is played from its records, the moves go straight to Robot as on the board.
+*/
+
+#include "SimKernel.h"
+#include "MotionSim.h"
+#include "sim_hal.h"
+
+#include "libs/Kernel.h"
+#include "libs/Profiler.h"
+#include "libs/StreamOutput.h"
+#include "libs/StreamOutputPool.h"
+#include "modules/robot/Conveyor.h"
+#include "modules/robot/Robot.h"
+#include "Gcode.h"
+#include "SerialMessage.h"
+#include "CompiledJob.h"
+#include "LineReader.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+class StdoutStream : public StreamOutput {
+    public:
+        int puts(const char *str) { return fputs(str, stdout); }
+};
+
+// the same splitting GcodeDispatch does on a line, without the line numbers and checksums
+static void dispatch_line(std::string line, StreamOutput *stream)
+{
+    static int modal_group_1= 0;
+
+    size_t comment = line.find_first_of(";(");
+    if(comment != std::string::npos) line = line.substr(0, comment);
+    while(!line.empty() && isspace(line.back())) line.pop_back();
+    size_t start= line.find_first_not_of(" \t");
+    if(start == std::string::npos) return;
+    line= line.substr(start);
+
+    char first_char = line[0];
+    if(first_char == '@') {
+        // raster data, it is not Gcode so it goes to the modules as a console line
+        SerialMessage message{stream, line};
+        THEKERNEL->call_event(ON_CONSOLE_LINE_RECEIVED, &message);
+        return;
+    }
+    if(first_char == 'X' || first_char == 'Y' || first_char == 'Z' || first_char == 'A' || first_char == 'F') {
+        // modal command, reuse the last G0-G3
+        line= "G" + std::to_string(modal_group_1) + " " + line;
+        first_char= 'G';
+    }
+    if(first_char != 'G' && first_char != 'M' && first_char != 'T') return;
+
+    while(line.size() > 0) {
+        size_t nextcmd = line.find_first_of("GM", 2);
+        std::string single_command;
+        if(nextcmd == std::string::npos) {
+            single_command = line;
+            line = "";
+        } else {
+            single_command = line.substr(0, nextcmd);
+            line = line.substr(nextcmd);
+        }
+
+        Gcode *gcode = new Gcode(single_command, stream);
+        if(gcode->has_g && gcode->g <= 3) modal_group_1= gcode->g;
+        THEKERNEL->call_event(ON_GCODE_RECEIVED, gcode);
+        delete gcode;
+    }
+}
+
+static void usage()
+{
+    fprintf(stderr, "usage: smoothiesim -c config [-D key=value] [-s slice_us] [-r lines_per_s] [-o steps.csv] [-e ms:cmd] [--check] [--path] [--laser] [--shaper] [--advance] [--profile] file.gcode ...\n");
+    exit(2);
+}
+
+int main(int argc, char *argv[])
+{
+    const char *config_file= nullptr;
+    const char *step_file= nullptr;
+    uint32_t slice_us= 250;
+    float line_rate= 0;
+    bool check= false;
+    bool path= false;
+    bool laser= false;
+    bool shaper= false;
+    bool advance= false;
+    bool profile= false;
+    std::vector<const char*> files;
+    std::vector<std::string> overrides;
+    std::vector<std::string> commands;
+
+    for (int i = 1; i < argc; ++i) {
+        if(strcmp(argv[i], "-c") == 0 && i+1 < argc) config_file= argv[++i];
+        else if(strcmp(argv[i], "-D") == 0 && i+1 < argc) overrides.push_back(argv[++i]);
+        else if(strcmp(argv[i], "-s") == 0 && i+1 < argc) slice_us= strtoul(argv[++i], nullptr, 10);
+        else if(strcmp(argv[i], "-r") == 0 && i+1 < argc) line_rate= strtof(argv[++i], nullptr);
+        else if(strcmp(argv[i], "-o") == 0 && i+1 < argc) step_file= argv[++i];
+        else if(strcmp(argv[i], "-e") == 0 && i+1 < argc) commands.push_back(argv[++i]);
+        else if(strcmp(argv[i], "--check") == 0) check= true;
+        else if(strcmp(argv[i], "--path") == 0) path= true;
+        else if(strcmp(argv[i], "--laser") == 0) laser= true;
+        else if(strcmp(argv[i], "--shaper") == 0) shaper= true;
+        else if(strcmp(argv[i], "--advance") == 0) advance= true;
+        else if(strcmp(argv[i], "--profile") == 0) profile= true;
+        else if(argv[i][0] == '-') usage();
+        else files.push_back(argv[i]);
+    }
+    if(config_file == nullptr || files.empty()) usage();
+
+    Kernel *kernel= new Kernel();
+    StdoutStream out;
+    kernel->streams->append_stream(&out);
+
+    if(!sim_kernel_setup(config_file, overrides)) return 1;
+
+    MotionSim *sim= new MotionSim(slice_us);
+    kernel->add_module(sim);
+    sim->set_track_path(path);
+    sim->set_track_laser(laser);
+    sim->set_track_shaper(shaper);
+    sim->set_track_advance(advance);
+    if(profile) Profiler::enable(true);
+
+    // real time commands, ms:! feed hold, ms:~ resume, ms:nn feed override of nn percent
+    for(auto& e : commands) {
+        size_t colon= e.find(':');
+        if(colon == std::string::npos || colon + 1 >= e.size()) usage();
+        double t= strtod(e.c_str(), nullptr) * 1000;
+        char cmd= e[colon + 1];
+        if(cmd == '!' || cmd == '~') sim->add_realtime_command(t, cmd, 0);
+        else sim->add_realtime_command(t, '%', strtof(e.c_str() + colon + 1, nullptr));
+    }
+
+    FILE *step_log= nullptr;
+    if(step_file != nullptr) {
+        step_log= fopen(step_file, "w");
+        if(step_log == nullptr) {
+            fprintf(stderr, "cannot open %s\n", step_file);
+            return 1;
+        }
+        fprintf(step_log, "time_us,motor,position\n");
+        sim->set_step_log(step_log);
+    }
+
+    char buf[256];
+    for(auto fn : files) {
+        FILE *fp= fopen(fn, "r");
+        if(fp == nullptr) {
+            fprintf(stderr, "cannot open %s\n", fn);
+            return 1;
+        }
+        bool compiled= fread(buf, 1, CompiledJob::header_size, fp) == CompiledJob::header_size && CompiledJob::is_compiled(buf);
+        rewind(fp);
+        LineReader reader;
+        CompiledJob::record_t record;
+        if(compiled) reader.attach(fp, CompiledJob::header_size);
+
+        // same as the Player, one line per main loop iteration, or a host streaming at most line_rate lines a second
+        for(;;) {
+            double due= sim_hal_get_time_us() + (line_rate > 0 ? 1e6F / line_rate : 0);
+            if(compiled) {
+                int len= CompiledJob::read_record(reader, record);
+                if(len < 0) {
+                    fprintf(stderr, "%s: bad record\n", fn);
+                    return 1;
+                }
+                if(len == 0) break;
+                if(record.type == CompiledJob::LINE) dispatch_line(record.line, &StreamOutput::NullStream);
+                else THEROBOT->compiled_move(record.type, record.words);
+
+            } else {
+                if(fgets(buf, sizeof(buf), fp) == nullptr) break;
+                dispatch_line(buf, &StreamOutput::NullStream);
+            }
+            kernel->call_event(ON_MAIN_LOOP);
+            do {
+                kernel->call_event(ON_IDLE);
+            } while(sim_hal_get_time_us() < due);
+            sim->line_done();
+        }
+        reader.attach(nullptr);
+        fclose(fp);
+    }
+
+    kernel->conveyor->wait_for_idle();
+
+    sim->report();
+    if(profile) Profiler::dump(&out);
+    if(step_log != nullptr) fclose(step_log);
+
+    if(check) {
+        if(!sim->check()) return 1;
+        printf("PASS\n");
+    }
+
+    sim_kernel_teardown();
+    return 0;
+}
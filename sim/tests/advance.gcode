@@ -0,0 +1,32 @@
+; extrusion at different speeds and extrusion ratios with pressure advance, travel moves, a retract and M900 changes,
+; and fast extrusion straight into a travel and back, where the advance has to be held to the extruder's limits
+G21
+G90
+M83
+G1 X10 Y10 F3000
+G1 X40 Y10 E1.5 F1800
+G1 X40 Y40 E1.5
+G1 X10 Y40 E3.0 F4800
+G1 X10 Y12 E1.2
+G1 E-2 F2400
+G0 X60 Y60 F9000
+G1 E2 F2400
+G1 X90 Y60 E1.0 F3000
+G1 X92 Y61 E0.1
+G1 X94 Y60 E0.1
+G1 X96 Y61 E0.1
+G1 X120 Y60 E2.5 F6000
+M900 K0.02
+G1 X120 Y90 E1.2 F2400
+G1 X60 Y90 E2.4 F6000
+M900 K0
+G1 X60 Y60 E1.2
+M900 K0.08
+G1 X30 Y30 E1.7 F3600
+G1 X0 Y0 E1.7 F1200
+M900 K0.1
+G1 X40 Y0 E4.0 F6000
+G0 X40 Y40 F9000
+G1 X0 Y40 E4.0 F6000
+G0 X0 Y0 F9000
+M900 K0.05
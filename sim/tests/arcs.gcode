@@ -0,0 +1,9 @@
+; full circle and some quarter arcs
+G21
+G90
+G0 X10 Y0 Z1 F6000
+G2 X10 Y0 I-10 J0 F3000
+G3 X0 Y10 I-10 J0
+G2 X-10 Y0 I0 J-10
+G1 X0 Y0
+G0 Z0
@@ -0,0 +1,733 @@
+; CNC finishing toolpath: a raster over a dome, then a pocket outline with tight corners
+G21 G90
+G0 Z5
+G0 X0 Y0
+G1 Z0 F600
+F1800
+G1 X0.000 Y0.000 Z-3.000
+G1 X1.000 Y0.000 Z-3.000
+G1 X2.000 Y0.000 Z-3.000
+G1 X3.000 Y0.000 Z-3.000
+G1 X4.000 Y0.000 Z-3.000
+G1 X5.000 Y0.000 Z-3.000
+G1 X6.000 Y0.000 Z-3.000
+G1 X7.000 Y0.000 Z-3.000
+G1 X8.000 Y0.000 Z-2.988
+G1 X9.000 Y0.000 Z-2.964
+G1 X10.000 Y0.000 Z-2.929
+G1 X11.000 Y0.000 Z-2.885
+G1 X12.000 Y0.000 Z-2.837
+G1 X13.000 Y0.000 Z-2.785
+G1 X14.000 Y0.000 Z-2.735
+G1 X15.000 Y0.000 Z-2.687
+G1 X16.000 Y0.000 Z-2.644
+G1 X17.000 Y0.000 Z-2.609
+G1 X18.000 Y0.000 Z-2.583
+G1 X19.000 Y0.000 Z-2.566
+G1 X20.000 Y0.000 Z-2.561
+G1 X21.000 Y0.000 Z-2.566
+G1 X22.000 Y0.000 Z-2.583
+G1 X23.000 Y0.000 Z-2.609
+G1 X24.000 Y0.000 Z-2.644
+G1 X25.000 Y0.000 Z-2.687
+G1 X26.000 Y0.000 Z-2.735
+G1 X27.000 Y0.000 Z-2.785
+G1 X28.000 Y0.000 Z-2.837
+G1 X29.000 Y0.000 Z-2.885
+G1 X30.000 Y0.000 Z-2.929
+G1 X31.000 Y0.000 Z-2.964
+G1 X32.000 Y0.000 Z-2.988
+G1 X33.000 Y0.000 Z-3.000
+G1 X34.000 Y0.000 Z-3.000
+G1 X35.000 Y0.000 Z-3.000
+G1 X36.000 Y0.000 Z-3.000
+G1 X37.000 Y0.000 Z-3.000
+G1 X38.000 Y0.000 Z-3.000
+G1 X39.000 Y0.000 Z-3.000
+G1 X40.000 Y0.000 Z-3.000
+G1 X40.000 Y2.000 Z-3.000
+G1 X39.000 Y2.000 Z-3.000
+G1 X38.000 Y2.000 Z-3.000
+G1 X37.000 Y2.000 Z-3.000
+G1 X36.000 Y2.000 Z-3.000
+G1 X35.000 Y2.000 Z-3.000
+G1 X34.000 Y2.000 Z-2.985
+G1 X33.000 Y2.000 Z-2.952
+G1 X32.000 Y2.000 Z-2.902
+G1 X31.000 Y2.000 Z-2.840
+G1 X30.000 Y2.000 Z-2.767
+G1 X29.000 Y2.000 Z-2.687
+G1 X28.000 Y2.000 Z-2.604
+G1 X27.000 Y2.000 Z-2.521
+G1 X26.000 Y2.000 Z-2.441
+G1 X25.000 Y2.000 Z-2.368
+G1 X24.000 Y2.000 Z-2.304
+G1 X23.000 Y2.000 Z-2.252
+G1 X22.000 Y2.000 Z-2.213
+G1 X21.000 Y2.000 Z-2.189
+G1 X20.000 Y2.000 Z-2.181
+G1 X19.000 Y2.000 Z-2.189
+G1 X18.000 Y2.000 Z-2.213
+G1 X17.000 Y2.000 Z-2.252
+G1 X16.000 Y2.000 Z-2.304
+G1 X15.000 Y2.000 Z-2.368
+G1 X14.000 Y2.000 Z-2.441
+G1 X13.000 Y2.000 Z-2.521
+G1 X12.000 Y2.000 Z-2.604
+G1 X11.000 Y2.000 Z-2.687
+G1 X10.000 Y2.000 Z-2.767
+G1 X9.000 Y2.000 Z-2.840
+G1 X8.000 Y2.000 Z-2.902
+G1 X7.000 Y2.000 Z-2.952
+G1 X6.000 Y2.000 Z-2.985
+G1 X5.000 Y2.000 Z-3.000
+G1 X4.000 Y2.000 Z-3.000
+G1 X3.000 Y2.000 Z-3.000
+G1 X2.000 Y2.000 Z-3.000
+G1 X1.000 Y2.000 Z-3.000
+G1 X0.000 Y2.000 Z-3.000
+G1 X0.000 Y4.000 Z-3.000
+G1 X1.000 Y4.000 Z-3.000
+G1 X2.000 Y4.000 Z-3.000
+G1 X3.000 Y4.000 Z-3.000
+G1 X4.000 Y4.000 Z-2.994
+G1 X5.000 Y4.000 Z-2.964
+G1 X6.000 Y4.000 Z-2.912
+G1 X7.000 Y4.000 Z-2.840
+G1 X8.000 Y4.000 Z-2.751
+G1 X9.000 Y4.000 Z-2.649
+G1 X10.000 Y4.000 Z-2.538
+G1 X11.000 Y4.000 Z-2.422
+G1 X12.000 Y4.000 Z-2.304
+G1 X13.000 Y4.000 Z-2.189
+G1 X14.000 Y4.000 Z-2.081
+G1 X15.000 Y4.000 Z-1.982
+G1 X16.000 Y4.000 Z-1.897
+G1 X17.000 Y4.000 Z-1.828
+G1 X18.000 Y4.000 Z-1.777
+G1 X19.000 Y4.000 Z-1.745
+G1 X20.000 Y4.000 Z-1.735
+G1 X21.000 Y4.000 Z-1.745
+G1 X22.000 Y4.000 Z-1.777
+G1 X23.000 Y4.000 Z-1.828
+G1 X24.000 Y4.000 Z-1.897
+G1 X25.000 Y4.000 Z-1.982
+G1 X26.000 Y4.000 Z-2.081
+G1 X27.000 Y4.000 Z-2.189
+G1 X28.000 Y4.000 Z-2.304
+G1 X29.000 Y4.000 Z-2.422
+G1 X30.000 Y4.000 Z-2.538
+G1 X31.000 Y4.000 Z-2.649
+G1 X32.000 Y4.000 Z-2.751
+G1 X33.000 Y4.000 Z-2.840
+G1 X34.000 Y4.000 Z-2.912
+G1 X35.000 Y4.000 Z-2.964
+G1 X36.000 Y4.000 Z-2.994
+G1 X37.000 Y4.000 Z-3.000
+G1 X38.000 Y4.000 Z-3.000
+G1 X39.000 Y4.000 Z-3.000
+G1 X40.000 Y4.000 Z-3.000
+G1 X40.000 Y6.000 Z-3.000
+G1 X39.000 Y6.000 Z-3.000
+G1 X38.000 Y6.000 Z-3.000
+G1 X37.000 Y6.000 Z-2.989
+G1 X36.000 Y6.000 Z-2.950
+G1 X35.000 Y6.000 Z-2.885
+G1 X34.000 Y6.000 Z-2.796
+G1 X33.000 Y6.000 Z-2.687
+G1 X32.000 Y6.000 Z-2.561
+G1 X31.000 Y6.000 Z-2.422
+G1 X30.000 Y6.000 Z-2.274
+G1 X29.000 Y6.000 Z-2.123
+G1 X28.000 Y6.000 Z-1.973
+G1 X27.000 Y6.000 Z-1.828
+G1 X26.000 Y6.000 Z-1.692
+G1 X25.000 Y6.000 Z-1.570
+G1 X24.000 Y6.000 Z-1.464
+G1 X23.000 Y6.000 Z-1.379
+G1 X22.000 Y6.000 Z-1.317
+G1 X21.000 Y6.000 Z-1.278
+G1 X20.000 Y6.000 Z-1.265
+G1 X19.000 Y6.000 Z-1.278
+G1 X18.000 Y6.000 Z-1.317
+G1 X17.000 Y6.000 Z-1.379
+G1 X16.000 Y6.000 Z-1.464
+G1 X15.000 Y6.000 Z-1.570
+G1 X14.000 Y6.000 Z-1.692
+G1 X13.000 Y6.000 Z-1.828
+G1 X12.000 Y6.000 Z-1.973
+G1 X11.000 Y6.000 Z-2.123
+G1 X10.000 Y6.000 Z-2.274
+G1 X9.000 Y6.000 Z-2.422
+G1 X8.000 Y6.000 Z-2.561
+G1 X7.000 Y6.000 Z-2.687
+G1 X6.000 Y6.000 Z-2.796
+G1 X5.000 Y6.000 Z-2.885
+G1 X4.000 Y6.000 Z-2.950
+G1 X3.000 Y6.000 Z-2.989
+G1 X2.000 Y6.000 Z-3.000
+G1 X1.000 Y6.000 Z-3.000
+G1 X0.000 Y6.000 Z-3.000
+G1 X0.000 Y8.000 Z-3.000
+G1 X1.000 Y8.000 Z-3.000
+G1 X2.000 Y8.000 Z-2.991
+G1 X3.000 Y8.000 Z-2.952
+G1 X4.000 Y8.000 Z-2.883
+G1 X5.000 Y8.000 Z-2.785
+G1 X6.000 Y8.000 Z-2.664
+G1 X7.000 Y8.000 Z-2.521
+G1 X8.000 Y8.000 Z-2.361
+G1 X9.000 Y8.000 Z-2.189
+G1 X10.000 Y8.000 Z-2.010
+G1 X11.000 Y8.000 Z-1.828
+G1 X12.000 Y8.000 Z-1.648
+G1 X13.000 Y8.000 Z-1.476
+G1 X14.000 Y8.000 Z-1.317
+G1 X15.000 Y8.000 Z-1.173
+G1 X16.000 Y8.000 Z-1.050
+G1 X17.000 Y8.000 Z-0.951
+G1 X18.000 Y8.000 Z-0.878
+G1 X19.000 Y8.000 Z-0.834
+G1 X20.000 Y8.000 Z-0.819
+G1 X21.000 Y8.000 Z-0.834
+G1 X22.000 Y8.000 Z-0.878
+G1 X23.000 Y8.000 Z-0.951
+G1 X24.000 Y8.000 Z-1.050
+G1 X25.000 Y8.000 Z-1.173
+G1 X26.000 Y8.000 Z-1.317
+G1 X27.000 Y8.000 Z-1.476
+G1 X28.000 Y8.000 Z-1.648
+G1 X29.000 Y8.000 Z-1.828
+G1 X30.000 Y8.000 Z-2.010
+G1 X31.000 Y8.000 Z-2.189
+G1 X32.000 Y8.000 Z-2.361
+G1 X33.000 Y8.000 Z-2.521
+G1 X34.000 Y8.000 Z-2.664
+G1 X35.000 Y8.000 Z-2.785
+G1 X36.000 Y8.000 Z-2.883
+G1 X37.000 Y8.000 Z-2.952
+G1 X38.000 Y8.000 Z-2.991
+G1 X39.000 Y8.000 Z-3.000
+G1 X40.000 Y8.000 Z-3.000
+G1 X40.000 Y10.000 Z-3.000
+G1 X39.000 Y10.000 Z-2.998
+G1 X38.000 Y10.000 Z-2.968
+G1 X37.000 Y10.000 Z-2.905
+G1 X36.000 Y10.000 Z-2.810
+G1 X35.000 Y10.000 Z-2.687
+G1 X34.000 Y10.000 Z-2.538
+G1 X33.000 Y10.000 Z-2.368
+G1 X32.000 Y10.000 Z-2.181
+G1 X31.000 Y10.000 Z-1.982
+G1 X30.000 Y10.000 Z-1.777
+G1 X29.000 Y10.000 Z-1.570
+G1 X28.000 Y10.000 Z-1.367
+G1 X27.000 Y10.000 Z-1.173
+G1 X26.000 Y10.000 Z-0.994
+G1 X25.000 Y10.000 Z-0.834
+G1 X24.000 Y10.000 Z-0.697
+G1 X23.000 Y10.000 Z-0.586
+G1 X22.000 Y10.000 Z-0.505
+G1 X21.000 Y10.000 Z-0.456
+G1 X20.000 Y10.000 Z-0.439
+G1 X19.000 Y10.000 Z-0.456
+G1 X18.000 Y10.000 Z-0.505
+G1 X17.000 Y10.000 Z-0.586
+G1 X16.000 Y10.000 Z-0.697
+G1 X15.000 Y10.000 Z-0.834
+G1 X14.000 Y10.000 Z-0.994
+G1 X13.000 Y10.000 Z-1.173
+G1 X12.000 Y10.000 Z-1.367
+G1 X11.000 Y10.000 Z-1.570
+G1 X10.000 Y10.000 Z-1.777
+G1 X9.000 Y10.000 Z-1.982
+G1 X8.000 Y10.000 Z-2.181
+G1 X7.000 Y10.000 Z-2.368
+G1 X6.000 Y10.000 Z-2.538
+G1 X5.000 Y10.000 Z-2.687
+G1 X4.000 Y10.000 Z-2.810
+G1 X3.000 Y10.000 Z-2.905
+G1 X2.000 Y10.000 Z-2.968
+G1 X1.000 Y10.000 Z-2.998
+G1 X0.000 Y10.000 Z-3.000
+G1 X0.000 Y12.000 Z-3.000
+G1 X1.000 Y12.000 Z-2.989
+G1 X2.000 Y12.000 Z-2.944
+G1 X3.000 Y12.000 Z-2.863
+G1 X4.000 Y12.000 Z-2.751
+G1 X5.000 Y12.000 Z-2.609
+G1 X6.000 Y12.000 Z-2.441
+G1 X7.000 Y12.000 Z-2.252
+G1 X8.000 Y12.000 Z-2.045
+G1 X9.000 Y12.000 Z-1.828
+G1 X10.000 Y12.000 Z-1.604
+G1 X11.000 Y12.000 Z-1.379
+G1 X12.000 Y12.000 Z-1.160
+G1 X13.000 Y12.000 Z-0.951
+G1 X14.000 Y12.000 Z-0.758
+G1 X15.000 Y12.000 Z-0.586
+G1 X16.000 Y12.000 Z-0.439
+G1 X17.000 Y12.000 Z-0.321
+G1 X18.000 Y12.000 Z-0.234
+G1 X19.000 Y12.000 Z-0.181
+G1 X20.000 Y12.000 Z-0.163
+G1 X21.000 Y12.000 Z-0.181
+G1 X22.000 Y12.000 Z-0.234
+G1 X23.000 Y12.000 Z-0.321
+G1 X24.000 Y12.000 Z-0.439
+G1 X25.000 Y12.000 Z-0.586
+G1 X26.000 Y12.000 Z-0.758
+G1 X27.000 Y12.000 Z-0.951
+G1 X28.000 Y12.000 Z-1.160
+G1 X29.000 Y12.000 Z-1.379
+G1 X30.000 Y12.000 Z-1.604
+G1 X31.000 Y12.000 Z-1.828
+G1 X32.000 Y12.000 Z-2.045
+G1 X33.000 Y12.000 Z-2.252
+G1 X34.000 Y12.000 Z-2.441
+G1 X35.000 Y12.000 Z-2.609
+G1 X36.000 Y12.000 Z-2.751
+G1 X37.000 Y12.000 Z-2.863
+G1 X38.000 Y12.000 Z-2.944
+G1 X39.000 Y12.000 Z-2.989
+G1 X40.000 Y12.000 Z-3.000
+G1 X40.000 Y14.000 Z-3.000
+G1 X39.000 Y14.000 Z-2.982
+G1 X38.000 Y14.000 Z-2.929
+G1 X37.000 Y14.000 Z-2.840
+G1 X36.000 Y14.000 Z-2.718
+G1 X35.000 Y14.000 Z-2.566
+G1 X34.000 Y14.000 Z-2.388
+G1 X33.000 Y14.000 Z-2.189
+G1 X32.000 Y14.000 Z-1.973
+G1 X31.000 Y14.000 Z-1.745
+G1 X30.000 Y14.000 Z-1.512
+G1 X29.000 Y14.000 Z-1.278
+G1 X28.000 Y14.000 Z-1.050
+G1 X27.000 Y14.000 Z-0.834
+G1 X26.000 Y14.000 Z-0.634
+G1 X25.000 Y14.000 Z-0.456
+G1 X24.000 Y14.000 Z-0.304
+G1 X23.000 Y14.000 Z-0.181
+G1 X22.000 Y14.000 Z-0.092
+G1 X21.000 Y14.000 Z-0.037
+G1 X20.000 Y14.000 Z-0.018
+G1 X19.000 Y14.000 Z-0.037
+G1 X18.000 Y14.000 Z-0.092
+G1 X17.000 Y14.000 Z-0.181
+G1 X16.000 Y14.000 Z-0.304
+G1 X15.000 Y14.000 Z-0.456
+G1 X14.000 Y14.000 Z-0.634
+G1 X13.000 Y14.000 Z-0.834
+G1 X12.000 Y14.000 Z-1.050
+G1 X11.000 Y14.000 Z-1.278
+G1 X10.000 Y14.000 Z-1.512
+G1 X9.000 Y14.000 Z-1.745
+G1 X8.000 Y14.000 Z-1.973
+G1 X7.000 Y14.000 Z-2.189
+G1 X6.000 Y14.000 Z-2.388
+G1 X5.000 Y14.000 Z-2.566
+G1 X4.000 Y14.000 Z-2.718
+G1 X3.000 Y14.000 Z-2.840
+G1 X2.000 Y14.000 Z-2.929
+G1 X1.000 Y14.000 Z-2.982
+G1 X0.000 Y14.000 Z-3.000
+G1 X0.000 Y16.000 Z-3.000
+G1 X1.000 Y16.000 Z-2.982
+G1 X2.000 Y16.000 Z-2.929
+G1 X3.000 Y16.000 Z-2.840
+G1 X4.000 Y16.000 Z-2.718
+G1 X5.000 Y16.000 Z-2.566
+G1 X6.000 Y16.000 Z-2.388
+G1 X7.000 Y16.000 Z-2.189
+G1 X8.000 Y16.000 Z-1.973
+G1 X9.000 Y16.000 Z-1.745
+G1 X10.000 Y16.000 Z-1.512
+G1 X11.000 Y16.000 Z-1.278
+G1 X12.000 Y16.000 Z-1.050
+G1 X13.000 Y16.000 Z-0.834
+G1 X14.000 Y16.000 Z-0.634
+G1 X15.000 Y16.000 Z-0.456
+G1 X16.000 Y16.000 Z-0.304
+G1 X17.000 Y16.000 Z-0.181
+G1 X18.000 Y16.000 Z-0.092
+G1 X19.000 Y16.000 Z-0.037
+G1 X20.000 Y16.000 Z-0.018
+G1 X21.000 Y16.000 Z-0.037
+G1 X22.000 Y16.000 Z-0.092
+G1 X23.000 Y16.000 Z-0.181
+G1 X24.000 Y16.000 Z-0.304
+G1 X25.000 Y16.000 Z-0.456
+G1 X26.000 Y16.000 Z-0.634
+G1 X27.000 Y16.000 Z-0.834
+G1 X28.000 Y16.000 Z-1.050
+G1 X29.000 Y16.000 Z-1.278
+G1 X30.000 Y16.000 Z-1.512
+G1 X31.000 Y16.000 Z-1.745
+G1 X32.000 Y16.000 Z-1.973
+G1 X33.000 Y16.000 Z-2.189
+G1 X34.000 Y16.000 Z-2.388
+G1 X35.000 Y16.000 Z-2.566
+G1 X36.000 Y16.000 Z-2.718
+G1 X37.000 Y16.000 Z-2.840
+G1 X38.000 Y16.000 Z-2.929
+G1 X39.000 Y16.000 Z-2.982
+G1 X40.000 Y16.000 Z-3.000
+G1 X40.000 Y18.000 Z-3.000
+G1 X39.000 Y18.000 Z-2.989
+G1 X38.000 Y18.000 Z-2.944
+G1 X37.000 Y18.000 Z-2.863
+G1 X36.000 Y18.000 Z-2.751
+G1 X35.000 Y18.000 Z-2.609
+G1 X34.000 Y18.000 Z-2.441
+G1 X33.000 Y18.000 Z-2.252
+G1 X32.000 Y18.000 Z-2.045
+G1 X31.000 Y18.000 Z-1.828
+G1 X30.000 Y18.000 Z-1.604
+G1 X29.000 Y18.000 Z-1.379
+G1 X28.000 Y18.000 Z-1.160
+G1 X27.000 Y18.000 Z-0.951
+G1 X26.000 Y18.000 Z-0.758
+G1 X25.000 Y18.000 Z-0.586
+G1 X24.000 Y18.000 Z-0.439
+G1 X23.000 Y18.000 Z-0.321
+G1 X22.000 Y18.000 Z-0.234
+G1 X21.000 Y18.000 Z-0.181
+G1 X20.000 Y18.000 Z-0.163
+G1 X19.000 Y18.000 Z-0.181
+G1 X18.000 Y18.000 Z-0.234
+G1 X17.000 Y18.000 Z-0.321
+G1 X16.000 Y18.000 Z-0.439
+G1 X15.000 Y18.000 Z-0.586
+G1 X14.000 Y18.000 Z-0.758
+G1 X13.000 Y18.000 Z-0.951
+G1 X12.000 Y18.000 Z-1.160
+G1 X11.000 Y18.000 Z-1.379
+G1 X10.000 Y18.000 Z-1.604
+G1 X9.000 Y18.000 Z-1.828
+G1 X8.000 Y18.000 Z-2.045
+G1 X7.000 Y18.000 Z-2.252
+G1 X6.000 Y18.000 Z-2.441
+G1 X5.000 Y18.000 Z-2.609
+G1 X4.000 Y18.000 Z-2.751
+G1 X3.000 Y18.000 Z-2.863
+G1 X2.000 Y18.000 Z-2.944
+G1 X1.000 Y18.000 Z-2.989
+G1 X0.000 Y18.000 Z-3.000
+G1 X0.000 Y20.000 Z-3.000
+G1 X1.000 Y20.000 Z-2.998
+G1 X2.000 Y20.000 Z-2.968
+G1 X3.000 Y20.000 Z-2.905
+G1 X4.000 Y20.000 Z-2.810
+G1 X5.000 Y20.000 Z-2.687
+G1 X6.000 Y20.000 Z-2.538
+G1 X7.000 Y20.000 Z-2.368
+G1 X8.000 Y20.000 Z-2.181
+G1 X9.000 Y20.000 Z-1.982
+G1 X10.000 Y20.000 Z-1.777
+G1 X11.000 Y20.000 Z-1.570
+G1 X12.000 Y20.000 Z-1.367
+G1 X13.000 Y20.000 Z-1.173
+G1 X14.000 Y20.000 Z-0.994
+G1 X15.000 Y20.000 Z-0.834
+G1 X16.000 Y20.000 Z-0.697
+G1 X17.000 Y20.000 Z-0.586
+G1 X18.000 Y20.000 Z-0.505
+G1 X19.000 Y20.000 Z-0.456
+G1 X20.000 Y20.000 Z-0.439
+G1 X21.000 Y20.000 Z-0.456
+G1 X22.000 Y20.000 Z-0.505
+G1 X23.000 Y20.000 Z-0.586
+G1 X24.000 Y20.000 Z-0.697
+G1 X25.000 Y20.000 Z-0.834
+G1 X26.000 Y20.000 Z-0.994
+G1 X27.000 Y20.000 Z-1.173
+G1 X28.000 Y20.000 Z-1.367
+G1 X29.000 Y20.000 Z-1.570
+G1 X30.000 Y20.000 Z-1.777
+G1 X31.000 Y20.000 Z-1.982
+G1 X32.000 Y20.000 Z-2.181
+G1 X33.000 Y20.000 Z-2.368
+G1 X34.000 Y20.000 Z-2.538
+G1 X35.000 Y20.000 Z-2.687
+G1 X36.000 Y20.000 Z-2.810
+G1 X37.000 Y20.000 Z-2.905
+G1 X38.000 Y20.000 Z-2.968
+G1 X39.000 Y20.000 Z-2.998
+G1 X40.000 Y20.000 Z-3.000
+G1 X40.000 Y22.000 Z-3.000
+G1 X39.000 Y22.000 Z-3.000
+G1 X38.000 Y22.000 Z-2.991
+G1 X37.000 Y22.000 Z-2.952
+G1 X36.000 Y22.000 Z-2.883
+G1 X35.000 Y22.000 Z-2.785
+G1 X34.000 Y22.000 Z-2.664
+G1 X33.000 Y22.000 Z-2.521
+G1 X32.000 Y22.000 Z-2.361
+G1 X31.000 Y22.000 Z-2.189
+G1 X30.000 Y22.000 Z-2.010
+G1 X29.000 Y22.000 Z-1.828
+G1 X28.000 Y22.000 Z-1.648
+G1 X27.000 Y22.000 Z-1.476
+G1 X26.000 Y22.000 Z-1.317
+G1 X25.000 Y22.000 Z-1.173
+G1 X24.000 Y22.000 Z-1.050
+G1 X23.000 Y22.000 Z-0.951
+G1 X22.000 Y22.000 Z-0.878
+G1 X21.000 Y22.000 Z-0.834
+G1 X20.000 Y22.000 Z-0.819
+G1 X19.000 Y22.000 Z-0.834
+G1 X18.000 Y22.000 Z-0.878
+G1 X17.000 Y22.000 Z-0.951
+G1 X16.000 Y22.000 Z-1.050
+G1 X15.000 Y22.000 Z-1.173
+G1 X14.000 Y22.000 Z-1.317
+G1 X13.000 Y22.000 Z-1.476
+G1 X12.000 Y22.000 Z-1.648
+G1 X11.000 Y22.000 Z-1.828
+G1 X10.000 Y22.000 Z-2.010
+G1 X9.000 Y22.000 Z-2.189
+G1 X8.000 Y22.000 Z-2.361
+G1 X7.000 Y22.000 Z-2.521
+G1 X6.000 Y22.000 Z-2.664
+G1 X5.000 Y22.000 Z-2.785
+G1 X4.000 Y22.000 Z-2.883
+G1 X3.000 Y22.000 Z-2.952
+G1 X2.000 Y22.000 Z-2.991
+G1 X1.000 Y22.000 Z-3.000
+G1 X0.000 Y22.000 Z-3.000
+G1 X0.000 Y24.000 Z-3.000
+G1 X1.000 Y24.000 Z-3.000
+G1 X2.000 Y24.000 Z-3.000
+G1 X3.000 Y24.000 Z-2.989
+G1 X4.000 Y24.000 Z-2.950
+G1 X5.000 Y24.000 Z-2.885
+G1 X6.000 Y24.000 Z-2.796
+G1 X7.000 Y24.000 Z-2.687
+G1 X8.000 Y24.000 Z-2.561
+G1 X9.000 Y24.000 Z-2.422
+G1 X10.000 Y24.000 Z-2.274
+G1 X11.000 Y24.000 Z-2.123
+G1 X12.000 Y24.000 Z-1.973
+G1 X13.000 Y24.000 Z-1.828
+G1 X14.000 Y24.000 Z-1.692
+G1 X15.000 Y24.000 Z-1.570
+G1 X16.000 Y24.000 Z-1.464
+G1 X17.000 Y24.000 Z-1.379
+G1 X18.000 Y24.000 Z-1.317
+G1 X19.000 Y24.000 Z-1.278
+G1 X20.000 Y24.000 Z-1.265
+G1 X21.000 Y24.000 Z-1.278
+G1 X22.000 Y24.000 Z-1.317
+G1 X23.000 Y24.000 Z-1.379
+G1 X24.000 Y24.000 Z-1.464
+G1 X25.000 Y24.000 Z-1.570
+G1 X26.000 Y24.000 Z-1.692
+G1 X27.000 Y24.000 Z-1.828
+G1 X28.000 Y24.000 Z-1.973
+G1 X29.000 Y24.000 Z-2.123
+G1 X30.000 Y24.000 Z-2.274
+G1 X31.000 Y24.000 Z-2.422
+G1 X32.000 Y24.000 Z-2.561
+G1 X33.000 Y24.000 Z-2.687
+G1 X34.000 Y24.000 Z-2.796
+G1 X35.000 Y24.000 Z-2.885
+G1 X36.000 Y24.000 Z-2.950
+G1 X37.000 Y24.000 Z-2.989
+G1 X38.000 Y24.000 Z-3.000
+G1 X39.000 Y24.000 Z-3.000
+G1 X40.000 Y24.000 Z-3.000
+G1 X40.000 Y26.000 Z-3.000
+G1 X39.000 Y26.000 Z-3.000
+G1 X38.000 Y26.000 Z-3.000
+G1 X37.000 Y26.000 Z-3.000
+G1 X36.000 Y26.000 Z-2.994
+G1 X35.000 Y26.000 Z-2.964
+G1 X34.000 Y26.000 Z-2.912
+G1 X33.000 Y26.000 Z-2.840
+G1 X32.000 Y26.000 Z-2.751
+G1 X31.000 Y26.000 Z-2.649
+G1 X30.000 Y26.000 Z-2.538
+G1 X29.000 Y26.000 Z-2.422
+G1 X28.000 Y26.000 Z-2.304
+G1 X27.000 Y26.000 Z-2.189
+G1 X26.000 Y26.000 Z-2.081
+G1 X25.000 Y26.000 Z-1.982
+G1 X24.000 Y26.000 Z-1.897
+G1 X23.000 Y26.000 Z-1.828
+G1 X22.000 Y26.000 Z-1.777
+G1 X21.000 Y26.000 Z-1.745
+G1 X20.000 Y26.000 Z-1.735
+G1 X19.000 Y26.000 Z-1.745
+G1 X18.000 Y26.000 Z-1.777
+G1 X17.000 Y26.000 Z-1.828
+G1 X16.000 Y26.000 Z-1.897
+G1 X15.000 Y26.000 Z-1.982
+G1 X14.000 Y26.000 Z-2.081
+G1 X13.000 Y26.000 Z-2.189
+G1 X12.000 Y26.000 Z-2.304
+G1 X11.000 Y26.000 Z-2.422
+G1 X10.000 Y26.000 Z-2.538
+G1 X9.000 Y26.000 Z-2.649
+G1 X8.000 Y26.000 Z-2.751
+G1 X7.000 Y26.000 Z-2.840
+G1 X6.000 Y26.000 Z-2.912
+G1 X5.000 Y26.000 Z-2.964
+G1 X4.000 Y26.000 Z-2.994
+G1 X3.000 Y26.000 Z-3.000
+G1 X2.000 Y26.000 Z-3.000
+G1 X1.000 Y26.000 Z-3.000
+G1 X0.000 Y26.000 Z-3.000
+G1 X0.000 Y28.000 Z-3.000
+G1 X1.000 Y28.000 Z-3.000
+G1 X2.000 Y28.000 Z-3.000
+G1 X3.000 Y28.000 Z-3.000
+G1 X4.000 Y28.000 Z-3.000
+G1 X5.000 Y28.000 Z-3.000
+G1 X6.000 Y28.000 Z-2.985
+G1 X7.000 Y28.000 Z-2.952
+G1 X8.000 Y28.000 Z-2.902
+G1 X9.000 Y28.000 Z-2.840
+G1 X10.000 Y28.000 Z-2.767
+G1 X11.000 Y28.000 Z-2.687
+G1 X12.000 Y28.000 Z-2.604
+G1 X13.000 Y28.000 Z-2.521
+G1 X14.000 Y28.000 Z-2.441
+G1 X15.000 Y28.000 Z-2.368
+G1 X16.000 Y28.000 Z-2.304
+G1 X17.000 Y28.000 Z-2.252
+G1 X18.000 Y28.000 Z-2.213
+G1 X19.000 Y28.000 Z-2.189
+G1 X20.000 Y28.000 Z-2.181
+G1 X21.000 Y28.000 Z-2.189
+G1 X22.000 Y28.000 Z-2.213
+G1 X23.000 Y28.000 Z-2.252
+G1 X24.000 Y28.000 Z-2.304
+G1 X25.000 Y28.000 Z-2.368
+G1 X26.000 Y28.000 Z-2.441
+G1 X27.000 Y28.000 Z-2.521
+G1 X28.000 Y28.000 Z-2.604
+G1 X29.000 Y28.000 Z-2.687
+G1 X30.000 Y28.000 Z-2.767
+G1 X31.000 Y28.000 Z-2.840
+G1 X32.000 Y28.000 Z-2.902
+G1 X33.000 Y28.000 Z-2.952
+G1 X34.000 Y28.000 Z-2.985
+G1 X35.000 Y28.000 Z-3.000
+G1 X36.000 Y28.000 Z-3.000
+G1 X37.000 Y28.000 Z-3.000
+G1 X38.000 Y28.000 Z-3.000
+G1 X39.000 Y28.000 Z-3.000
+G1 X40.000 Y28.000 Z-3.000
+G1 X40.000 Y30.000 Z-3.000
+G1 X39.000 Y30.000 Z-3.000
+G1 X38.000 Y30.000 Z-3.000
+G1 X37.000 Y30.000 Z-3.000
+G1 X36.000 Y30.000 Z-3.000
+G1 X35.000 Y30.000 Z-3.000
+G1 X34.000 Y30.000 Z-3.000
+G1 X33.000 Y30.000 Z-3.000
+G1 X32.000 Y30.000 Z-2.988
+G1 X31.000 Y30.000 Z-2.964
+G1 X30.000 Y30.000 Z-2.929
+G1 X29.000 Y30.000 Z-2.885
+G1 X28.000 Y30.000 Z-2.837
+G1 X27.000 Y30.000 Z-2.785
+G1 X26.000 Y30.000 Z-2.735
+G1 X25.000 Y30.000 Z-2.687
+G1 X24.000 Y30.000 Z-2.644
+G1 X23.000 Y30.000 Z-2.609
+G1 X22.000 Y30.000 Z-2.583
+G1 X21.000 Y30.000 Z-2.566
+G1 X20.000 Y30.000 Z-2.561
+G1 X19.000 Y30.000 Z-2.566
+G1 X18.000 Y30.000 Z-2.583
+G1 X17.000 Y30.000 Z-2.609
+G1 X16.000 Y30.000 Z-2.644
+G1 X15.000 Y30.000 Z-2.687
+G1 X14.000 Y30.000 Z-2.735
+G1 X13.000 Y30.000 Z-2.785
+G1 X12.000 Y30.000 Z-2.837
+G1 X11.000 Y30.000 Z-2.885
+G1 X10.000 Y30.000 Z-2.929
+G1 X9.000 Y30.000 Z-2.964
+G1 X8.000 Y30.000 Z-2.988
+G1 X7.000 Y30.000 Z-3.000
+G1 X6.000 Y30.000 Z-3.000
+G1 X5.000 Y30.000 Z-3.000
+G1 X4.000 Y30.000 Z-3.000
+G1 X3.000 Y30.000 Z-3.000
+G1 X2.000 Y30.000 Z-3.000
+G1 X1.000 Y30.000 Z-3.000
+G1 X0.000 Y30.000 Z-3.000
+G0 Z5
+G0 X5 Y5
+G1 Z-2 F600
+F2400
+G1 X5.000 Y5.000
+G1 X35.000 Y5.000
+G1 X35.000 Y25.000
+G1 X5.000 Y25.000
+G1 X5.000 Y5.000
+G1 X6.500 Y6.500 Z-2.200
+G1 X6.500 Y6.500
+G1 X33.500 Y6.500
+G1 X33.500 Y23.500
+G1 X6.500 Y23.500
+G1 X6.500 Y6.500
+G1 X8.000 Y8.000 Z-2.400
+G1 X8.000 Y8.000
+G1 X32.000 Y8.000
+G1 X32.000 Y22.000
+G1 X8.000 Y22.000
+G1 X8.000 Y8.000
+G1 X9.500 Y9.500 Z-2.600
+G1 X9.500 Y9.500
+G1 X30.500 Y9.500
+G1 X30.500 Y20.500
+G1 X9.500 Y20.500
+G1 X9.500 Y9.500
+G1 X11.000 Y11.000 Z-2.800
+; ramp into a small pocket round its outline at 5 degrees, then clear it at full depth
+G0 Z1
+G0 X10 Y10
+G1 Z0 F600
+F2400
+G1 X14.000 Y10.000 Z-0.350
+G1 X14.000 Y14.000 Z-0.700
+G1 X10.000 Y14.000 Z-1.050
+G1 X10.000 Y10.000 Z-1.400
+G1 X14.000 Y10.000 Z-1.750
+G1 X14.000 Y14.000 Z-2.100
+G1 X10.000 Y14.000 Z-2.450
+G1 X10.000 Y10.000 Z-2.800
+G1 X14.000 Y10.000 Z-3.150
+G1 X14.000 Y14.000 Z-3.500
+G1 X10.000 Y14.000 Z-3.850
+G1 X10.000 Y10.000 Z-4.199
+G1 X14.000 Y10.000 Z-4.549
+G1 X14.000 Y14.000 Z-4.899
+G1 X10.000 Y14.000 Z-5.249
+G1 X10.000 Y10.000 Z-5.599
+G1 X14.000 Y10.000 Z-5.949
+G1 X14.000 Y14.000 Z-6.299
+G1 X10.000 Y14.000 Z-6.649
+G1 X10.000 Y10.000 Z-6.999
+G1 X14.000 Y10.000 Z-7.349
+G1 X14.000 Y14.000 Z-7.699
+G1 X10.000 Y14.000 Z-8.000
+G1 X10.000 Y10.000 Z-8.000
+G1 X13.500 Y10.500
+G1 X13.500 Y13.500
+G1 X10.500 Y13.500
+G1 X10.500 Y10.500
+G1 X13.000 Y11.000
+G1 X13.000 Y13.000
+G1 X11.000 Y13.000
+G1 X11.000 Y11.000
+G1 X12.500 Y11.500
+G1 X12.500 Y12.500
+G1 X11.500 Y12.500
+G1 X11.500 Y11.500
+G0 Z5
+G0 X0 Y0
@@ -0,0 +1,6 @@
+; long fast moves, 500mm/s is 200k steps/s at 400 steps/mm
+G21
+G90
+G1 X200 Y0 F30000
+G1 X0 Y200
+G1 X0 Y0
@@ -0,0 +1,18 @@
+; straight moves with direction reversals and short segments
+G21
+G90
+G1 X10 Y0 F3000
+G1 X10 Y10
+G1 X0 Y10
+G1 X0 Y0
+G0 X50 Y30 Z2
+G1 X50.1 Y30.1 F600
+G1 X50.2 Y30.1
+G1 X50.3 Y30.3
+X50.4 Y30.2
+X-20 Y-20 Z0 F6000
+G91
+G1 X5 Y5
+G1 X-5 Y-5
+G90
+G0 X0 Y0 Z0
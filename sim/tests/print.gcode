@@ -0,0 +1,304 @@
+; small print, a 160mm skirt circle as slicer chords, a centre square with diagonal infill
+; and travels out to the edge, for comparing delta segmentation
+G21
+G90
+G0 X80 Y0 Z0.3 F9000
+G1 X79.901 Y3.988 F3000
+G1 X79.602 Y7.965 F3000
+G1 X79.106 Y11.923 F3000
+G1 X78.414 Y15.852 F3000
+G1 X77.526 Y19.741 F3000
+G1 X76.446 Y23.580 F3000
+G1 X75.175 Y27.362 F3000
+G1 X73.718 Y31.075 F3000
+G1 X72.078 Y34.711 F3000
+G1 X70.258 Y38.260 F3000
+G1 X68.263 Y41.715 F3000
+G1 X66.099 Y45.066 F3000
+G1 X63.771 Y48.304 F3000
+G1 X61.284 Y51.423 F3000
+G1 X58.644 Y54.414 F3000
+G1 X55.859 Y57.269 F3000
+G1 X52.935 Y59.982 F3000
+G1 X49.879 Y62.547 F3000
+G1 X46.699 Y64.955 F3000
+G1 X43.404 Y67.202 F3000
+G1 X40.000 Y69.282 F3000
+G1 X36.497 Y71.190 F3000
+G1 X32.903 Y72.920 F3000
+G1 X29.227 Y74.470 F3000
+G1 X25.479 Y75.834 F3000
+G1 X21.667 Y77.010 F3000
+G1 X17.802 Y77.994 F3000
+G1 X13.892 Y78.785 F3000
+G1 X9.947 Y79.379 F3000
+G1 X5.978 Y79.776 F3000
+G1 X1.994 Y79.975 F3000
+G1 X-1.994 Y79.975 F3000
+G1 X-5.978 Y79.776 F3000
+G1 X-9.947 Y79.379 F3000
+G1 X-13.892 Y78.785 F3000
+G1 X-17.802 Y77.994 F3000
+G1 X-21.667 Y77.010 F3000
+G1 X-25.479 Y75.834 F3000
+G1 X-29.227 Y74.470 F3000
+G1 X-32.903 Y72.920 F3000
+G1 X-36.497 Y71.190 F3000
+G1 X-40.000 Y69.282 F3000
+G1 X-43.404 Y67.202 F3000
+G1 X-46.699 Y64.955 F3000
+G1 X-49.879 Y62.547 F3000
+G1 X-52.935 Y59.982 F3000
+G1 X-55.859 Y57.269 F3000
+G1 X-58.644 Y54.414 F3000
+G1 X-61.284 Y51.423 F3000
+G1 X-63.771 Y48.304 F3000
+G1 X-66.099 Y45.066 F3000
+G1 X-68.263 Y41.715 F3000
+G1 X-70.258 Y38.260 F3000
+G1 X-72.078 Y34.711 F3000
+G1 X-73.718 Y31.075 F3000
+G1 X-75.175 Y27.362 F3000
+G1 X-76.446 Y23.580 F3000
+G1 X-77.526 Y19.741 F3000
+G1 X-78.414 Y15.852 F3000
+G1 X-79.106 Y11.923 F3000
+G1 X-79.602 Y7.965 F3000
+G1 X-79.901 Y3.988 F3000
+G1 X-80.000 Y0.000 F3000
+G1 X-79.901 Y-3.988 F3000
+G1 X-79.602 Y-7.965 F3000
+G1 X-79.106 Y-11.923 F3000
+G1 X-78.414 Y-15.852 F3000
+G1 X-77.526 Y-19.741 F3000
+G1 X-76.446 Y-23.580 F3000
+G1 X-75.175 Y-27.362 F3000
+G1 X-73.718 Y-31.075 F3000
+G1 X-72.078 Y-34.711 F3000
+G1 X-70.258 Y-38.260 F3000
+G1 X-68.263 Y-41.715 F3000
+G1 X-66.099 Y-45.066 F3000
+G1 X-63.771 Y-48.304 F3000
+G1 X-61.284 Y-51.423 F3000
+G1 X-58.644 Y-54.414 F3000
+G1 X-55.859 Y-57.269 F3000
+G1 X-52.935 Y-59.982 F3000
+G1 X-49.879 Y-62.547 F3000
+G1 X-46.699 Y-64.955 F3000
+G1 X-43.404 Y-67.202 F3000
+G1 X-40.000 Y-69.282 F3000
+G1 X-36.497 Y-71.190 F3000
+G1 X-32.903 Y-72.920 F3000
+G1 X-29.227 Y-74.470 F3000
+G1 X-25.479 Y-75.834 F3000
+G1 X-21.667 Y-77.010 F3000
+G1 X-17.802 Y-77.994 F3000
+G1 X-13.892 Y-78.785 F3000
+G1 X-9.947 Y-79.379 F3000
+G1 X-5.978 Y-79.776 F3000
+G1 X-1.994 Y-79.975 F3000
+G1 X1.994 Y-79.975 F3000
+G1 X5.978 Y-79.776 F3000
+G1 X9.947 Y-79.379 F3000
+G1 X13.892 Y-78.785 F3000
+G1 X17.802 Y-77.994 F3000
+G1 X21.667 Y-77.010 F3000
+G1 X25.479 Y-75.834 F3000
+G1 X29.227 Y-74.470 F3000
+G1 X32.903 Y-72.920 F3000
+G1 X36.497 Y-71.190 F3000
+G1 X40.000 Y-69.282 F3000
+G1 X43.404 Y-67.202 F3000
+G1 X46.699 Y-64.955 F3000
+G1 X49.879 Y-62.547 F3000
+G1 X52.935 Y-59.982 F3000
+G1 X55.859 Y-57.269 F3000
+G1 X58.644 Y-54.414 F3000
+G1 X61.284 Y-51.423 F3000
+G1 X63.771 Y-48.304 F3000
+G1 X66.099 Y-45.066 F3000
+G1 X68.263 Y-41.715 F3000
+G1 X70.258 Y-38.260 F3000
+G1 X72.078 Y-34.711 F3000
+G1 X73.718 Y-31.075 F3000
+G1 X75.175 Y-27.362 F3000
+G1 X76.446 Y-23.580 F3000
+G1 X77.526 Y-19.741 F3000
+G1 X78.414 Y-15.852 F3000
+G1 X79.106 Y-11.923 F3000
+G1 X79.602 Y-7.965 F3000
+G1 X79.901 Y-3.988 F3000
+G1 X80.000 Y-0.000 F3000
+G0 X-15 Y-15 F9000
+G1 X15 Y-15 F2400
+G1 X15 Y15
+G1 X-15 Y15
+G1 X-15 Y-15
+G1 X-10 Y-15
+G1 X-15 Y-5
+G1 X0 Y-15
+G1 X-15 Y5
+G1 X10 Y-15
+G1 X-12 Y-12
+G1 X12 Y-12
+G1 X12 Y-7
+G1 X-12 Y-7
+G1 X-12 Y-2
+G1 X12 Y-2
+G1 X12 Y3
+G1 X-12 Y3
+G1 X-12 Y8
+G1 X12 Y8
+G1 X12 Y13
+G1 X-12 Y13
+G0 X-70 Y40 F9000
+G1 X70 Y40 F3000
+G0 X0 Y-90
+G0 X80 Y0 Z0.6 F9000
+G1 X79.901 Y3.988 F3000
+G1 X79.602 Y7.965 F3000
+G1 X79.106 Y11.923 F3000
+G1 X78.414 Y15.852 F3000
+G1 X77.526 Y19.741 F3000
+G1 X76.446 Y23.580 F3000
+G1 X75.175 Y27.362 F3000
+G1 X73.718 Y31.075 F3000
+G1 X72.078 Y34.711 F3000
+G1 X70.258 Y38.260 F3000
+G1 X68.263 Y41.715 F3000
+G1 X66.099 Y45.066 F3000
+G1 X63.771 Y48.304 F3000
+G1 X61.284 Y51.423 F3000
+G1 X58.644 Y54.414 F3000
+G1 X55.859 Y57.269 F3000
+G1 X52.935 Y59.982 F3000
+G1 X49.879 Y62.547 F3000
+G1 X46.699 Y64.955 F3000
+G1 X43.404 Y67.202 F3000
+G1 X40.000 Y69.282 F3000
+G1 X36.497 Y71.190 F3000
+G1 X32.903 Y72.920 F3000
+G1 X29.227 Y74.470 F3000
+G1 X25.479 Y75.834 F3000
+G1 X21.667 Y77.010 F3000
+G1 X17.802 Y77.994 F3000
+G1 X13.892 Y78.785 F3000
+G1 X9.947 Y79.379 F3000
+G1 X5.978 Y79.776 F3000
+G1 X1.994 Y79.975 F3000
+G1 X-1.994 Y79.975 F3000
+G1 X-5.978 Y79.776 F3000
+G1 X-9.947 Y79.379 F3000
+G1 X-13.892 Y78.785 F3000
+G1 X-17.802 Y77.994 F3000
+G1 X-21.667 Y77.010 F3000
+G1 X-25.479 Y75.834 F3000
+G1 X-29.227 Y74.470 F3000
+G1 X-32.903 Y72.920 F3000
+G1 X-36.497 Y71.190 F3000
+G1 X-40.000 Y69.282 F3000
+G1 X-43.404 Y67.202 F3000
+G1 X-46.699 Y64.955 F3000
+G1 X-49.879 Y62.547 F3000
+G1 X-52.935 Y59.982 F3000
+G1 X-55.859 Y57.269 F3000
+G1 X-58.644 Y54.414 F3000
+G1 X-61.284 Y51.423 F3000
+G1 X-63.771 Y48.304 F3000
+G1 X-66.099 Y45.066 F3000
+G1 X-68.263 Y41.715 F3000
+G1 X-70.258 Y38.260 F3000
+G1 X-72.078 Y34.711 F3000
+G1 X-73.718 Y31.075 F3000
+G1 X-75.175 Y27.362 F3000
+G1 X-76.446 Y23.580 F3000
+G1 X-77.526 Y19.741 F3000
+G1 X-78.414 Y15.852 F3000
+G1 X-79.106 Y11.923 F3000
+G1 X-79.602 Y7.965 F3000
+G1 X-79.901 Y3.988 F3000
+G1 X-80.000 Y0.000 F3000
+G1 X-79.901 Y-3.988 F3000
+G1 X-79.602 Y-7.965 F3000
+G1 X-79.106 Y-11.923 F3000
+G1 X-78.414 Y-15.852 F3000
+G1 X-77.526 Y-19.741 F3000
+G1 X-76.446 Y-23.580 F3000
+G1 X-75.175 Y-27.362 F3000
+G1 X-73.718 Y-31.075 F3000
+G1 X-72.078 Y-34.711 F3000
+G1 X-70.258 Y-38.260 F3000
+G1 X-68.263 Y-41.715 F3000
+G1 X-66.099 Y-45.066 F3000
+G1 X-63.771 Y-48.304 F3000
+G1 X-61.284 Y-51.423 F3000
+G1 X-58.644 Y-54.414 F3000
+G1 X-55.859 Y-57.269 F3000
+G1 X-52.935 Y-59.982 F3000
+G1 X-49.879 Y-62.547 F3000
+G1 X-46.699 Y-64.955 F3000
+G1 X-43.404 Y-67.202 F3000
+G1 X-40.000 Y-69.282 F3000
+G1 X-36.497 Y-71.190 F3000
+G1 X-32.903 Y-72.920 F3000
+G1 X-29.227 Y-74.470 F3000
+G1 X-25.479 Y-75.834 F3000
+G1 X-21.667 Y-77.010 F3000
+G1 X-17.802 Y-77.994 F3000
+G1 X-13.892 Y-78.785 F3000
+G1 X-9.947 Y-79.379 F3000
+G1 X-5.978 Y-79.776 F3000
+G1 X-1.994 Y-79.975 F3000
+G1 X1.994 Y-79.975 F3000
+G1 X5.978 Y-79.776 F3000
+G1 X9.947 Y-79.379 F3000
+G1 X13.892 Y-78.785 F3000
+G1 X17.802 Y-77.994 F3000
+G1 X21.667 Y-77.010 F3000
+G1 X25.479 Y-75.834 F3000
+G1 X29.227 Y-74.470 F3000
+G1 X32.903 Y-72.920 F3000
+G1 X36.497 Y-71.190 F3000
+G1 X40.000 Y-69.282 F3000
+G1 X43.404 Y-67.202 F3000
+G1 X46.699 Y-64.955 F3000
+G1 X49.879 Y-62.547 F3000
+G1 X52.935 Y-59.982 F3000
+G1 X55.859 Y-57.269 F3000
+G1 X58.644 Y-54.414 F3000
+G1 X61.284 Y-51.423 F3000
+G1 X63.771 Y-48.304 F3000
+G1 X66.099 Y-45.066 F3000
+G1 X68.263 Y-41.715 F3000
+G1 X70.258 Y-38.260 F3000
+G1 X72.078 Y-34.711 F3000
+G1 X73.718 Y-31.075 F3000
+G1 X75.175 Y-27.362 F3000
+G1 X76.446 Y-23.580 F3000
+G1 X77.526 Y-19.741 F3000
+G1 X78.414 Y-15.852 F3000
+G1 X79.106 Y-11.923 F3000
+G1 X79.602 Y-7.965 F3000
+G1 X79.901 Y-3.988 F3000
+G1 X80.000 Y-0.000 F3000
+G0 X-15 Y-15 F9000
+G1 X15 Y-15 F2400
+G1 X15 Y15
+G1 X-15 Y15
+G1 X-15 Y-15
+G1 X-12 Y-12
+G1 X12 Y-12
+G1 X12 Y-7
+G1 X-12 Y-7
+G1 X-12 Y-2
+G1 X12 Y-2
+G1 X12 Y3
+G1 X-12 Y3
+G1 X-12 Y8
+G1 X12 Y8
+G1 X12 Y13
+G1 X-12 Y13
+G0 X-70 Y40 F9000
+G1 X70 Y40 F3000
+G0 X0 Y-90
+G0 X0 Y0 Z5
@@ -0,0 +1,1625 @@
+; raster engraving at 300mm/s, each scan line is a row of 0.5mm pixels at different powers
+G21 G90
+G0 X0 Y0
+G1 F18000
+G0 X0.000 Y0.000
+G1 X0.500 S0.671
+G1 X1.000 S0.822
+G1 X1.500 S0.934
+G1 X2.000 S0.993
+G1 X2.500 S0.992
+G1 X3.000 S0.932
+G1 X3.500 S0.819
+G1 X4.000 S0.667
+G1 X4.500 S0.496
+G1 X5.000 S0.325
+G1 X5.500 S0.175
+G1 X6.000 S0.064
+G1 X6.500 S0.007
+G1 X7.000 S0.009
+G1 X7.500 S0.071
+G1 X8.000 S0.184
+G1 X8.500 S0.336
+G1 X9.000 S0.508
+G1 X9.500 S0.679
+G1 X10.000 S0.828
+G1 X10.500 S0.938
+G1 X11.000 S0.994
+G1 X11.500 S0.990
+G1 X12.000 S0.927
+G1 X12.500 S0.812
+G1 X13.000 S0.660
+G1 X13.500 S0.487
+G1 X14.000 S0.317
+G1 X14.500 S0.168
+G1 X15.000 S0.060
+G1 X15.500 S0.005
+G1 X16.000 S0.010
+G1 X16.500 S0.075
+G1 X17.000 S0.191
+G1 X17.500 S0.344
+G1 X18.000 S0.517
+G1 X18.500 S0.687
+G1 X19.000 S0.835
+G1 X19.500 S0.942
+G1 X20.000 S0.995
+G1 X20.500 S0.989
+G1 X21.000 S0.923
+G1 X21.500 S0.806
+G1 X22.000 S0.652
+G1 X22.500 S0.479
+G1 X23.000 S0.309
+G1 X23.500 S0.162
+G1 X24.000 S0.056
+G1 X24.500 S0.004
+G1 X25.000 S0.012
+G1 X25.500 S0.079
+G1 X26.000 S0.198
+G1 X26.500 S0.352
+G1 X27.000 S0.525
+G1 X27.500 S0.695
+G1 X28.000 S0.841
+G1 X28.500 S0.946
+G1 X29.000 S0.996
+G1 X29.500 S0.987
+G1 X30.000 S0.918
+G1 X30.500 S0.799
+G1 X31.000 S0.644
+G1 X31.500 S0.471
+G1 X32.000 S0.301
+G1 X32.500 S0.156
+G1 X33.000 S0.052
+G1 X33.500 S0.003
+G1 X34.000 S0.014
+G1 X34.500 S0.084
+G1 X35.000 S0.204
+G1 X35.500 S0.361
+G1 X36.000 S0.534
+G1 X36.500 S0.703
+G1 X37.000 S0.847
+G1 X37.500 S0.949
+G1 X38.000 S0.997
+G1 X38.500 S0.985
+G1 X39.000 S0.914
+G1 X39.500 S0.792
+G1 X40.000 S0.635
+G0 X40.000 Y0.200
+G1 X39.500 S0.462
+G1 X39.000 S0.635
+G1 X38.500 S0.792
+G1 X38.000 S0.914
+G1 X37.500 S0.985
+G1 X37.000 S0.997
+G1 X36.500 S0.949
+G1 X36.000 S0.847
+G1 X35.500 S0.703
+G1 X35.000 S0.534
+G1 X34.500 S0.361
+G1 X34.000 S0.204
+G1 X33.500 S0.084
+G1 X33.000 S0.014
+G1 X32.500 S0.003
+G1 X32.000 S0.052
+G1 X31.500 S0.156
+G1 X31.000 S0.301
+G1 X30.500 S0.471
+G1 X30.000 S0.644
+G1 X29.500 S0.799
+G1 X29.000 S0.918
+G1 X28.500 S0.987
+G1 X28.000 S0.996
+G1 X27.500 S0.946
+G1 X27.000 S0.841
+G1 X26.500 S0.695
+G1 X26.000 S0.525
+G1 X25.500 S0.352
+G1 X25.000 S0.198
+G1 X24.500 S0.079
+G1 X24.000 S0.012
+G1 X23.500 S0.004
+G1 X23.000 S0.056
+G1 X22.500 S0.162
+G1 X22.000 S0.309
+G1 X21.500 S0.479
+G1 X21.000 S0.652
+G1 X20.500 S0.806
+G1 X20.000 S0.923
+G1 X19.500 S0.989
+G1 X19.000 S0.995
+G1 X18.500 S0.942
+G1 X18.000 S0.835
+G1 X17.500 S0.687
+G1 X17.000 S0.517
+G1 X16.500 S0.344
+G1 X16.000 S0.191
+G1 X15.500 S0.075
+G1 X15.000 S0.010
+G1 X14.500 S0.005
+G1 X14.000 S0.060
+G1 X13.500 S0.168
+G1 X13.000 S0.317
+G1 X12.500 S0.487
+G1 X12.000 S0.660
+G1 X11.500 S0.812
+G1 X11.000 S0.927
+G1 X10.500 S0.990
+G1 X10.000 S0.994
+G1 X9.500 S0.938
+G1 X9.000 S0.828
+G1 X8.500 S0.679
+G1 X8.000 S0.508
+G1 X7.500 S0.336
+G1 X7.000 S0.184
+G1 X6.500 S0.071
+G1 X6.000 S0.009
+G1 X5.500 S0.007
+G1 X5.000 S0.064
+G1 X4.500 S0.175
+G1 X4.000 S0.325
+G1 X3.500 S0.496
+G1 X3.000 S0.667
+G1 X2.500 S0.819
+G1 X2.000 S0.932
+G1 X1.500 S0.992
+G1 X1.000 S0.993
+G1 X0.500 S0.934
+G1 X0.000 S0.822
+G0 X0.000 Y0.400
+G1 X0.500 S0.992
+G1 X1.000 S0.932
+G1 X1.500 S0.819
+G1 X2.000 S0.667
+G1 X2.500 S0.496
+G1 X3.000 S0.325
+G1 X3.500 S0.175
+G1 X4.000 S0.064
+G1 X4.500 S0.007
+G1 X5.000 S0.009
+G1 X5.500 S0.071
+G1 X6.000 S0.184
+G1 X6.500 S0.336
+G1 X7.000 S0.508
+G1 X7.500 S0.679
+G1 X8.000 S0.828
+G1 X8.500 S0.938
+G1 X9.000 S0.994
+G1 X9.500 S0.990
+G1 X10.000 S0.927
+G1 X10.500 S0.812
+G1 X11.000 S0.660
+G1 X11.500 S0.487
+G1 X12.000 S0.317
+G1 X12.500 S0.168
+G1 X13.000 S0.060
+G1 X13.500 S0.005
+G1 X14.000 S0.010
+G1 X14.500 S0.075
+G1 X15.000 S0.191
+G1 X15.500 S0.344
+G1 X16.000 S0.517
+G1 X16.500 S0.687
+G1 X17.000 S0.835
+G1 X17.500 S0.942
+G1 X18.000 S0.995
+G1 X18.500 S0.989
+G1 X19.000 S0.923
+G1 X19.500 S0.806
+G1 X20.000 S0.652
+G1 X20.500 S0.479
+G1 X21.000 S0.309
+G1 X21.500 S0.162
+G1 X22.000 S0.056
+G1 X22.500 S0.004
+G1 X23.000 S0.012
+G1 X23.500 S0.079
+G1 X24.000 S0.198
+G1 X24.500 S0.352
+G1 X25.000 S0.525
+G1 X25.500 S0.695
+G1 X26.000 S0.841
+G1 X26.500 S0.946
+G1 X27.000 S0.996
+G1 X27.500 S0.987
+G1 X28.000 S0.918
+G1 X28.500 S0.799
+G1 X29.000 S0.644
+G1 X29.500 S0.471
+G1 X30.000 S0.301
+G1 X30.500 S0.156
+G1 X31.000 S0.052
+G1 X31.500 S0.003
+G1 X32.000 S0.014
+G1 X32.500 S0.084
+G1 X33.000 S0.204
+G1 X33.500 S0.361
+G1 X34.000 S0.534
+G1 X34.500 S0.703
+G1 X35.000 S0.847
+G1 X35.500 S0.949
+G1 X36.000 S0.997
+G1 X36.500 S0.985
+G1 X37.000 S0.914
+G1 X37.500 S0.792
+G1 X38.000 S0.635
+G1 X38.500 S0.462
+G1 X39.000 S0.294
+G1 X39.500 S0.150
+G1 X40.000 S0.049
+G0 X40.000 Y0.600
+G1 X39.500 S0.002
+G1 X39.000 S0.049
+G1 X38.500 S0.150
+G1 X38.000 S0.294
+G1 X37.500 S0.462
+G1 X37.000 S0.635
+G1 X36.500 S0.792
+G1 X36.000 S0.914
+G1 X35.500 S0.985
+G1 X35.000 S0.997
+G1 X34.500 S0.949
+G1 X34.000 S0.847
+G1 X33.500 S0.703
+G1 X33.000 S0.534
+G1 X32.500 S0.361
+G1 X32.000 S0.204
+G1 X31.500 S0.084
+G1 X31.000 S0.014
+G1 X30.500 S0.003
+G1 X30.000 S0.052
+G1 X29.500 S0.156
+G1 X29.000 S0.301
+G1 X28.500 S0.471
+G1 X28.000 S0.644
+G1 X27.500 S0.799
+G1 X27.000 S0.918
+G1 X26.500 S0.987
+G1 X26.000 S0.996
+G1 X25.500 S0.946
+G1 X25.000 S0.841
+G1 X24.500 S0.695
+G1 X24.000 S0.525
+G1 X23.500 S0.352
+G1 X23.000 S0.198
+G1 X22.500 S0.079
+G1 X22.000 S0.012
+G1 X21.500 S0.004
+G1 X21.000 S0.056
+G1 X20.500 S0.162
+G1 X20.000 S0.309
+G1 X19.500 S0.479
+G1 X19.000 S0.652
+G1 X18.500 S0.806
+G1 X18.000 S0.923
+G1 X17.500 S0.989
+G1 X17.000 S0.995
+G1 X16.500 S0.942
+G1 X16.000 S0.835
+G1 X15.500 S0.687
+G1 X15.000 S0.517
+G1 X14.500 S0.344
+G1 X14.000 S0.191
+G1 X13.500 S0.075
+G1 X13.000 S0.010
+G1 X12.500 S0.005
+G1 X12.000 S0.060
+G1 X11.500 S0.168
+G1 X11.000 S0.317
+G1 X10.500 S0.487
+G1 X10.000 S0.660
+G1 X9.500 S0.812
+G1 X9.000 S0.927
+G1 X8.500 S0.990
+G1 X8.000 S0.994
+G1 X7.500 S0.938
+G1 X7.000 S0.828
+G1 X6.500 S0.679
+G1 X6.000 S0.508
+G1 X5.500 S0.336
+G1 X5.000 S0.184
+G1 X4.500 S0.071
+G1 X4.000 S0.009
+G1 X3.500 S0.007
+G1 X3.000 S0.064
+G1 X2.500 S0.175
+G1 X2.000 S0.325
+G1 X1.500 S0.496
+G1 X1.000 S0.667
+G1 X0.500 S0.819
+G1 X0.000 S0.932
+G0 X0.000 Y0.800
+G1 X0.500 S0.496
+G1 X1.000 S0.325
+G1 X1.500 S0.175
+G1 X2.000 S0.064
+G1 X2.500 S0.007
+G1 X3.000 S0.009
+G1 X3.500 S0.071
+G1 X4.000 S0.184
+G1 X4.500 S0.336
+G1 X5.000 S0.508
+G1 X5.500 S0.679
+G1 X6.000 S0.828
+G1 X6.500 S0.938
+G1 X7.000 S0.994
+G1 X7.500 S0.990
+G1 X8.000 S0.927
+G1 X8.500 S0.812
+G1 X9.000 S0.660
+G1 X9.500 S0.487
+G1 X10.000 S0.317
+G1 X10.500 S0.168
+G1 X11.000 S0.060
+G1 X11.500 S0.005
+G1 X12.000 S0.010
+G1 X12.500 S0.075
+G1 X13.000 S0.191
+G1 X13.500 S0.344
+G1 X14.000 S0.517
+G1 X14.500 S0.687
+G1 X15.000 S0.835
+G1 X15.500 S0.942
+G1 X16.000 S0.995
+G1 X16.500 S0.989
+G1 X17.000 S0.923
+G1 X17.500 S0.806
+G1 X18.000 S0.652
+G1 X18.500 S0.479
+G1 X19.000 S0.309
+G1 X19.500 S0.162
+G1 X20.000 S0.056
+G1 X20.500 S0.004
+G1 X21.000 S0.012
+G1 X21.500 S0.079
+G1 X22.000 S0.198
+G1 X22.500 S0.352
+G1 X23.000 S0.525
+G1 X23.500 S0.695
+G1 X24.000 S0.841
+G1 X24.500 S0.946
+G1 X25.000 S0.996
+G1 X25.500 S0.987
+G1 X26.000 S0.918
+G1 X26.500 S0.799
+G1 X27.000 S0.644
+G1 X27.500 S0.471
+G1 X28.000 S0.301
+G1 X28.500 S0.156
+G1 X29.000 S0.052
+G1 X29.500 S0.003
+G1 X30.000 S0.014
+G1 X30.500 S0.084
+G1 X31.000 S0.204
+G1 X31.500 S0.361
+G1 X32.000 S0.534
+G1 X32.500 S0.703
+G1 X33.000 S0.847
+G1 X33.500 S0.949
+G1 X34.000 S0.997
+G1 X34.500 S0.985
+G1 X35.000 S0.914
+G1 X35.500 S0.792
+G1 X36.000 S0.635
+G1 X36.500 S0.462
+G1 X37.000 S0.294
+G1 X37.500 S0.150
+G1 X38.000 S0.049
+G1 X38.500 S0.002
+G1 X39.000 S0.016
+G1 X39.500 S0.089
+G1 X40.000 S0.211
+G0 X40.000 Y1.000
+G1 X39.500 S0.369
+G1 X39.000 S0.211
+G1 X38.500 S0.089
+G1 X38.000 S0.016
+G1 X37.500 S0.002
+G1 X37.000 S0.049
+G1 X36.500 S0.150
+G1 X36.000 S0.294
+G1 X35.500 S0.462
+G1 X35.000 S0.635
+G1 X34.500 S0.792
+G1 X34.000 S0.914
+G1 X33.500 S0.985
+G1 X33.000 S0.997
+G1 X32.500 S0.949
+G1 X32.000 S0.847
+G1 X31.500 S0.703
+G1 X31.000 S0.534
+G1 X30.500 S0.361
+G1 X30.000 S0.204
+G1 X29.500 S0.084
+G1 X29.000 S0.014
+G1 X28.500 S0.003
+G1 X28.000 S0.052
+G1 X27.500 S0.156
+G1 X27.000 S0.301
+G1 X26.500 S0.471
+G1 X26.000 S0.644
+G1 X25.500 S0.799
+G1 X25.000 S0.918
+G1 X24.500 S0.987
+G1 X24.000 S0.996
+G1 X23.500 S0.946
+G1 X23.000 S0.841
+G1 X22.500 S0.695
+G1 X22.000 S0.525
+G1 X21.500 S0.352
+G1 X21.000 S0.198
+G1 X20.500 S0.079
+G1 X20.000 S0.012
+G1 X19.500 S0.004
+G1 X19.000 S0.056
+G1 X18.500 S0.162
+G1 X18.000 S0.309
+G1 X17.500 S0.479
+G1 X17.000 S0.652
+G1 X16.500 S0.806
+G1 X16.000 S0.923
+G1 X15.500 S0.989
+G1 X15.000 S0.995
+G1 X14.500 S0.942
+G1 X14.000 S0.835
+G1 X13.500 S0.687
+G1 X13.000 S0.517
+G1 X12.500 S0.344
+G1 X12.000 S0.191
+G1 X11.500 S0.075
+G1 X11.000 S0.010
+G1 X10.500 S0.005
+G1 X10.000 S0.060
+G1 X9.500 S0.168
+G1 X9.000 S0.317
+G1 X8.500 S0.487
+G1 X8.000 S0.660
+G1 X7.500 S0.812
+G1 X7.000 S0.927
+G1 X6.500 S0.990
+G1 X6.000 S0.994
+G1 X5.500 S0.938
+G1 X5.000 S0.828
+G1 X4.500 S0.679
+G1 X4.000 S0.508
+G1 X3.500 S0.336
+G1 X3.000 S0.184
+G1 X2.500 S0.071
+G1 X2.000 S0.009
+G1 X1.500 S0.007
+G1 X1.000 S0.064
+G1 X0.500 S0.175
+G1 X0.000 S0.325
+G0 X0.000 Y1.200
+G1 X0.500 S0.007
+G1 X1.000 S0.009
+G1 X1.500 S0.071
+G1 X2.000 S0.184
+G1 X2.500 S0.336
+G1 X3.000 S0.508
+G1 X3.500 S0.679
+G1 X4.000 S0.828
+G1 X4.500 S0.938
+G1 X5.000 S0.994
+G1 X5.500 S0.990
+G1 X6.000 S0.927
+G1 X6.500 S0.812
+G1 X7.000 S0.660
+G1 X7.500 S0.487
+G1 X8.000 S0.317
+G1 X8.500 S0.168
+G1 X9.000 S0.060
+G1 X9.500 S0.005
+G1 X10.000 S0.010
+G1 X10.500 S0.075
+G1 X11.000 S0.191
+G1 X11.500 S0.344
+G1 X12.000 S0.517
+G1 X12.500 S0.687
+G1 X13.000 S0.835
+G1 X13.500 S0.942
+G1 X14.000 S0.995
+G1 X14.500 S0.989
+G1 X15.000 S0.923
+G1 X15.500 S0.806
+G1 X16.000 S0.652
+G1 X16.500 S0.479
+G1 X17.000 S0.309
+G1 X17.500 S0.162
+G1 X18.000 S0.056
+G1 X18.500 S0.004
+G1 X19.000 S0.012
+G1 X19.500 S0.079
+G1 X20.000 S0.198
+G1 X20.500 S0.352
+G1 X21.000 S0.525
+G1 X21.500 S0.695
+G1 X22.000 S0.841
+G1 X22.500 S0.946
+G1 X23.000 S0.996
+G1 X23.500 S0.987
+G1 X24.000 S0.918
+G1 X24.500 S0.799
+G1 X25.000 S0.644
+G1 X25.500 S0.471
+G1 X26.000 S0.301
+G1 X26.500 S0.156
+G1 X27.000 S0.052
+G1 X27.500 S0.003
+G1 X28.000 S0.014
+G1 X28.500 S0.084
+G1 X29.000 S0.204
+G1 X29.500 S0.361
+G1 X30.000 S0.534
+G1 X30.500 S0.703
+G1 X31.000 S0.847
+G1 X31.500 S0.949
+G1 X32.000 S0.997
+G1 X32.500 S0.985
+G1 X33.000 S0.914
+G1 X33.500 S0.792
+G1 X34.000 S0.635
+G1 X34.500 S0.462
+G1 X35.000 S0.294
+G1 X35.500 S0.150
+G1 X36.000 S0.049
+G1 X36.500 S0.002
+G1 X37.000 S0.016
+G1 X37.500 S0.089
+G1 X38.000 S0.211
+G1 X38.500 S0.369
+G1 X39.000 S0.542
+G1 X39.500 S0.710
+G1 X40.000 S0.853
+G0 X40.000 Y1.400
+G1 X39.500 S0.953
+G1 X39.000 S0.853
+G1 X38.500 S0.710
+G1 X38.000 S0.542
+G1 X37.500 S0.369
+G1 X37.000 S0.211
+G1 X36.500 S0.089
+G1 X36.000 S0.016
+G1 X35.500 S0.002
+G1 X35.000 S0.049
+G1 X34.500 S0.150
+G1 X34.000 S0.294
+G1 X33.500 S0.462
+G1 X33.000 S0.635
+G1 X32.500 S0.792
+G1 X32.000 S0.914
+G1 X31.500 S0.985
+G1 X31.000 S0.997
+G1 X30.500 S0.949
+G1 X30.000 S0.847
+G1 X29.500 S0.703
+G1 X29.000 S0.534
+G1 X28.500 S0.361
+G1 X28.000 S0.204
+G1 X27.500 S0.084
+G1 X27.000 S0.014
+G1 X26.500 S0.003
+G1 X26.000 S0.052
+G1 X25.500 S0.156
+G1 X25.000 S0.301
+G1 X24.500 S0.471
+G1 X24.000 S0.644
+G1 X23.500 S0.799
+G1 X23.000 S0.918
+G1 X22.500 S0.987
+G1 X22.000 S0.996
+G1 X21.500 S0.946
+G1 X21.000 S0.841
+G1 X20.500 S0.695
+G1 X20.000 S0.525
+G1 X19.500 S0.352
+G1 X19.000 S0.198
+G1 X18.500 S0.079
+G1 X18.000 S0.012
+G1 X17.500 S0.004
+G1 X17.000 S0.056
+G1 X16.500 S0.162
+G1 X16.000 S0.309
+G1 X15.500 S0.479
+G1 X15.000 S0.652
+G1 X14.500 S0.806
+G1 X14.000 S0.923
+G1 X13.500 S0.989
+G1 X13.000 S0.995
+G1 X12.500 S0.942
+G1 X12.000 S0.835
+G1 X11.500 S0.687
+G1 X11.000 S0.517
+G1 X10.500 S0.344
+G1 X10.000 S0.191
+G1 X9.500 S0.075
+G1 X9.000 S0.010
+G1 X8.500 S0.005
+G1 X8.000 S0.060
+G1 X7.500 S0.168
+G1 X7.000 S0.317
+G1 X6.500 S0.487
+G1 X6.000 S0.660
+G1 X5.500 S0.812
+G1 X5.000 S0.927
+G1 X4.500 S0.990
+G1 X4.000 S0.994
+G1 X3.500 S0.938
+G1 X3.000 S0.828
+G1 X2.500 S0.679
+G1 X2.000 S0.508
+G1 X1.500 S0.336
+G1 X1.000 S0.184
+G1 X0.500 S0.071
+G1 X0.000 S0.009
+G0 X0.000 Y1.600
+G1 X0.500 S0.336
+G1 X1.000 S0.508
+G1 X1.500 S0.679
+G1 X2.000 S0.828
+G1 X2.500 S0.938
+G1 X3.000 S0.994
+G1 X3.500 S0.990
+G1 X4.000 S0.927
+G1 X4.500 S0.812
+G1 X5.000 S0.660
+G1 X5.500 S0.487
+G1 X6.000 S0.317
+G1 X6.500 S0.168
+G1 X7.000 S0.060
+G1 X7.500 S0.005
+G1 X8.000 S0.010
+G1 X8.500 S0.075
+G1 X9.000 S0.191
+G1 X9.500 S0.344
+G1 X10.000 S0.517
+G1 X10.500 S0.687
+G1 X11.000 S0.835
+G1 X11.500 S0.942
+G1 X12.000 S0.995
+G1 X12.500 S0.989
+G1 X13.000 S0.923
+G1 X13.500 S0.806
+G1 X14.000 S0.652
+G1 X14.500 S0.479
+G1 X15.000 S0.309
+G1 X15.500 S0.162
+G1 X16.000 S0.056
+G1 X16.500 S0.004
+G1 X17.000 S0.012
+G1 X17.500 S0.079
+G1 X18.000 S0.198
+G1 X18.500 S0.352
+G1 X19.000 S0.525
+G1 X19.500 S0.695
+G1 X20.000 S0.841
+G1 X20.500 S0.946
+G1 X21.000 S0.996
+G1 X21.500 S0.987
+G1 X22.000 S0.918
+G1 X22.500 S0.799
+G1 X23.000 S0.644
+G1 X23.500 S0.471
+G1 X24.000 S0.301
+G1 X24.500 S0.156
+G1 X25.000 S0.052
+G1 X25.500 S0.003
+G1 X26.000 S0.014
+G1 X26.500 S0.084
+G1 X27.000 S0.204
+G1 X27.500 S0.361
+G1 X28.000 S0.534
+G1 X28.500 S0.703
+G1 X29.000 S0.847
+G1 X29.500 S0.949
+G1 X30.000 S0.997
+G1 X30.500 S0.985
+G1 X31.000 S0.914
+G1 X31.500 S0.792
+G1 X32.000 S0.635
+G1 X32.500 S0.462
+G1 X33.000 S0.294
+G1 X33.500 S0.150
+G1 X34.000 S0.049
+G1 X34.500 S0.002
+G1 X35.000 S0.016
+G1 X35.500 S0.089
+G1 X36.000 S0.211
+G1 X36.500 S0.369
+G1 X37.000 S0.542
+G1 X37.500 S0.710
+G1 X38.000 S0.853
+G1 X38.500 S0.953
+G1 X39.000 S0.998
+G1 X39.500 S0.983
+G1 X40.000 S0.909
+G0 X40.000 Y1.800
+G1 X39.500 S0.785
+G1 X39.000 S0.909
+G1 X38.500 S0.983
+G1 X38.000 S0.998
+G1 X37.500 S0.953
+G1 X37.000 S0.853
+G1 X36.500 S0.710
+G1 X36.000 S0.542
+G1 X35.500 S0.369
+G1 X35.000 S0.211
+G1 X34.500 S0.089
+G1 X34.000 S0.016
+G1 X33.500 S0.002
+G1 X33.000 S0.049
+G1 X32.500 S0.150
+G1 X32.000 S0.294
+G1 X31.500 S0.462
+G1 X31.000 S0.635
+G1 X30.500 S0.792
+G1 X30.000 S0.914
+G1 X29.500 S0.985
+G1 X29.000 S0.997
+G1 X28.500 S0.949
+G1 X28.000 S0.847
+G1 X27.500 S0.703
+G1 X27.000 S0.534
+G1 X26.500 S0.361
+G1 X26.000 S0.204
+G1 X25.500 S0.084
+G1 X25.000 S0.014
+G1 X24.500 S0.003
+G1 X24.000 S0.052
+G1 X23.500 S0.156
+G1 X23.000 S0.301
+G1 X22.500 S0.471
+G1 X22.000 S0.644
+G1 X21.500 S0.799
+G1 X21.000 S0.918
+G1 X20.500 S0.987
+G1 X20.000 S0.996
+G1 X19.500 S0.946
+G1 X19.000 S0.841
+G1 X18.500 S0.695
+G1 X18.000 S0.525
+G1 X17.500 S0.352
+G1 X17.000 S0.198
+G1 X16.500 S0.079
+G1 X16.000 S0.012
+G1 X15.500 S0.004
+G1 X15.000 S0.056
+G1 X14.500 S0.162
+G1 X14.000 S0.309
+G1 X13.500 S0.479
+G1 X13.000 S0.652
+G1 X12.500 S0.806
+G1 X12.000 S0.923
+G1 X11.500 S0.989
+G1 X11.000 S0.995
+G1 X10.500 S0.942
+G1 X10.000 S0.835
+G1 X9.500 S0.687
+G1 X9.000 S0.517
+G1 X8.500 S0.344
+G1 X8.000 S0.191
+G1 X7.500 S0.075
+G1 X7.000 S0.010
+G1 X6.500 S0.005
+G1 X6.000 S0.060
+G1 X5.500 S0.168
+G1 X5.000 S0.317
+G1 X4.500 S0.487
+G1 X4.000 S0.660
+G1 X3.500 S0.812
+G1 X3.000 S0.927
+G1 X2.500 S0.990
+G1 X2.000 S0.994
+G1 X1.500 S0.938
+G1 X1.000 S0.828
+G1 X0.500 S0.679
+G1 X0.000 S0.508
+G0 X0.000 Y2.000
+G1 X0.500 S0.938
+G1 X1.000 S0.994
+G1 X1.500 S0.990
+G1 X2.000 S0.927
+G1 X2.500 S0.812
+G1 X3.000 S0.660
+G1 X3.500 S0.487
+G1 X4.000 S0.317
+G1 X4.500 S0.168
+G1 X5.000 S0.060
+G1 X5.500 S0.005
+G1 X6.000 S0.010
+G1 X6.500 S0.075
+G1 X7.000 S0.191
+G1 X7.500 S0.344
+G1 X8.000 S0.517
+G1 X8.500 S0.687
+G1 X9.000 S0.835
+G1 X9.500 S0.942
+G1 X10.000 S0.995
+G1 X10.500 S0.989
+G1 X11.000 S0.923
+G1 X11.500 S0.806
+G1 X12.000 S0.652
+G1 X12.500 S0.479
+G1 X13.000 S0.309
+G1 X13.500 S0.162
+G1 X14.000 S0.056
+G1 X14.500 S0.004
+G1 X15.000 S0.012
+G1 X15.500 S0.079
+G1 X16.000 S0.198
+G1 X16.500 S0.352
+G1 X17.000 S0.525
+G1 X17.500 S0.695
+G1 X18.000 S0.841
+G1 X18.500 S0.946
+G1 X19.000 S0.996
+G1 X19.500 S0.987
+G1 X20.000 S0.918
+G1 X20.500 S0.799
+G1 X21.000 S0.644
+G1 X21.500 S0.471
+G1 X22.000 S0.301
+G1 X22.500 S0.156
+G1 X23.000 S0.052
+G1 X23.500 S0.003
+G1 X24.000 S0.014
+G1 X24.500 S0.084
+G1 X25.000 S0.204
+G1 X25.500 S0.361
+G1 X26.000 S0.534
+G1 X26.500 S0.703
+G1 X27.000 S0.847
+G1 X27.500 S0.949
+G1 X28.000 S0.997
+G1 X28.500 S0.985
+G1 X29.000 S0.914
+G1 X29.500 S0.792
+G1 X30.000 S0.635
+G1 X30.500 S0.462
+G1 X31.000 S0.294
+G1 X31.500 S0.150
+G1 X32.000 S0.049
+G1 X32.500 S0.002
+G1 X33.000 S0.016
+G1 X33.500 S0.089
+G1 X34.000 S0.211
+G1 X34.500 S0.369
+G1 X35.000 S0.542
+G1 X35.500 S0.710
+G1 X36.000 S0.853
+G1 X36.500 S0.953
+G1 X37.000 S0.998
+G1 X37.500 S0.983
+G1 X38.000 S0.909
+G1 X38.500 S0.785
+G1 X39.000 S0.627
+G1 X39.500 S0.454
+G1 X40.000 S0.286
+G0 X40.000 Y2.200
+G1 X39.500 S0.144
+G1 X39.000 S0.286
+G1 X38.500 S0.454
+G1 X38.000 S0.627
+G1 X37.500 S0.785
+G1 X37.000 S0.909
+G1 X36.500 S0.983
+G1 X36.000 S0.998
+G1 X35.500 S0.953
+G1 X35.000 S0.853
+G1 X34.500 S0.710
+G1 X34.000 S0.542
+G1 X33.500 S0.369
+G1 X33.000 S0.211
+G1 X32.500 S0.089
+G1 X32.000 S0.016
+G1 X31.500 S0.002
+G1 X31.000 S0.049
+G1 X30.500 S0.150
+G1 X30.000 S0.294
+G1 X29.500 S0.462
+G1 X29.000 S0.635
+G1 X28.500 S0.792
+G1 X28.000 S0.914
+G1 X27.500 S0.985
+G1 X27.000 S0.997
+G1 X26.500 S0.949
+G1 X26.000 S0.847
+G1 X25.500 S0.703
+G1 X25.000 S0.534
+G1 X24.500 S0.361
+G1 X24.000 S0.204
+G1 X23.500 S0.084
+G1 X23.000 S0.014
+G1 X22.500 S0.003
+G1 X22.000 S0.052
+G1 X21.500 S0.156
+G1 X21.000 S0.301
+G1 X20.500 S0.471
+G1 X20.000 S0.644
+G1 X19.500 S0.799
+G1 X19.000 S0.918
+G1 X18.500 S0.987
+G1 X18.000 S0.996
+G1 X17.500 S0.946
+G1 X17.000 S0.841
+G1 X16.500 S0.695
+G1 X16.000 S0.525
+G1 X15.500 S0.352
+G1 X15.000 S0.198
+G1 X14.500 S0.079
+G1 X14.000 S0.012
+G1 X13.500 S0.004
+G1 X13.000 S0.056
+G1 X12.500 S0.162
+G1 X12.000 S0.309
+G1 X11.500 S0.479
+G1 X11.000 S0.652
+G1 X10.500 S0.806
+G1 X10.000 S0.923
+G1 X9.500 S0.989
+G1 X9.000 S0.995
+G1 X8.500 S0.942
+G1 X8.000 S0.835
+G1 X7.500 S0.687
+G1 X7.000 S0.517
+G1 X6.500 S0.344
+G1 X6.000 S0.191
+G1 X5.500 S0.075
+G1 X5.000 S0.010
+G1 X4.500 S0.005
+G1 X4.000 S0.060
+G1 X3.500 S0.168
+G1 X3.000 S0.317
+G1 X2.500 S0.487
+G1 X2.000 S0.660
+G1 X1.500 S0.812
+G1 X1.000 S0.927
+G1 X0.500 S0.990
+G1 X0.000 S0.994
+G0 X0.000 Y2.400
+G1 X0.500 S0.812
+G1 X1.000 S0.660
+G1 X1.500 S0.487
+G1 X2.000 S0.317
+G1 X2.500 S0.168
+G1 X3.000 S0.060
+G1 X3.500 S0.005
+G1 X4.000 S0.010
+G1 X4.500 S0.075
+G1 X5.000 S0.191
+G1 X5.500 S0.344
+G1 X6.000 S0.517
+G1 X6.500 S0.687
+G1 X7.000 S0.835
+G1 X7.500 S0.942
+G1 X8.000 S0.995
+G1 X8.500 S0.989
+G1 X9.000 S0.923
+G1 X9.500 S0.806
+G1 X10.000 S0.652
+G1 X10.500 S0.479
+G1 X11.000 S0.309
+G1 X11.500 S0.162
+G1 X12.000 S0.056
+G1 X12.500 S0.004
+G1 X13.000 S0.012
+G1 X13.500 S0.079
+G1 X14.000 S0.198
+G1 X14.500 S0.352
+G1 X15.000 S0.525
+G1 X15.500 S0.695
+G1 X16.000 S0.841
+G1 X16.500 S0.946
+G1 X17.000 S0.996
+G1 X17.500 S0.987
+G1 X18.000 S0.918
+G1 X18.500 S0.799
+G1 X19.000 S0.644
+G1 X19.500 S0.471
+G1 X20.000 S0.301
+G1 X20.500 S0.156
+G1 X21.000 S0.052
+G1 X21.500 S0.003
+G1 X22.000 S0.014
+G1 X22.500 S0.084
+G1 X23.000 S0.204
+G1 X23.500 S0.361
+G1 X24.000 S0.534
+G1 X24.500 S0.703
+G1 X25.000 S0.847
+G1 X25.500 S0.949
+G1 X26.000 S0.997
+G1 X26.500 S0.985
+G1 X27.000 S0.914
+G1 X27.500 S0.792
+G1 X28.000 S0.635
+G1 X28.500 S0.462
+G1 X29.000 S0.294
+G1 X29.500 S0.150
+G1 X30.000 S0.049
+G1 X30.500 S0.002
+G1 X31.000 S0.016
+G1 X31.500 S0.089
+G1 X32.000 S0.211
+G1 X32.500 S0.369
+G1 X33.000 S0.542
+G1 X33.500 S0.710
+G1 X34.000 S0.853
+G1 X34.500 S0.953
+G1 X35.000 S0.998
+G1 X35.500 S0.983
+G1 X36.000 S0.909
+G1 X36.500 S0.785
+G1 X37.000 S0.627
+G1 X37.500 S0.454
+G1 X38.000 S0.286
+G1 X38.500 S0.144
+G1 X39.000 S0.045
+G1 X39.500 S0.002
+G1 X40.000 S0.018
+G0 X40.000 Y2.600
+G1 X39.500 S0.094
+G1 X39.000 S0.018
+G1 X38.500 S0.002
+G1 X38.000 S0.045
+G1 X37.500 S0.144
+G1 X37.000 S0.286
+G1 X36.500 S0.454
+G1 X36.000 S0.627
+G1 X35.500 S0.785
+G1 X35.000 S0.909
+G1 X34.500 S0.983
+G1 X34.000 S0.998
+G1 X33.500 S0.953
+G1 X33.000 S0.853
+G1 X32.500 S0.710
+G1 X32.000 S0.542
+G1 X31.500 S0.369
+G1 X31.000 S0.211
+G1 X30.500 S0.089
+G1 X30.000 S0.016
+G1 X29.500 S0.002
+G1 X29.000 S0.049
+G1 X28.500 S0.150
+G1 X28.000 S0.294
+G1 X27.500 S0.462
+G1 X27.000 S0.635
+G1 X26.500 S0.792
+G1 X26.000 S0.914
+G1 X25.500 S0.985
+G1 X25.000 S0.997
+G1 X24.500 S0.949
+G1 X24.000 S0.847
+G1 X23.500 S0.703
+G1 X23.000 S0.534
+G1 X22.500 S0.361
+G1 X22.000 S0.204
+G1 X21.500 S0.084
+G1 X21.000 S0.014
+G1 X20.500 S0.003
+G1 X20.000 S0.052
+G1 X19.500 S0.156
+G1 X19.000 S0.301
+G1 X18.500 S0.471
+G1 X18.000 S0.644
+G1 X17.500 S0.799
+G1 X17.000 S0.918
+G1 X16.500 S0.987
+G1 X16.000 S0.996
+G1 X15.500 S0.946
+G1 X15.000 S0.841
+G1 X14.500 S0.695
+G1 X14.000 S0.525
+G1 X13.500 S0.352
+G1 X13.000 S0.198
+G1 X12.500 S0.079
+G1 X12.000 S0.012
+G1 X11.500 S0.004
+G1 X11.000 S0.056
+G1 X10.500 S0.162
+G1 X10.000 S0.309
+G1 X9.500 S0.479
+G1 X9.000 S0.652
+G1 X8.500 S0.806
+G1 X8.000 S0.923
+G1 X7.500 S0.989
+G1 X7.000 S0.995
+G1 X6.500 S0.942
+G1 X6.000 S0.835
+G1 X5.500 S0.687
+G1 X5.000 S0.517
+G1 X4.500 S0.344
+G1 X4.000 S0.191
+G1 X3.500 S0.075
+G1 X3.000 S0.010
+G1 X2.500 S0.005
+G1 X2.000 S0.060
+G1 X1.500 S0.168
+G1 X1.000 S0.317
+G1 X0.500 S0.487
+G1 X0.000 S0.660
+G0 X0.000 Y2.800
+G1 X0.500 S0.168
+G1 X1.000 S0.060
+G1 X1.500 S0.005
+G1 X2.000 S0.010
+G1 X2.500 S0.075
+G1 X3.000 S0.191
+G1 X3.500 S0.344
+G1 X4.000 S0.517
+G1 X4.500 S0.687
+G1 X5.000 S0.835
+G1 X5.500 S0.942
+G1 X6.000 S0.995
+G1 X6.500 S0.989
+G1 X7.000 S0.923
+G1 X7.500 S0.806
+G1 X8.000 S0.652
+G1 X8.500 S0.479
+G1 X9.000 S0.309
+G1 X9.500 S0.162
+G1 X10.000 S0.056
+G1 X10.500 S0.004
+G1 X11.000 S0.012
+G1 X11.500 S0.079
+G1 X12.000 S0.198
+G1 X12.500 S0.352
+G1 X13.000 S0.525
+G1 X13.500 S0.695
+G1 X14.000 S0.841
+G1 X14.500 S0.946
+G1 X15.000 S0.996
+G1 X15.500 S0.987
+G1 X16.000 S0.918
+G1 X16.500 S0.799
+G1 X17.000 S0.644
+G1 X17.500 S0.471
+G1 X18.000 S0.301
+G1 X18.500 S0.156
+G1 X19.000 S0.052
+G1 X19.500 S0.003
+G1 X20.000 S0.014
+G1 X20.500 S0.084
+G1 X21.000 S0.204
+G1 X21.500 S0.361
+G1 X22.000 S0.534
+G1 X22.500 S0.703
+G1 X23.000 S0.847
+G1 X23.500 S0.949
+G1 X24.000 S0.997
+G1 X24.500 S0.985
+G1 X25.000 S0.914
+G1 X25.500 S0.792
+G1 X26.000 S0.635
+G1 X26.500 S0.462
+G1 X27.000 S0.294
+G1 X27.500 S0.150
+G1 X28.000 S0.049
+G1 X28.500 S0.002
+G1 X29.000 S0.016
+G1 X29.500 S0.089
+G1 X30.000 S0.211
+G1 X30.500 S0.369
+G1 X31.000 S0.542
+G1 X31.500 S0.710
+G1 X32.000 S0.853
+G1 X32.500 S0.953
+G1 X33.000 S0.998
+G1 X33.500 S0.983
+G1 X34.000 S0.909
+G1 X34.500 S0.785
+G1 X35.000 S0.627
+G1 X35.500 S0.454
+G1 X36.000 S0.286
+G1 X36.500 S0.144
+G1 X37.000 S0.045
+G1 X37.500 S0.002
+G1 X38.000 S0.018
+G1 X38.500 S0.094
+G1 X39.000 S0.218
+G1 X39.500 S0.377
+G1 X40.000 S0.550
+G0 X40.000 Y3.000
+G1 X39.500 S0.718
+G1 X39.000 S0.550
+G1 X38.500 S0.377
+G1 X38.000 S0.218
+G1 X37.500 S0.094
+G1 X37.000 S0.018
+G1 X36.500 S0.002
+G1 X36.000 S0.045
+G1 X35.500 S0.144
+G1 X35.000 S0.286
+G1 X34.500 S0.454
+G1 X34.000 S0.627
+G1 X33.500 S0.785
+G1 X33.000 S0.909
+G1 X32.500 S0.983
+G1 X32.000 S0.998
+G1 X31.500 S0.953
+G1 X31.000 S0.853
+G1 X30.500 S0.710
+G1 X30.000 S0.542
+G1 X29.500 S0.369
+G1 X29.000 S0.211
+G1 X28.500 S0.089
+G1 X28.000 S0.016
+G1 X27.500 S0.002
+G1 X27.000 S0.049
+G1 X26.500 S0.150
+G1 X26.000 S0.294
+G1 X25.500 S0.462
+G1 X25.000 S0.635
+G1 X24.500 S0.792
+G1 X24.000 S0.914
+G1 X23.500 S0.985
+G1 X23.000 S0.997
+G1 X22.500 S0.949
+G1 X22.000 S0.847
+G1 X21.500 S0.703
+G1 X21.000 S0.534
+G1 X20.500 S0.361
+G1 X20.000 S0.204
+G1 X19.500 S0.084
+G1 X19.000 S0.014
+G1 X18.500 S0.003
+G1 X18.000 S0.052
+G1 X17.500 S0.156
+G1 X17.000 S0.301
+G1 X16.500 S0.471
+G1 X16.000 S0.644
+G1 X15.500 S0.799
+G1 X15.000 S0.918
+G1 X14.500 S0.987
+G1 X14.000 S0.996
+G1 X13.500 S0.946
+G1 X13.000 S0.841
+G1 X12.500 S0.695
+G1 X12.000 S0.525
+G1 X11.500 S0.352
+G1 X11.000 S0.198
+G1 X10.500 S0.079
+G1 X10.000 S0.012
+G1 X9.500 S0.004
+G1 X9.000 S0.056
+G1 X8.500 S0.162
+G1 X8.000 S0.309
+G1 X7.500 S0.479
+G1 X7.000 S0.652
+G1 X6.500 S0.806
+G1 X6.000 S0.923
+G1 X5.500 S0.989
+G1 X5.000 S0.995
+G1 X4.500 S0.942
+G1 X4.000 S0.835
+G1 X3.500 S0.687
+G1 X3.000 S0.517
+G1 X2.500 S0.344
+G1 X2.000 S0.191
+G1 X1.500 S0.075
+G1 X1.000 S0.010
+G1 X0.500 S0.005
+G1 X0.000 S0.060
+G0 X0.000 Y3.200
+G1 X0.500 S0.075
+G1 X1.000 S0.191
+G1 X1.500 S0.344
+G1 X2.000 S0.517
+G1 X2.500 S0.687
+G1 X3.000 S0.835
+G1 X3.500 S0.942
+G1 X4.000 S0.995
+G1 X4.500 S0.989
+G1 X5.000 S0.923
+G1 X5.500 S0.806
+G1 X6.000 S0.652
+G1 X6.500 S0.479
+G1 X7.000 S0.309
+G1 X7.500 S0.162
+G1 X8.000 S0.056
+G1 X8.500 S0.004
+G1 X9.000 S0.012
+G1 X9.500 S0.079
+G1 X10.000 S0.198
+G1 X10.500 S0.352
+G1 X11.000 S0.525
+G1 X11.500 S0.695
+G1 X12.000 S0.841
+G1 X12.500 S0.946
+G1 X13.000 S0.996
+G1 X13.500 S0.987
+G1 X14.000 S0.918
+G1 X14.500 S0.799
+G1 X15.000 S0.644
+G1 X15.500 S0.471
+G1 X16.000 S0.301
+G1 X16.500 S0.156
+G1 X17.000 S0.052
+G1 X17.500 S0.003
+G1 X18.000 S0.014
+G1 X18.500 S0.084
+G1 X19.000 S0.204
+G1 X19.500 S0.361
+G1 X20.000 S0.534
+G1 X20.500 S0.703
+G1 X21.000 S0.847
+G1 X21.500 S0.949
+G1 X22.000 S0.997
+G1 X22.500 S0.985
+G1 X23.000 S0.914
+G1 X23.500 S0.792
+G1 X24.000 S0.635
+G1 X24.500 S0.462
+G1 X25.000 S0.294
+G1 X25.500 S0.150
+G1 X26.000 S0.049
+G1 X26.500 S0.002
+G1 X27.000 S0.016
+G1 X27.500 S0.089
+G1 X28.000 S0.211
+G1 X28.500 S0.369
+G1 X29.000 S0.542
+G1 X29.500 S0.710
+G1 X30.000 S0.853
+G1 X30.500 S0.953
+G1 X31.000 S0.998
+G1 X31.500 S0.983
+G1 X32.000 S0.909
+G1 X32.500 S0.785
+G1 X33.000 S0.627
+G1 X33.500 S0.454
+G1 X34.000 S0.286
+G1 X34.500 S0.144
+G1 X35.000 S0.045
+G1 X35.500 S0.002
+G1 X36.000 S0.018
+G1 X36.500 S0.094
+G1 X37.000 S0.218
+G1 X37.500 S0.377
+G1 X38.000 S0.550
+G1 X38.500 S0.718
+G1 X39.000 S0.859
+G1 X39.500 S0.957
+G1 X40.000 S0.999
+G0 X40.000 Y3.400
+G1 X39.500 S0.981
+G1 X39.000 S0.999
+G1 X38.500 S0.957
+G1 X38.000 S0.859
+G1 X37.500 S0.718
+G1 X37.000 S0.550
+G1 X36.500 S0.377
+G1 X36.000 S0.218
+G1 X35.500 S0.094
+G1 X35.000 S0.018
+G1 X34.500 S0.002
+G1 X34.000 S0.045
+G1 X33.500 S0.144
+G1 X33.000 S0.286
+G1 X32.500 S0.454
+G1 X32.000 S0.627
+G1 X31.500 S0.785
+G1 X31.000 S0.909
+G1 X30.500 S0.983
+G1 X30.000 S0.998
+G1 X29.500 S0.953
+G1 X29.000 S0.853
+G1 X28.500 S0.710
+G1 X28.000 S0.542
+G1 X27.500 S0.369
+G1 X27.000 S0.211
+G1 X26.500 S0.089
+G1 X26.000 S0.016
+G1 X25.500 S0.002
+G1 X25.000 S0.049
+G1 X24.500 S0.150
+G1 X24.000 S0.294
+G1 X23.500 S0.462
+G1 X23.000 S0.635
+G1 X22.500 S0.792
+G1 X22.000 S0.914
+G1 X21.500 S0.985
+G1 X21.000 S0.997
+G1 X20.500 S0.949
+G1 X20.000 S0.847
+G1 X19.500 S0.703
+G1 X19.000 S0.534
+G1 X18.500 S0.361
+G1 X18.000 S0.204
+G1 X17.500 S0.084
+G1 X17.000 S0.014
+G1 X16.500 S0.003
+G1 X16.000 S0.052
+G1 X15.500 S0.156
+G1 X15.000 S0.301
+G1 X14.500 S0.471
+G1 X14.000 S0.644
+G1 X13.500 S0.799
+G1 X13.000 S0.918
+G1 X12.500 S0.987
+G1 X12.000 S0.996
+G1 X11.500 S0.946
+G1 X11.000 S0.841
+G1 X10.500 S0.695
+G1 X10.000 S0.525
+G1 X9.500 S0.352
+G1 X9.000 S0.198
+G1 X8.500 S0.079
+G1 X8.000 S0.012
+G1 X7.500 S0.004
+G1 X7.000 S0.056
+G1 X6.500 S0.162
+G1 X6.000 S0.309
+G1 X5.500 S0.479
+G1 X5.000 S0.652
+G1 X4.500 S0.806
+G1 X4.000 S0.923
+G1 X3.500 S0.989
+G1 X3.000 S0.995
+G1 X2.500 S0.942
+G1 X2.000 S0.835
+G1 X1.500 S0.687
+G1 X1.000 S0.517
+G1 X0.500 S0.344
+G1 X0.000 S0.191
+G0 X0.000 Y3.600
+G1 X0.500 S0.687
+G1 X1.000 S0.835
+G1 X1.500 S0.942
+G1 X2.000 S0.995
+G1 X2.500 S0.989
+G1 X3.000 S0.923
+G1 X3.500 S0.806
+G1 X4.000 S0.652
+G1 X4.500 S0.479
+G1 X5.000 S0.309
+G1 X5.500 S0.162
+G1 X6.000 S0.056
+G1 X6.500 S0.004
+G1 X7.000 S0.012
+G1 X7.500 S0.079
+G1 X8.000 S0.198
+G1 X8.500 S0.352
+G1 X9.000 S0.525
+G1 X9.500 S0.695
+G1 X10.000 S0.841
+G1 X10.500 S0.946
+G1 X11.000 S0.996
+G1 X11.500 S0.987
+G1 X12.000 S0.918
+G1 X12.500 S0.799
+G1 X13.000 S0.644
+G1 X13.500 S0.471
+G1 X14.000 S0.301
+G1 X14.500 S0.156
+G1 X15.000 S0.052
+G1 X15.500 S0.003
+G1 X16.000 S0.014
+G1 X16.500 S0.084
+G1 X17.000 S0.204
+G1 X17.500 S0.361
+G1 X18.000 S0.534
+G1 X18.500 S0.703
+G1 X19.000 S0.847
+G1 X19.500 S0.949
+G1 X20.000 S0.997
+G1 X20.500 S0.985
+G1 X21.000 S0.914
+G1 X21.500 S0.792
+G1 X22.000 S0.635
+G1 X22.500 S0.462
+G1 X23.000 S0.294
+G1 X23.500 S0.150
+G1 X24.000 S0.049
+G1 X24.500 S0.002
+G1 X25.000 S0.016
+G1 X25.500 S0.089
+G1 X26.000 S0.211
+G1 X26.500 S0.369
+G1 X27.000 S0.542
+G1 X27.500 S0.710
+G1 X28.000 S0.853
+G1 X28.500 S0.953
+G1 X29.000 S0.998
+G1 X29.500 S0.983
+G1 X30.000 S0.909
+G1 X30.500 S0.785
+G1 X31.000 S0.627
+G1 X31.500 S0.454
+G1 X32.000 S0.286
+G1 X32.500 S0.144
+G1 X33.000 S0.045
+G1 X33.500 S0.002
+G1 X34.000 S0.018
+G1 X34.500 S0.094
+G1 X35.000 S0.218
+G1 X35.500 S0.377
+G1 X36.000 S0.550
+G1 X36.500 S0.718
+G1 X37.000 S0.859
+G1 X37.500 S0.957
+G1 X38.000 S0.999
+G1 X38.500 S0.981
+G1 X39.000 S0.904
+G1 X39.500 S0.778
+G1 X40.000 S0.619
+G0 X40.000 Y3.800
+G1 X39.500 S0.445
+G1 X39.000 S0.619
+G1 X38.500 S0.778
+G1 X38.000 S0.904
+G1 X37.500 S0.981
+G1 X37.000 S0.999
+G1 X36.500 S0.957
+G1 X36.000 S0.859
+G1 X35.500 S0.718
+G1 X35.000 S0.550
+G1 X34.500 S0.377
+G1 X34.000 S0.218
+G1 X33.500 S0.094
+G1 X33.000 S0.018
+G1 X32.500 S0.002
+G1 X32.000 S0.045
+G1 X31.500 S0.144
+G1 X31.000 S0.286
+G1 X30.500 S0.454
+G1 X30.000 S0.627
+G1 X29.500 S0.785
+G1 X29.000 S0.909
+G1 X28.500 S0.983
+G1 X28.000 S0.998
+G1 X27.500 S0.953
+G1 X27.000 S0.853
+G1 X26.500 S0.710
+G1 X26.000 S0.542
+G1 X25.500 S0.369
+G1 X25.000 S0.211
+G1 X24.500 S0.089
+G1 X24.000 S0.016
+G1 X23.500 S0.002
+G1 X23.000 S0.049
+G1 X22.500 S0.150
+G1 X22.000 S0.294
+G1 X21.500 S0.462
+G1 X21.000 S0.635
+G1 X20.500 S0.792
+G1 X20.000 S0.914
+G1 X19.500 S0.985
+G1 X19.000 S0.997
+G1 X18.500 S0.949
+G1 X18.000 S0.847
+G1 X17.500 S0.703
+G1 X17.000 S0.534
+G1 X16.500 S0.361
+G1 X16.000 S0.204
+G1 X15.500 S0.084
+G1 X15.000 S0.014
+G1 X14.500 S0.003
+G1 X14.000 S0.052
+G1 X13.500 S0.156
+G1 X13.000 S0.301
+G1 X12.500 S0.471
+G1 X12.000 S0.644
+G1 X11.500 S0.799
+G1 X11.000 S0.918
+G1 X10.500 S0.987
+G1 X10.000 S0.996
+G1 X9.500 S0.946
+G1 X9.000 S0.841
+G1 X8.500 S0.695
+G1 X8.000 S0.525
+G1 X7.500 S0.352
+G1 X7.000 S0.198
+G1 X6.500 S0.079
+G1 X6.000 S0.012
+G1 X5.500 S0.004
+G1 X5.000 S0.056
+G1 X4.500 S0.162
+G1 X4.000 S0.309
+G1 X3.500 S0.479
+G1 X3.000 S0.652
+G1 X2.500 S0.806
+G1 X2.000 S0.923
+G1 X1.500 S0.989
+G1 X1.000 S0.995
+G1 X0.500 S0.942
+G1 X0.000 S0.835
+G0 X0 Y0
@@ -0,0 +1,44 @@
+; the raster of raster.gcode sent as M660 scan lines, 0.5mm pixels at 300mm/s with the powers in base64
+G21 G90
+G0 X0 Y0
+M660 X0.000 Y0.000 I1 P0.5 N80 F18000
+@q9Lu/f3u0ap+Uy0QAgISL1aCrdPv/fzsz6h8USsPAQMTMViEr9Xw/vzrzqZ6TykOAQMUMlqGsdbx/vzqzKR4TSgNAQQVNFyIs9jy/vvpyqI=
+M660 X40.000 Y0.200 I-1 P0.5 N80
+@dqLK6fv+8tiziFw0FQQBDShNeKTM6vz+8daxhloyFAMBDilPeqbO6/z+8NWvhFgxEwMBDytRfKjP7Pz979OtglYvEgICEC1TfqrR7v397tI=
+M660 X0.000 Y0.400 I1 P0.5 N80
+@/e7Rqn5TLRACAhIvVoKt0+/9/OzPqHxRKw8BAxMxWISv1fD+/OvOpnpPKQ4BAxQyWoax1vH+/OrMpHhNKA0BBBU0XIiz2PL+++nKonZLJgw=
+M660 X40.000 Y0.600 I-1 P0.5 N80
+@AQwmS3aiyun7/vLYs4hcNBUEAQ0oTXikzOr8/vHWsYZaMhQDAQ4pT3qmzuv8/vDVr4RYMRMDAQ8rUXyoz+z8/e/TrYJWLxICAhAtU36q0e4=
+M660 X0.000 Y0.800 I1 P0.5 N80
+@flMtEAICEi9Wgq3T7/387M+ofFErDwEDEzFYhK/V8P78686mek8pDgEDFDJahrHW8f786sykeE0oDQEEFTRciLPY8v776cqidksmDAEEFzY=
+M660 X40.000 Y1.000 I-1 P0.5 N80
+@XjYXBAEMJkt2osrp+/7y2LOIXDQVBAENKE14pMzq/P7x1rGGWjIUAwEOKU96ps7r/P7w1a+EWDETAwEPK1F8qM/s/P3v062CVi8SAgIQLVM=
+M660 X0.000 Y1.200 I1 P0.5 N80
+@AgISL1aCrdPv/fzsz6h8USsPAQMTMViEr9Xw/vzrzqZ6TykOAQMUMlqGsdbx/vzqzKR4TSgNAQQVNFyIs9jy/vvpyqJ2SyYMAQQXNl6Ktdo=
+M660 X40.000 Y1.400 I-1 P0.5 N80
+@89q1il42FwQBDCZLdqLK6fv+8tiziFw0FQQBDShNeKTM6vz+8daxhloyFAMBDilPeqbO6/z+8NWvhFgxEwMBDytRfKjP7Pz979OtglYvEgI=
+M660 X0.000 Y1.600 I1 P0.5 N80
+@VoKt0+/9/OzPqHxRKw8BAxMxWISv1fD+/OvOpnpPKQ4BAxQyWoax1vH+/OrMpHhNKA0BBBU0XIiz2PL+++nKonZLJgwBBBc2Xoq12vP+++g=
+M660 X40.000 Y1.800 I-1 P0.5 N80
+@yOj7/vPatYpeNhcEAQwmS3aiyun7/vLYs4hcNBUEAQ0oTXikzOr8/vHWsYZaMhQDAQ4pT3qmzuv8/vDVr4RYMRMDAQ8rUXyoz+z8/e/TrYI=
+M660 X0.000 Y2.000 I1 P0.5 N80
+@7/387M+ofFErDwEDEzFYhK/V8P78686mek8pDgEDFDJahrHW8f786sykeE0oDQEEFTRciLPY8v776cqidksmDAEEFzZeirXa8/776MigdEk=
+M660 X40.000 Y2.200 I-1 P0.5 N80
+@JUl0oMjo+/7z2rWKXjYXBAEMJkt2osrp+/7y2LOIXDQVBAENKE14pMzq/P7x1rGGWjIUAwEOKU96ps7r/P7w1a+EWDETAwEPK1F8qM/s/P0=
+M660 X0.000 Y2.400 I1 P0.5 N80
+@z6h8USsPAQMTMViEr9Xw/vzrzqZ6TykOAQMUMlqGsdbx/vzqzKR4TSgNAQQVNFyIs9jy/vvpyqJ2SyYMAQQXNl6Ktdrz/vvoyKB0SSULAQU=
+M660 X40.000 Y2.600 I-1 P0.5 N80
+@GAUBCyVJdKDI6Pv+89q1il42FwQBDCZLdqLK6fv+8tiziFw0FQQBDShNeKTM6vz+8daxhloyFAMBDilPeqbO6/z+8NWvhFgxEwMBDytRfKg=
+M660 X0.000 Y2.800 I1 P0.5 N80
+@Kw8BAxMxWISv1fD+/OvOpnpPKQ4BAxQyWoax1vH+/OrMpHhNKA0BBBU0XIiz2PL+++nKonZLJgwBBBc2Xoq12vP+++jIoHRJJQsBBRg4YIw=
+M660 X40.000 Y3.000 I-1 P0.5 N80
+@t4xgOBgFAQslSXSgyOj7/vPatYpeNhcEAQwmS3aiyun7/vLYs4hcNBUEAQ0oTXikzOr8/vHWsYZaMhQDAQ4pT3qmzuv8/vDVr4RYMRMDAQ8=
+M660 X0.000 Y3.200 I1 P0.5 N80
+@EzFYhK/V8P78686mek8pDgEDFDJahrHW8f786sykeE0oDQEEFTRciLPY8v776cqidksmDAEEFzZeirXa8/776MigdEklCwEFGDhgjLfb9P8=
+M660 X40.000 Y3.400 I-1 P0.5 N80
+@+v/027eMYDgYBQELJUl0oMjo+/7z2rWKXjYXBAEMJkt2osrp+/7y2LOIXDQVBAENKE14pMzq/P7x1rGGWjIUAwEOKU96ps7r/P7w1a+EWDE=
+M660 X0.000 Y3.600 I1 P0.5 N80
+@r9Xw/vzrzqZ6TykOAQMUMlqGsdbx/vzqzKR4TSgNAQQVNFyIs9jy/vvpyqJ2SyYMAQQXNl6Ktdrz/vvoyKB0SSULAQUYOGCMt9v0//rnxp4=
+M660 X40.000 Y3.800 I-1 P0.5 N80
+@cZ7G5/r/9Nu3jGA4GAUBCyVJdKDI6Pv+89q1il42FwQBDCZLdqLK6fv+8tiziFw0FQQBDShNeKTM6vz+8daxhloyFAMBDilPeqbO6/z+8NU=
+G0 X0 Y0
@@ -0,0 +1,11 @@
+; the planner queue resized between moves, M398 waits for the queue to drain first
+G21
+G90
+G1 X20 Y10 F6000
+G1 X30 Y-10
+M398 S8
+G2 X30 Y10 I0 J10
+G1 X0 Y0 F3000
+M398 S0
+G1 X40 Y20 F6000
+G0 X0 Y0
@@ -0,0 +1,18 @@
+; input shaping changed between moves with M593, short back and forth moves near the shaper frequencies
+G21
+G90
+G1 X20 Y0 F6000
+G1 X0 Y20
+G1 X20 Y20
+M593 A60 S1
+G1 X0 Y0
+G1 X5 Y0
+G1 X0 Y0
+G1 X5 Y5
+M593 A0
+G1 X30 Y10
+M593 A45 S3 D0.15
+M593 B38 S2
+G1 X0 Y0 F12000
+G1 X1 Y1
+G1 X0 Y0
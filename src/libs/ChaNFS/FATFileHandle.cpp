@@ -32,11 +32,13 @@ static const char *FR_ERRORS[] = {
 
 FATFileHandle::FATFileHandle(FIL_t fh) {
     _fh = fh;
+    _clmt = NULL;
 }
     
 int FATFileHandle::close() {
     FFSDEBUG("close\n");
     int retval = f_close(&_fh);
+    free(_clmt);
     delete this;
     return retval;
 }
@@ -99,4 +101,35 @@ off_t FATFileHandle::flen() {
     return _fh.fsize;
 }
 
+// The map is two words for each run of consecutive clusters, a file copied onto a card in one go is one or a few runs.
+// It is tried small and made as big as FatFs says it needs, up to FASTSEEK_MAX_TABLE words. A file too fragmented
+// for that, or written to, is left to follow the FAT
+bool FATFileHandle::map_clusters() {
+    if(_clmt != NULL) return true;
+    if(_fh.flag & FA_WRITE) return false;
+
+    DWORD size = 2 + 2 * 4;
+    for(;;) {
+        DWORD *tbl = (DWORD *)malloc(size * sizeof(DWORD));
+        if(tbl == NULL) return false;
+        tbl[0] = size;
+        _fh.cltbl = tbl;
+        FRESULT res = f_lseek(&_fh, CREATE_LINKMAP);
+        if(res == FR_OK) {
+            FFSDEBUG("map_clusters %d words\n", tbl[0]);
+            _clmt = tbl;
+            return true;
+        }
+
+        _fh.cltbl = NULL;
+        DWORD needed = tbl[0];
+        free(tbl);
+        if(res != FR_NOT_ENOUGH_CORE || needed > FASTSEEK_MAX_TABLE) {
+            FFSDEBUG("map_clusters failed (%d, %d words)\n", res, needed);
+            return false;
+        }
+        size = needed;
+    }
+}
+
 } // namespace mbed
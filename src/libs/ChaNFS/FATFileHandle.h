@@ -22,9 +22,13 @@ public:
     virtual int fsync();
     virtual off_t flen();
 
+    // builds the cluster link map, so seeking and reading never follow the FAT chain. Read only files only
+    bool map_clusters();
+
 protected:
 
     FIL_t _fh;
+    DWORD *_clmt;
 
 };
 
@@ -95,7 +95,11 @@ FileHandle *FATFileSystem::open(const char* name, int flags) {
     if(flags & O_APPEND) {
         f_lseek(&fh, fh.fsize);
     }
-    return new FATFileHandle(fh);
+    FATFileHandle *handle = new FATFileHandle(fh);
+    if(flags & O_FASTSEEK) {
+        handle->map_clusters();
+    }
+    return handle;
 }
 
 int FATFileSystem::remove(const char *filename) {
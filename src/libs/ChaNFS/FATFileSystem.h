@@ -24,6 +24,12 @@
 #include "ff.h"
 #include "diskio.h"
 
+// open() flag that maps the clusters of a read only file when it is opened, see FATFileHandle::map_clusters
+#define O_FASTSEEK 0x40000000
+
+// the most words a cluster map may take
+#define FASTSEEK_MAX_TABLE 512
+
 namespace mbed {
 /* Class: FATFileSystem
  * The class itself
@@ -52,6 +58,19 @@ public:
     virtual int disk_status() { return 0; }
     virtual int disk_read(char *buffer, int sector) = 0;
     virtual int disk_write(const char *buffer, int sector) = 0;
+    // runs of sectors, a disk that can move them in one go overrides these
+    virtual int disk_read_sectors(char *buffer, int sector, int count) {
+        for(int i = 0; i < count; i++) {
+            if(disk_read(buffer + i * 512, sector + i)) return 1;
+        }
+        return 0;
+    }
+    virtual int disk_write_sectors(const char *buffer, int sector, int count) {
+        for(int i = 0; i < count; i++) {
+            if(disk_write(buffer + i * 512, sector + i)) return 1;
+        }
+        return 0;
+    }
     virtual int disk_sync() { return 0; }
     virtual int disk_sectors() = 0;
 
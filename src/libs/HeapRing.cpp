@@ -13,6 +13,7 @@ template<class kind> HeapRing<kind>::HeapRing()
     head_i = tail_i = length = 0;
     isr_tail_i = tail_i;
     ring = NULL;
+    owned = false;
 }
 
 template<class kind> HeapRing<kind>::HeapRing(unsigned int length)
@@ -20,6 +21,7 @@ template<class kind> HeapRing<kind>::HeapRing(unsigned int length)
     head_i = tail_i = 0;
     isr_tail_i = tail_i;
     ring = new kind[length];
+    owned = true;
     // TODO: handle allocation failure
     this->length = length;
 }
@@ -32,7 +34,7 @@ template<class kind> HeapRing<kind>::~HeapRing()
 {
     head_i = tail_i = length = 0;
     isr_tail_i = tail_i;
-    if (ring)
+    if (ring && owned)
         delete [] ring;
     ring = NULL;
 }
@@ -162,11 +164,11 @@ template<class kind> bool HeapRing<kind>::resize(unsigned int length)
 
             if (is_empty()) // check again in case something was pushed
             {
-                head_i = tail_i = this->length = 0;
+                head_i = tail_i = isr_tail_i = this->length = 0;
 
                 __enable_irq();
 
-                if (ring)
+                if (ring && owned)
                     delete [] ring;
                 ring = NULL;
 
@@ -184,18 +186,20 @@ template<class kind> bool HeapRing<kind>::resize(unsigned int length)
         if (newring != NULL)
         {
             kind* oldring = ring;
+            bool oldowned = owned;
 
             __disable_irq();
 
             if (is_empty()) // check again in case something was pushed while malloc did its thing
             {
                 ring = newring;
+                owned = true;
                 this->length = length;
-                head_i = tail_i = 0;
+                head_i = tail_i = isr_tail_i = 0;
 
                 __enable_irq();
 
-                if (oldring)
+                if (oldring && oldowned)
                     delete [] oldring;
 
                 return true;
@@ -217,16 +221,18 @@ template<class kind> bool HeapRing<kind>::provide(kind* buffer, unsigned int len
     if (is_empty())
     {
         kind* oldring = ring;
+        bool oldowned = owned;
 
         if ((buffer != NULL) && (length > 0))
         {
             ring = buffer;
+            owned = false;
             this->length = length;
-            head_i = tail_i = 0;
+            head_i = tail_i = isr_tail_i = 0;
 
             __enable_irq();
 
-            if (oldring)
+            if (oldring && oldowned)
                 delete [] oldring;
             return true;
         }
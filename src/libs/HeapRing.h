@@ -51,6 +51,7 @@ public:
      * int length - number of items in buffer (NOT size in bytes!)
      *
      * cause HeapRing to use a specific memory location instead of allocating its own
+     * the buffer stays owned by the caller, HeapRing will not delete it
      *
      * returns true on success, or false if queue is not empty
      */
@@ -78,6 +79,7 @@ protected:
 
 private:
     kind* ring;
+    bool owned; // ring was allocated by us
 };
 
 #endif /* _HEAPRING_H */
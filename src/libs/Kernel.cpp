@@ -18,6 +18,7 @@
 
 #include "libs/StepTicker.h"
 #include "libs/PublicData.h"
+#include "libs/Profiler.h"
 #include "modules/communication/SerialConsole.h"
 #include "modules/communication/GcodeDispatch.h"
 #include "modules/robot/Planner.h"
@@ -40,6 +41,7 @@
 
 #define base_stepping_frequency_checksum            CHECKSUM("base_stepping_frequency")
 #define microseconds_per_step_pulse_checksum        CHECKSUM("microseconds_per_step_pulse")
+#define step_event_scheduling_checksum              CHECKSUM("step_event_scheduling")
 #define disable_leds_checksum                       CHECKSUM("leds_disable")
 #define grbl_mode_checksum                          CHECKSUM("grbl_mode")
 #define ok_per_line_checksum                        CHECKSUM("ok_per_line")
@@ -122,7 +124,8 @@ Kernel::Kernel(){
     NVIC_SetPriority(TIMER0_IRQn, 2);
     NVIC_SetPriority(TIMER1_IRQn, 1);
     NVIC_SetPriority(TIMER2_IRQn, 4);
-    NVIC_SetPriority(PendSV_IRQn, 3);
+    // PendSV refills the step segments, the lowest priority so it only ever holds up the main loop
+    NVIC_SetPriority(PendSV_IRQn, 31);
 
     // Set other priorities lower than the timers
     NVIC_SetPriority(ADC_IRQn, 5);
@@ -148,6 +151,7 @@ Kernel::Kernel(){
     // Configure the step ticker
     this->step_ticker->set_frequency( this->base_stepping_frequency );
     this->step_ticker->set_unstep_time( microseconds_per_step_pulse );
+    this->step_ticker->set_event_scheduling( this->config->value(step_event_scheduling_checksum)->by_default(false)->as_bool() );
 
     // Core modules
     this->add_module( this->conveyor       = new Conveyor()      );
@@ -175,6 +179,8 @@ std::string Kernel::get_query_string()
         str.append("Home,");
     }else if(feed_hold) {
         str.append("Hold,");
+        // stopped part way through a block so the last milestone is not where it is
+        running= !this->conveyor->is_idle();
     }else if(this->conveyor->is_idle()) {
         str.append("Idle,");
     }else{
@@ -236,8 +242,12 @@ void Kernel::call_event(_EVENT_ENUM id_event, void * argument){
     }
 
     // send to all registered modules
-    for (auto m : hooks[id_event]) {
-        (m->*kernel_callback_functions[id_event])(argument);
+    if(Profiler::is_enabled()) {
+        Profiler::call_event(id_event, hooks[id_event], argument);
+    } else {
+        for (auto m : hooks[id_event]) {
+            (m->*kernel_callback_functions[id_event])(argument);
+        }
     }
 
     if(id_event == ON_HALT && this->halted && !was_idle) {
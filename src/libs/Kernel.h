@@ -51,8 +51,9 @@ class Kernel {
         bool is_grbl_mode() const { return grbl_mode; }
         bool is_ok_per_line() const { return ok_per_line; }
 
-        // void set_feed_hold(bool f) { feed_hold= f; }
-        // bool get_feed_hold() const { return feed_hold; }
+        // a feed hold ramps the motion down to a stop and holds it there until it is released, see Conveyor
+        void set_feed_hold(bool f) { feed_hold= f; }
+        bool get_feed_hold() const { return feed_hold; }
 
         std::string get_query_string();
 
@@ -74,6 +75,8 @@ class Kernel {
         std::string       current_path;
         uint32_t          base_stepping_frequency;
 
+        friend class Profiler; // for hooks
+
     private:
         // When a module asks to be called for a specific event ( a hook ), this is where that request is remembered
         std::array<std::vector<Module*>, NUMBER_OF_DEFINED_EVENTS> hooks;
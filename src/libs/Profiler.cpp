@@ -0,0 +1,115 @@
+/*
+      This file is part of Smoothie (http://smoothieware.org/). The motion control part is heavily based on Grbl (https://github.com/simen/grbl).
+      Smoothie is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+      Smoothie is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+      You should have received a copy of the GNU General Public License along with Smoothie. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "Profiler.h"
+#include "Kernel.h"
+#include "StreamOutput.h"
+
+#include "system_LPC17xx.h" // for SystemCoreClock
+#include <stdio.h>
+
+volatile bool Profiler::enabled= false;
+Profiler::stats_t Profiler::sections[NUMBER_OF_SECTIONS];
+std::array<std::vector<Profiler::hook_stats_t>, NUMBER_OF_DEFINED_EVENTS> Profiler::hook_stats;
+
+static const char *section_names[Profiler::NUMBER_OF_SECTIONS] = {
+    "step_tick", "unstep_tick", "slow_tick", "append_block", "replan"
+};
+
+// in the same order as _EVENT_ENUM
+static const char *event_names[NUMBER_OF_DEFINED_EVENTS] = {
+    "on_main_loop", "on_console_line_received", "on_gcode_received", "on_idle", "on_second_tick",
+    "on_get_public_data", "on_set_public_data", "on_halt", "on_enable"
+};
+
+void Profiler::enable(bool on)
+{
+    if(on && !enabled) {
+        // the cycle counter is part of the debug unit, which is off unless a debugger turned it on
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CYCCNT = 0;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+        reset();
+    }
+    enabled= on;
+}
+
+void Profiler::reset()
+{
+    // an ON_SECOND_TICK from the slow ticker interrupt must not add to the hook stats while they are rebuilt
+    bool was_enabled= enabled;
+    enabled= false;
+
+    for (auto& s : sections) clear(s);
+    for (int e = 0; e < NUMBER_OF_DEFINED_EVENTS; ++e) {
+        hook_stats[e].clear();
+        hook_stats[e].shrink_to_fit();
+        for (auto m : THEKERNEL->hooks[e]) {
+            hook_stats[e].push_back({m, {}});
+            clear(hook_stats[e].back().stats);
+        }
+    }
+    enabled= was_enabled;
+}
+
+void Profiler::clear(stats_t& st)
+{
+    st.count= 0;
+    st.min= UINT32_MAX;
+    st.max= 0;
+    st.total= 0;
+}
+
+void Profiler::add(stats_t& st, uint32_t c)
+{
+    ++st.count;
+    if(c < st.min) st.min= c;
+    if(c > st.max) st.max= c;
+    st.total += c;
+}
+
+void Profiler::call_event(_EVENT_ENUM id_event, const std::vector<Module*>& hooks, void *argument)
+{
+    std::vector<hook_stats_t>& hs= hook_stats[id_event];
+    for (size_t i = 0; i < hooks.size(); ++i) {
+        Module *m= hooks[i];
+        uint32_t start= cycles();
+        (m->*kernel_callback_functions[id_event])(argument);
+        uint32_t c= cycles() - start;
+        // a module that registered or unregistered since the reset moves the others along, they are not timed until then
+        if(enabled && i < hs.size() && hs[i].module == m) add(hs[i].stats, c);
+    }
+}
+
+static void print_stats(StreamOutput *stream, const Profiler::stats_t& st)
+{
+    float us= 1e6F / SystemCoreClock;
+    stream->printf("%8lu %8lu %8lu %10.1f %8.1f\n", (unsigned long)st.count, (unsigned long)st.min, (unsigned long)st.max,
+        (double)st.total / st.count, st.max * us);
+}
+
+void Profiler::dump(StreamOutput *stream)
+{
+    stream->printf("profiling is %s, cycles at %lu MHz\n", enabled ? "on" : "off", (unsigned long)(SystemCoreClock / 1000000));
+    stream->printf("%-40s %8s %8s %8s %10s %8s\n", "", "count", "min", "max", "mean", "max us");
+    for (int s = 0; s < NUMBER_OF_SECTIONS; ++s) {
+        if(sections[s].count == 0) continue;
+        stream->printf("%-40s ", section_names[s]);
+        print_stats(stream, sections[s]);
+    }
+
+    // there are no class names without RTTI, the vtable address finds the module in the map file
+    for (int e = 0; e < NUMBER_OF_DEFINED_EVENTS; ++e) {
+        for (auto& h : hook_stats[e]) {
+            if(h.stats.count == 0) continue;
+            char name[41];
+            snprintf(name, sizeof(name), "%s %p", event_names[e], *reinterpret_cast<void **>(h.module));
+            stream->printf("%-40s ", name);
+            print_stats(stream, h.stats);
+        }
+    }
+}
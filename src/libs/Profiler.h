@@ -0,0 +1,80 @@
+/*
+      This file is part of Smoothie (http://smoothieware.org/). The motion control part is heavily based on Grbl (https://github.com/simen/grbl).
+      Smoothie is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+      Smoothie is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+      You should have received a copy of the GNU General Public License along with Smoothie. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "Module.h"
+#include "LPC17xx.h"
+
+#include <stdint.h>
+#include <array>
+#include <vector>
+
+class StreamOutput;
+
+// Counts the CPU cycles spent in the step and slow ticker interrupts, the planner and every module's event handlers,
+// read from the DWT cycle counter. Turned on and reported with the profile console command, when it is off each
+// profiled place costs one test of the enabled flag.
+// The times are inclusive, an event handler that waits on the queue is charged with the ON_IDLE calls it makes while
+// waiting and everything but the step ticker is charged with the interrupts that came in while it ran.
+class Profiler {
+    public:
+        enum SECTION {
+            STEP_TICK,
+            UNSTEP_TICK,
+            SLOW_TICK,
+            APPEND_BLOCK,   // up to queueing the block, not the wait for room in the queue
+            REPLAN,         // the batched replan of planner_batch_size blocks
+            NUMBER_OF_SECTIONS
+        };
+
+        using stats_t = struct {
+            uint32_t count;
+            uint32_t min;
+            uint32_t max;
+            uint64_t total;
+        };
+
+        // times a section from construction until stop() or it goes out of scope
+        class Scope {
+            public:
+                Scope(SECTION s) : section(s), running(enabled) { if(running) start= cycles(); }
+                ~Scope() { stop(); }
+                void stop() { if(running) { add(section, cycles() - start); running= false; } }
+
+            private:
+                SECTION section;
+                bool running;
+                uint32_t start;
+        };
+
+        static void enable(bool on);
+        static bool is_enabled() { return enabled; }
+        static void reset();
+        static void dump(StreamOutput *stream);
+
+        // calls the hooks of an event, timing each module, only used by Kernel::call_event when enabled
+        static void call_event(_EVENT_ENUM id_event, const std::vector<Module*>& hooks, void *argument);
+
+        static uint32_t cycles() { return DWT->CYCCNT; }
+        static void add(SECTION s, uint32_t c) { add(sections[s], c); }
+
+    private:
+        static void add(stats_t& st, uint32_t c);
+        static void clear(stats_t& st);
+
+        using hook_stats_t = struct {
+            Module *module;
+            stats_t stats;
+        };
+
+        static volatile bool enabled;
+        static stats_t sections[NUMBER_OF_SECTIONS];
+        // one per hook in the same order as the kernel's, made when profiling is turned on so nothing is allocated
+        // while an event is running. Modules that register after that are not timed until the next reset
+        static std::array<std::vector<hook_stats_t>, NUMBER_OF_DEFINED_EVENTS> hook_stats;
+};
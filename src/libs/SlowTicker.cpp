@@ -15,6 +15,7 @@ using namespace std;
 #include "libs/Hook.h"
 #include "modules/robot/Conveyor.h"
 #include "Gcode.h"
+#include "Profiler.h"
 
 #include <mri.h>
 
@@ -60,6 +61,7 @@ void SlowTicker::set_frequency( int frequency ){
 
 // The actual interrupt being called by the timer, this is where work is done
 void SlowTicker::tick(){
+    Profiler::Scope profile(Profiler::SLOW_TICK);
 
     // Call all hooks that need to be called
     for (Hook* hook : this->hooks){
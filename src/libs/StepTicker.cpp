@@ -15,9 +15,11 @@
 #include "StreamOutputPool.h"
 #include "Block.h"
 #include "Conveyor.h"
+#include "Profiler.h"
 
 #include "system_LPC17xx.h" // mbed.h lib
 #include <math.h>
+#include <algorithm>
 #include <mri.h>
 
 #ifdef STEPTICKER_DEBUG_PIN
@@ -53,6 +55,10 @@ StepTicker::StepTicker()
     this->num_motors = 0;
 
     this->running = false;
+    this->event_scheduling = false;
+    this->segment_mode = false;
+    this->segment_active = false;
+    this->block_abandoned = false;
     this->current_block = nullptr;
 
     #ifdef STEPTICKER_DEBUG_PIN
@@ -79,6 +85,9 @@ void StepTicker::set_frequency( float frequency )
 {
     this->frequency = frequency;
     this->period = floorf((SystemCoreClock / 4.0F) / frequency); // SystemCoreClock/4 = Timer increments in a second
+    // when event scheduling, wake up at least every 1ms while running and poll for new blocks every 100us when idle
+    this->max_event_ticks = std::max(1.0F, floorf(frequency / 1000.0F));
+    this->idle_event_ticks = std::max(1.0F, floorf(frequency / 10000.0F));
     LPC_TIM0->MR0 = this->period;
     LPC_TIM0->TCR = 3;  // Reset
     LPC_TIM0->TCR = 1;  // start
@@ -93,9 +102,110 @@ void StepTicker::set_unstep_time( float microseconds )
     // TODO check that the unstep time is less than the step period, if not slow down step ticker
 }
 
+// In event scheduling mode the timer is not fired on every tick, instead it is loaded with the number of ticks until
+// the next tick where any motor steps or changes acceleration, the ticks in between are skipped in one go.
+// The steps are issued on exactly the same ticks as the fixed rate, so the frequency can be raised to get a finer
+// step resolution and higher step rates without raising the interrupt rate
+void StepTicker::set_event_scheduling(bool flg)
+{
+    this->event_scheduling = flg;
+}
+
+// The time scale slows down or stops the stepping without touching the blocks, every timer interval is divided by it
+// as it is loaded so it takes effect on the next step event. Ramping it is left to the caller (see Conveyor)
+void StepTicker::set_time_scale(float s)
+{
+    time_scale = s;
+    // anything below 1/1024 is a hold, slower than that the next event could be a long way off when it is raised again
+    bool held = s < 1.0F / 1024;
+    interval_scale = held ? 0 : (uint32_t)roundf(65536.0F / s);
+    time_scale_q16 = held ? 0 : (uint32_t)roundf(65536.0F * s);
+}
+
+// timer counts stretched by the time scale. A scale ramping up from a hold starts out tiny, so an interval stretched
+// past the idle interval is split and the rest of it is left in stretch_left, to be stretched by whatever the scale is
+// when the timer next fires
+inline uint32_t StepTicker::scale_interval(uint32_t counts)
+{
+    uint32_t s = interval_scale;
+    stretch_left = 0;
+    if(s == (1 << 16)) return counts;
+    uint32_t max_counts = idle_event_ticks * period;
+    uint64_t t = ((uint64_t)counts * s) >> 16;
+    if(t <= max_counts) return t;
+    // the unscaled counts that run in that time, at least one so it always gets somewhere
+    uint32_t done = ((uint64_t)max_counts * time_scale_q16) >> 16;
+    if(done == 0) done = 1;
+    stretch_left = (done < counts) ? counts - done : 1;
+    return max_counts;
+}
+
+// the speed the current block is planned to be going at now as a fraction of its nominal speed, before the time scale
+// is applied, 0 when nothing is being stepped. Read from idle context, so it can be a step event out of date
+float StepTicker::get_planned_speed() const
+{
+    const Block *b = current_block;
+    if(b == nullptr || !running) return 0;
+    if(segment_mode) return segment_active ? segment.speed / 256.0F : 0;
+
+    const Block::trapezoid_t *tp = current_trapezoid;
+    if(tp == nullptr || b->nominal_rate <= 0) return 0;
+    // the nominal rate is the rate of the motor with the most steps
+    uint8_t lead = 0;
+    for (uint8_t m = 1; m < num_motors; m++) {
+        if(b->steps[m] > b->steps[lead]) lead = m;
+    }
+    int32_t spt = tp->tick_info[lead].steps_per_tick;
+    return spt > 0 ? STEPTICKER_FROMFP(spt) * frequency / b->nominal_rate : 0;
+}
+
+// The speed reports let the laser follow the actual speed, the segments carry their own speed and in the fixed tick
+// modes it comes from the lead motor's steps per tick, this is the factor that turns that into the fraction of nominal
+// the raster pixels are counted on the same lead motor
+void StepTicker::start_speed_report()
+{
+    lead_motor = 0;
+    for (uint8_t m = 1; m < num_motors; m++) {
+        if(current_block->steps[m] > current_block->steps[lead_motor]) lead_motor = m;
+    }
+    float nominal = current_block->nominal_rate / frequency * STEPTICKER_FPSCALE; // lead motor steps per tick in 2.30
+    speed_factor = (nominal >= 256) ? (uint32_t)std::min(256.0F * 4294967296.0F / nominal, 4294967040.0F) : 0;
+    raster_steps = 0;
+    raster_pixel = 0;
+}
+
+// calls speed_fnc if the speed, the block or the raster pixel has changed, speed is the planned speed in 8.8 and is scaled by the time scale
+inline void StepTicker::report_speed(uint32_t speed)
+{
+    speed = ((uint64_t)speed * time_scale_q16) >> 16;
+    if(speed == reported_speed && current_block == reported_block && raster_pixel == reported_pixel) return;
+    reported_speed = speed;
+    reported_block = current_block;
+    reported_pixel = raster_pixel;
+    speed_fnc(current_block, speed / 256.0F, raster_pixel);
+}
+
+void StepTicker::report_stopped()
+{
+    if(reported_block == nullptr && reported_speed == 0) return;
+    reported_block = nullptr;
+    reported_speed = 0;
+    reported_pixel = 0;
+    speed_fnc(nullptr, 0, 0);
+}
+
+// the pixel of the current raster block the laser is on after lead_steps steps of the lead motor
+inline void StepTicker::set_raster_pixel(uint32_t lead_steps)
+{
+    const Block::raster_t *r = current_block->raster;
+    uint32_t p = ((uint64_t)lead_steps * r->pixels_per_step) >> 24;
+    raster_pixel = (p < r->power.size()) ? p : r->power.size() - 1;
+}
+
 // Reset step pins on any motor that was stepped
 void StepTicker::unstep_tick()
 {
+    Profiler::Scope profile(Profiler::UNSTEP_TICK);
     for (int i = 0; i < num_motors; i++) {
         if(this->unstep[i]) {
             this->motor[i]->unstep();
@@ -123,15 +233,49 @@ extern "C" void PendSV_Handler(void)
     StepTicker::getInstance()->handle_finish();
 }
 
-// slightly lower priority than TIMER0, the whole end of block/start of block is done here allowing the timer to continue ticking
+// the lowest priority, the whole end of block/start of block is done here allowing the timer to continue ticking
 void StepTicker::handle_finish (void)
 {
     // all moves finished signal block is finished
     if(finished_fnc) finished_fnc();
+    if(refill_fnc) refill_fnc();
+}
+
+// NVIC_SetPendingIRQ() only works for the peripheral interrupts, PendSV is pended through the ICSR
+void StepTicker::request_refill()
+{
+    SCB->ICSR = 0x10000000; // SCB_ICSR_PENDSVSET_Msk
 }
 
 // step clock
 void StepTicker::step_tick (void)
+{
+    Profiler::Scope profile(Profiler::STEP_TICK);
+    if(interval_scale == 0 && !THEKERNEL->is_halted()) {
+        // feed hold, this tick is put off until the time scale is raised again so no step is lost
+        if(speed_fnc && current_block != nullptr) report_speed(0);
+        LPC_TIM0->MR0 = idle_event_ticks * period;
+        return;
+    }
+
+    if(stretch_left > 0 && !THEKERNEL->is_halted()) {
+        // part way through a stretched interval
+        LPC_TIM0->MR0 = scale_interval(stretch_left);
+        return;
+    }
+
+    if(segment_mode) {
+        segment_tick();
+        return;
+    }
+
+    process_tick();
+    if(event_scheduling) schedule_next_event();
+    else LPC_TIM0->MR0 = scale_interval(period);
+}
+
+// one tick of the step clock, issues any steps that are due this tick
+inline void StepTicker::process_tick()
 {
     //SET_STEPTICKER_DEBUG_PIN(running ? 1 : 0);
 
@@ -150,53 +294,56 @@ void StepTicker::step_tick (void)
         running= false;
         current_tick = 0;
         current_block= nullptr;
+        if(speed_fnc) report_stopped();
         return;
     }
 
     bool still_moving= false;
+    Block::trapezoid_t *tp= current_trapezoid;
     // foreach motor, if it is active see if time to issue a step to that motor
     for (uint8_t m = 0; m < num_motors; m++) {
-        if(current_block->tick_info[m].steps_to_move == 0) continue; // not active
+        Block::tickinfo_t &ti= tp->tick_info[m];
+        if(ti.steps_to_move == 0) continue; // not active
 
-        current_block->tick_info[m].steps_per_tick += current_block->tick_info[m].acceleration_change;
+        ti.steps_per_tick += ti.acceleration_change;
 
-        if(current_tick == current_block->tick_info[m].next_accel_event) {
-            if(current_tick == current_block->accelerate_until) { // We are done accelerating, deceleration becomes 0 : plateau
-                current_block->tick_info[m].acceleration_change = 0;
-                if(current_block->decelerate_after < current_block->total_move_ticks) {
-                    current_block->tick_info[m].next_accel_event = current_block->decelerate_after;
-                    if(current_tick != current_block->decelerate_after) { // We are plateauing
+        if(current_tick == ti.next_accel_event) {
+            if(current_tick == tp->accelerate_until) { // We are done accelerating, deceleration becomes 0 : plateau
+                ti.acceleration_change = 0;
+                if(tp->decelerate_after < tp->total_move_ticks) {
+                    ti.next_accel_event = tp->decelerate_after;
+                    if(current_tick != tp->decelerate_after) { // We are plateauing
                         // steps/sec / tick frequency to get steps per tick
-                        current_block->tick_info[m].steps_per_tick = current_block->tick_info[m].plateau_rate;
+                        ti.steps_per_tick = ti.plateau_rate;
                     }
                 }
             }
 
-            if(current_tick == current_block->decelerate_after) { // We start decelerating
-                current_block->tick_info[m].acceleration_change = current_block->tick_info[m].deceleration_change;
+            if(current_tick == tp->decelerate_after) { // We start decelerating
+                ti.acceleration_change = ti.deceleration_change;
             }
         }
 
         // protect against rounding errors and such
-        if(current_block->tick_info[m].steps_per_tick <= 0) {
-            current_block->tick_info[m].counter = STEPTICKER_FPSCALE; // we force completion this step by setting to 1.0
-            current_block->tick_info[m].steps_per_tick = 0;
+        if(ti.steps_per_tick <= 0) {
+            ti.counter = STEPTICKER_FPSCALE; // we force completion this step by setting to 1.0
+            ti.steps_per_tick = 0;
         }
 
-        current_block->tick_info[m].counter += current_block->tick_info[m].steps_per_tick;
+        ti.counter += ti.steps_per_tick;
 
-        if(current_block->tick_info[m].counter >= STEPTICKER_FPSCALE) { // >= 1.0 step time
-            current_block->tick_info[m].counter -= STEPTICKER_FPSCALE; // -= 1.0F;
-            ++current_block->tick_info[m].step_count;
+        if(ti.counter >= STEPTICKER_FPSCALE) { // >= 1.0 step time
+            ti.counter -= STEPTICKER_FPSCALE; // -= 1.0F;
+            ++ti.step_count;
 
             // step the motor
             bool ismoving= motor[m]->step(); // returns false if the moving flag was set to false externally (probes, endstops etc)
             // we stepped so schedule an unstep
             unstep.set(m);
 
-            if(!ismoving || current_block->tick_info[m].step_count == current_block->tick_info[m].steps_to_move) {
+            if(!ismoving || ti.step_count == ti.steps_to_move) {
                 // done
-                current_block->tick_info[m].steps_to_move = 0;
+                ti.steps_to_move = 0;
                 motor[m]->stop_moving(); // let motor know it is no longer moving
             }
         }
@@ -208,6 +355,12 @@ void StepTicker::step_tick (void)
     // do this after so we start at tick 0
     current_tick++; // count number of ticks
 
+    if(speed_fnc) {
+        if(current_block->raster != nullptr) set_raster_pixel(tp->tick_info[lead_motor].step_count);
+        int32_t spt = tp->tick_info[lead_motor].steps_per_tick;
+        report_speed(spt > 0 ? ((uint64_t)spt * speed_factor) >> 32 : 0);
+    }
+
     // We may have set a pin on in this tick, now we reset the timer to set it off
     // Note there could be a race here if we run another tick before the unsteps have happened,
     // right now it takes about 3-4us but if the unstep were near 10uS or greater it would be an issue
@@ -236,6 +389,7 @@ void StepTicker::step_tick (void)
             current_block= nullptr;
             running= false;
         }
+        if(!running && speed_fnc) report_stopped();
 
         // all moves finished
         // we delegate the slow stuff to the pendsv handler which will run as soon as this interrupt exits
@@ -244,15 +398,238 @@ void StepTicker::step_tick (void)
     }
 }
 
+// returns the number of ticks from current_tick up to and including the next tick where this motor could step or
+// change acceleration. It may be early but is never late, as it assumes the fastest rate that can be reached in that time
+static uint32_t ticks_to_next_event(const Block::tickinfo_t& ti, uint32_t current_tick, uint32_t max_ticks)
+{
+    uint32_t n = max_ticks;
+    if(ti.next_accel_event >= current_tick && ti.next_accel_event - current_tick < n) {
+        n = ti.next_accel_event - current_tick + 1;
+    }
+
+    int32_t spt = ti.steps_per_tick;
+    int32_t acc = ti.acceleration_change;
+    // the rate would drop to zero on the next tick which forces the step
+    if(spt + acc <= 0) return 1;
+
+    if(acc < 0) {
+        // the tick where the rate drops to zero and forces a step
+        uint32_t z = (spt + (-acc) - 1) / (-acc);
+        if(z < n) n = z;
+    }
+
+    uint32_t rem = STEPTICKER_FPSCALE - ti.counter;
+    uint32_t s;
+    if(acc <= 0 || spt > 0) {
+        // fastest rate within the next n ticks, the counter cannot reach 1.0 sooner than at this rate
+        int64_t vmax = (acc > 0) ? (int64_t)spt + (int64_t)acc * n : spt;
+        s = (vmax >= rem) ? 1 : (rem + (uint32_t)vmax - 1) / (uint32_t)vmax;
+
+    } else {
+        // starting from standstill the counter after s ticks is at most acc*(s+1)^2/2
+        float f = sqrtf(2.0F * rem / acc) - 1.0F;
+        s = (f > 1.0F) ? (uint32_t)f : 1;
+    }
+
+    return (s < n) ? s : n;
+}
+
+// load the timer with the next tick that needs processing and skip all the ticks before it
+void StepTicker::schedule_next_event()
+{
+    uint32_t n = idle_event_ticks;
+
+    if(running && current_block != nullptr && !THEKERNEL->is_halted()) {
+        n = max_event_ticks;
+        Block::trapezoid_t *tp = current_trapezoid;
+        for (uint8_t m = 0; m < num_motors; m++) {
+            const Block::tickinfo_t& ti = tp->tick_info[m];
+            if(ti.steps_to_move == 0) continue;
+            uint32_t t = ticks_to_next_event(ti, current_tick, n);
+            if(t < n) n = t;
+        }
+
+        // advance every motor over the skipped ticks, none of them step or hit an acceleration event in that time
+        uint32_t skip = n - 1;
+        if(skip > 0) {
+            int64_t tri = ((int64_t)skip * (skip + 1)) / 2;
+            for (uint8_t m = 0; m < num_motors; m++) {
+                Block::tickinfo_t& ti = tp->tick_info[m];
+                if(ti.steps_to_move == 0) continue;
+                ti.counter += (int32_t)((int64_t)ti.steps_per_tick * skip + (int64_t)ti.acceleration_change * tri);
+                ti.steps_per_tick += ti.acceleration_change * (int32_t)skip;
+            }
+            current_tick += skip;
+        }
+    }
+
+    // the timer resets on match, so if we took longer than the interval set it to fire straight away rather than wrap
+    LPC_TIM0->MR0 = scale_interval(n * period);
+    if(LPC_TIM0->TC >= LPC_TIM0->MR0) {
+        LPC_TIM0->MR0 = LPC_TIM0->TC + 1;
+    }
+}
+
+// In segment mode the timer fires once per step event of the current segment, the segments are constant rate so
+// all that is done here is spread the steps of each motor over the events, there is no acceleration handling
+void StepTicker::segment_tick()
+{
+    if(THEKERNEL->is_halted()) {
+        // throw away everything that was prepared, the blocks are finished as they are removed
+        if(segment_active && segment.last) finish_segment_block();
+        segment_active = false;
+        while(segments.get(segment)) {
+            if(segment.last) finish_segment_block();
+        }
+        current_block = nullptr;
+        running = false;
+        if(speed_fnc) report_stopped();
+        LPC_TIM0->MR0 = idle_event_ticks * period;
+        return;
+    }
+
+    bool was_active = segment_active;
+    if(segment_active) {
+        for (uint8_t m = 0; m < num_motors; m++) {
+            if(segment.steps[m] == 0) continue;
+
+            segment_error[m] += segment.steps[m];
+            if(segment_error[m] >= segment.n_events) {
+                segment_error[m] -= segment.n_events;
+                // the motor may have been stopped externally (probes, endstops etc)
+                if(!motor[m]->is_moving()) continue;
+                motor[m]->step();
+                unstep.set(m);
+                if(m == lead_motor) ++raster_steps;
+            }
+        }
+
+        if(speed_fnc && current_block->raster != nullptr) set_raster_pixel(raster_steps);
+
+        if( unstep.any()) {
+            LPC_TIM1->TCR = 3;
+            LPC_TIM1->TCR = 1;
+        }
+
+        if(++segment_event < segment.n_events) {
+            // same interval for the next event, reloaded in case the time scale changed
+            LPC_TIM0->MR0 = scale_interval(segment.interval);
+            if(speed_fnc) report_speed(segment.speed);
+            return;
+        }
+
+        // segment done
+        segment_active = false;
+        if(segment.last) {
+            finish_segment_block();
+
+        } else {
+            // if all the motors were stopped externally the rest of the block is dropped
+            bool still_moving = false;
+            for (uint8_t m = 0; m < num_motors; m++) {
+                if(segment_started[m] && motor[m]->is_moving()) still_moving = true;
+            }
+            if(segment_started.any() && !still_moving) block_abandoned = true;
+        }
+    }
+
+    if(next_segment()) {
+        LPC_TIM0->MR0 = scale_interval(segment.interval);
+        if(speed_fnc) report_speed(segment.speed);
+        // there is room for another segment, the refill runs once this ISR returns
+        request_refill();
+    } else {
+        LPC_TIM0->MR0 = idle_event_ticks * period;
+        // run dry part way through a block it is stopped there until the next segment turns up, which the refill
+        // from PendSV does not let happen unless the planner is behind
+        if(was_active && current_block != nullptr) ++segment_underruns;
+        if(speed_fnc) {
+            if(current_block != nullptr) report_speed(0);
+            else report_stopped();
+        }
+    }
+}
+
+// fetch the next segment to step out, returns false if none are ready
+bool StepTicker::next_segment()
+{
+    while(segments.get(segment)) {
+        // a block kept going for a shaped tail ends where the next one starts
+        if(current_block != nullptr && segment.block != current_block) finish_segment_block();
+
+        if(segment.n_events == 0) {
+            // the block was discarded by a flush, there is nothing to step
+            if(segment.block == current_block) finish_segment_block();
+            else THECONVEYOR->block_finished();
+            continue;
+        }
+
+        if(segment.block != current_block) {
+            // start of a new block
+            current_block = segment.block;
+            block_abandoned = false;
+            running = true;
+            segment_started.reset();
+            for (uint8_t m = 0; m < num_motors; m++) {
+                if(current_block->steps[m] == 0) continue;
+                motor[m]->set_direction(segment.direction_bits[m]);
+                motor[m]->start_moving();
+                segment_started.set(m);
+            }
+            if(speed_fnc) start_speed_report();
+        }
+
+        if(block_abandoned) {
+            if(segment.last) finish_segment_block();
+            continue;
+        }
+
+        // with input shaping a motor can carry on from the last block or turn around part way through this one
+        for (uint8_t m = 0; m < num_motors; m++) {
+            if(segment.steps[m] == 0) continue;
+            if(motor[m]->which_direction() != segment.direction_bits[m]) motor[m]->set_direction(segment.direction_bits[m]);
+            if(!segment_started[m]) {
+                motor[m]->start_moving();
+                segment_started.set(m);
+            }
+        }
+
+        segment_event = 0;
+        for (uint8_t m = 0; m < num_motors; m++) {
+            segment_error[m] = segment.n_events / 2;
+        }
+        segment_active = true;
+        return true;
+    }
+
+    return false;
+}
+
+void StepTicker::finish_segment_block()
+{
+    if(current_block != nullptr) {
+        for (uint8_t m = 0; m < num_motors; m++) {
+            if(segment_started[m]) motor[m]->stop_moving();
+        }
+    }
+    segment_started.reset();
+    current_block = nullptr;
+    running = false;
+    THECONVEYOR->block_finished();
+}
+
 // only called from the step tick ISR (single consumer)
 bool StepTicker::start_next_block()
 {
     if(current_block == nullptr) return false;
 
+    // the planner may swap in a new trapezoid until the block is taken, this is the one it was taken with
+    current_trapezoid= current_block->trapezoid;
+
     bool ok= false;
     // need to prepare each active motor
     for (uint8_t m = 0; m < num_motors; m++) {
-        if(current_block->tick_info[m].steps_to_move == 0) continue;
+        if(current_trapezoid->tick_info[m].steps_to_move == 0) continue;
 
         ok= true; // mark at least one motor is moving
         // set direction bit here
@@ -266,6 +643,7 @@ bool StepTicker::start_next_block()
 
     if(ok) {
         //SET_STEPTICKER_DEBUG_PIN(1);
+        if(speed_fnc) start_speed_report();
         return true;
 
     }else{
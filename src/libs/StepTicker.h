@@ -17,9 +17,23 @@
 
 #include "ActuatorCoordinates.h"
 #include "TSRingBuffer.h"
+#include "Block.h"
 
 class StepperMotor;
-class Block;
+
+// a short constant rate piece of a block, prepared off the ISR by the StepSegmenter
+// the steps of each motor are spread over n_events evenly spaced step events
+struct step_segment_t {
+    Block *block;                                   // the block this is part of
+    uint32_t interval;                              // timer counts between step events
+    uint16_t n_events;                              // number of step events, 0 marks a discarded block
+    uint16_t speed;                                 // path speed over the block's nominal speed in 8.8 fixed point
+    std::array<uint16_t, k_max_actuators> steps;    // steps for each motor in this segment
+    std::bitset<k_max_actuators> direction_bits;    // direction of each motor in this segment, shaped motors can turn around mid block
+    bool last;                                      // last segment of the block
+};
+
+#define STEP_SEGMENT_BUFFER_SIZE 32
 
 // handle 2.30 Fixed point
 #define STEPTICKER_FPSCALE (1<<30)
@@ -32,10 +46,27 @@ class StepTicker{
         ~StepTicker();
         void set_frequency( float frequency );
         void set_unstep_time( float microseconds );
+        void set_event_scheduling(bool flg);
+        bool is_event_scheduling() const { return event_scheduling; }
+        void set_segment_mode(bool flg) { segment_mode= flg; }
+        bool is_segment_mode() const { return segment_mode; }
+        bool push_segment(const step_segment_t& seg) { return segments.put(seg); }
+        bool is_segment_buffer_full() const { return segments.full(); }
+        size_t get_segment_count() const { return segments.count(); }
+        // pends PendSV so refill_fnc runs as soon as no other interrupt is active, it preempts the main loop
+        void request_refill();
+        // times the segments ran out part way through a block, the motors stop dead there
+        uint32_t get_segment_underruns() const { return segment_underruns; }
         int register_motor(StepperMotor* motor);
         float get_frequency() const { return frequency; }
         void unstep_tick();
         const Block *get_current_block() const { return current_block; }
+        // the trapezoid the current block was taken with, only meaningful while that block is ticking
+        const Block::trapezoid_t *get_current_trapezoid() const { return current_trapezoid; }
+        // stretches the step timing in real time, 1 steps the blocks as planned, 0 holds them where they are
+        void set_time_scale(float s);
+        float get_time_scale() const { return time_scale; }
+        float get_planned_speed() const;
 
         void step_tick (void);
         void handle_finish (void);
@@ -43,6 +74,11 @@ class StepTicker{
 
         // whatever setup the block should register this to know when it is done
         std::function<void()> finished_fnc{nullptr};
+        // called from PendSV to refill the segment buffer, at the lowest priority so it only holds up the main loop
+        std::function<void()> refill_fnc{nullptr};
+        // called from the step ISR when the actual speed changes, with the block being stepped (nullptr once nothing is),
+        // its speed as a fraction of the nominal speed, 1/256 resolution, and on a raster block the pixel the laser is on
+        std::function<void(const Block*, float, uint16_t)> speed_fnc{nullptr};
 
         static StepTicker *getInstance() { return instance; }
 
@@ -50,6 +86,16 @@ class StepTicker{
         static StepTicker *instance;
 
         bool start_next_block();
+        inline void process_tick();
+        void schedule_next_event();
+        void segment_tick();
+        bool next_segment();
+        void finish_segment_block();
+        inline uint32_t scale_interval(uint32_t counts);
+        void start_speed_report();
+        inline void report_speed(uint32_t speed);
+        void report_stopped();
+        inline void set_raster_pixel(uint32_t lead_steps);
 
         float frequency;
         uint32_t period;
@@ -57,10 +103,45 @@ class StepTicker{
         std::bitset<k_max_actuators> unstep;
 
         Block *current_block;
+        Block::trapezoid_t * volatile current_trapezoid{nullptr};
         uint32_t current_tick{0};
+        // in event scheduling mode the timer is reloaded to fire on the next tick that does anything
+        uint32_t max_event_ticks;
+        uint32_t idle_event_ticks;
+
+        // the time scale set from idle context, and the timer intervals multiplier the ISR uses in 16.16 fixed point, 0 holds
+        float time_scale{1.0F};
+        volatile uint32_t interval_scale{1 << 16};
+        volatile uint32_t time_scale_q16{1 << 16};
+        // unscaled timer counts of a stretched interval still to run, see scale_interval
+        uint32_t stretch_left{0};
+
+        // speed reports, the last one sent and the factor from the lead motor's steps per tick to the speed in 8.8
+        const Block *reported_block{nullptr};
+        uint32_t reported_speed{0};
+        uint32_t speed_factor{0};
+        uint8_t lead_motor{0};
+
+        // raster blocks, the lead motor's steps in segment mode and the pixel they put the laser on
+        uint32_t raster_steps{0};
+        uint16_t raster_pixel{0};
+        uint16_t reported_pixel{0};
+
+        // segment mode, the segment being stepped out and the bresenham error terms for each motor
+        TSRingBuffer<step_segment_t, STEP_SEGMENT_BUFFER_SIZE> segments;
+        step_segment_t segment;
+        uint16_t segment_event;
+        std::array<uint16_t, k_max_actuators> segment_error;
+        // motors started in the current block, once stopped externally they stay stopped until the next block
+        std::bitset<k_max_actuators> segment_started;
+        uint32_t segment_underruns{0};
 
         struct {
             volatile bool running:1;
+            bool event_scheduling:1;
+            bool segment_mode:1;
+            bool segment_active:1;
+            bool block_abandoned:1;
             uint8_t num_motors:4;
         };
 };
@@ -53,6 +53,9 @@ class StepperMotor  : public Module {
         void set_selected(bool b) { selected= b; }
         bool is_extruder() const { return extruder; }
         void set_extruder(bool b) { extruder= b; }
+        // seconds of extrusion the extruder runs ahead by, 0 is off, only used by the step segmenter
+        void set_pressure_advance(float k) { pressure_advance= k; }
+        float get_pressure_advance() const { return pressure_advance; }
 
         int32_t steps_to_target(float);
 
@@ -69,6 +72,7 @@ class StepperMotor  : public Module {
         float steps_per_mm;
         float max_rate; // this is not really rate it is in mm/sec, misnamed used in Robot and Extruder
         float acceleration;
+        float pressure_advance;
 
         volatile int32_t current_position_steps;
         int32_t last_milestone_steps;
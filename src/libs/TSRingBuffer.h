@@ -35,6 +35,11 @@ public:
         return (next(m_wIndex) == m_rIndex);
     }
 
+    size_t count() const
+    {
+        return (m_wIndex + m_size - m_rIndex) % m_size;
+    }
+
     bool put(const T &value)
     {
         if (full())
@@ -64,10 +64,19 @@
  * just always use the Standard Capacity cards with a block size of 512 bytes.
  * This is set with CMD16.
  *
- * You can read and write single blocks (CMD17, CMD25) or multiple blocks
- * (CMD18, CMD25). For simplicity, I'll just use single block accesses. When
- * the card gets a read command, it responds with a response token, and then
- * a data token or an error.
+ * You can read and write single blocks (CMD17, CMD24) or multiple blocks
+ * (CMD18, CMD25). A run of consecutive blocks is one multiple block command,
+ * a multiple block read is ended with CMD12 and a multiple block write with
+ * the stop token. When the card gets a read command, it responds with a
+ * response token, and then a data token or an error.
+ *
+ * The data of a block goes through the SSP by DMA, which keeps the bus
+ * busy back to back instead of waiting on every byte in the SPI driver. The
+ * CPU still waits for each block, FatFs and USB MSD expect the data when the
+ * call returns, but never longer than SD_DMA_TIMEOUT_MS. USB MSD moves one
+ * block per command, it only has a page of buffer for it. The
+ * clock is the fastest the card says it can do in its CSD, capped at the
+ * 25MHz of default speed mode, halved until the CSD reads back the same.
  *
  * SPI Command Format
  * ------------------
@@ -115,10 +124,19 @@
  * +------+---------+---------+- -  - -+---------+-----------+----------+
  * | 0xFE | data[0] | data[1] |        | data[n] | crc[15:8] | crc[7:0] |
  * +------+---------+---------+- -  - -+---------+-----------+----------+
+ *
+ * Multiple Block Read and Write
+ * -----------------------------
+ *
+ * Every block read has the same 0xFE header. Every block written after
+ * CMD25 has a 0xFC header instead, and the write is ended with a single
+ * 0xFD stop token, after which the card is busy until it has programmed
+ * the last block.
  */
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "SDCard.h"
 
@@ -126,12 +144,29 @@ static const uint8_t OXFF = 0xFF;
 
 #define SD_COMMAND_TIMEOUT 5000
 
+// the longest a card may stay busy programming a block, from the SD spec
+#define SD_WRITE_TIMEOUT_MS 500
+
+// a block takes 1.6ms at the slowest clock, the SSP has stopped if it takes this long
+#define SD_DMA_TIMEOUT_MS 20
+
+// the clock the data was always moved at, and the most a card does in default speed mode
+#define SD_SLOW_FREQUENCY 2500000
+#define SD_FAST_FREQUENCY 25000000
+
+// the receive channel has the higher priority so the receive FIFO is emptied before more is sent
+#define SD_DMA_RX_CHANNEL LPC_GPDMACH6
+#define SD_DMA_TX_CHANNEL LPC_GPDMACH7
+#define SD_DMA_RX_MASK    (1 << 6)
+#define SD_DMA_TX_MASK    (1 << 7)
+
 SDCard::SDCard(PinName mosi, PinName miso, PinName sclk, PinName cs) :
   _spi(mosi, miso, sclk), _cs(cs) {
     _cs.output();
     _cs = 1;
     busyflag = false;
     _sectors = 0;
+    _frequency = 0;
 }
 
 #define R1_IDLE_STATE           (1 << 0)
@@ -260,6 +295,7 @@ int SDCard::disk_initialize()
     busyflag = true;
 
     _sectors = 0;
+    _frequency = 0;
 
     CARD_TYPE i = initialise_card();
 
@@ -268,7 +304,12 @@ int SDCard::disk_initialize()
         return 1;
     }
 
-    _sectors = _sd_sectors();
+    char csd[16];
+    bool csd_ok = _read_csd(csd);
+    if (csd_ok)
+        _sectors = _sd_sectors(csd);
+    else
+        fprintf(stderr, "Couldn't read csd response from disk\n");
 
     // Set block length to 512 (CMD16)
     if(_cmd(SDCMD_SET_BLOCKLEN, 512) != 0) {
@@ -277,9 +318,10 @@ int SDCard::disk_initialize()
         return 1;
     }
 
-    _spi.frequency(2500000); // Set to 2.5MHz for data transfer
-    //_spi.frequency(1000000); // Set to 1.0MHz for data transfer
-    //_spi.frequency(100000);    // Set to 0.1MHz for data transfer
+    if (csd_ok)
+        _negotiate_frequency(csd);
+    else
+        _set_frequency(SD_SLOW_FREQUENCY);
 
     busyflag = false;
 
@@ -287,44 +329,80 @@ int SDCard::disk_initialize()
 }
 
 int SDCard::disk_write(const char *buffer, uint32_t block_number)
+{
+    return disk_write_blocks(buffer, block_number, 1);
+}
+
+int SDCard::disk_read(char *buffer, uint32_t block_number)
+{
+    return disk_read_blocks(buffer, block_number, 1);
+}
+
+int SDCard::disk_write_blocks(const char *buffer, uint32_t block_number, uint32_t count)
 {
     if (busyflag)
         return 0;
 
-    busyflag = true;
-
     if (cardtype == SDCARD_FAIL)
         return -1;
-    // set write address for single block (CMD24)
-    if(_cmd(SDCMD_WRITE_BLOCK, BLOCK2ADDR(block_number)) != 0) {
-        return 1;
+
+    busyflag = true;
+
+    // set write address for a single block (CMD24) or the first of a run of them (CMD25)
+    int rc = 0;
+    if(_cmdx(count > 1 ? SDCMD_WRITE_MULTIPLE_BLOCK : SDCMD_WRITE_BLOCK, BLOCK2ADDR(block_number)) != 0) {
+        rc = 1;
+    } else {
+        // at least a byte between the response and the data token
+        _spi.write(0xFF);
+
+        for (uint32_t i = 0; i < count && rc == 0; i++) {
+            rc = _write_block(buffer + i * 512, count > 1 ? 0xFC : 0xFE);
+        }
+
+        // the stop token ends a multiple block write, also after a block the card did not take
+        if(count > 1) {
+            _spi.write(0xFD);
+            _spi.write(0xFF);
+            if(!_wait_ready(SD_WRITE_TIMEOUT_MS))
+                rc = 1;
+        }
     }
 
-    // send the data block
-    _write(buffer, 512);
+    _cs = 1;
+    _spi.write(0xFF);
 
     busyflag = false;
 
-    return 0;
+    return rc;
 }
 
-int SDCard::disk_read(char *buffer, uint32_t block_number)
+int SDCard::disk_read_blocks(char *buffer, uint32_t block_number, uint32_t count)
 {
     if (busyflag)
         return 0;
 
-    busyflag = true;
-
     if (cardtype == SDCARD_FAIL)
         return -1;
-    // set read address for single block (CMD17)
-    if(_cmd(SDCMD_READ_SINGLE_BLOCK, BLOCK2ADDR(block_number)) != 0) {
-        return 1;
+
+    busyflag = true;
+
+    // set read address for a single block (CMD17) or the first of a run of them (CMD18)
+    int rc = 0;
+    if(_cmdx(count > 1 ? SDCMD_READ_MULTIPLE_BLOCK : SDCMD_READ_SINGLE_BLOCK, BLOCK2ADDR(block_number)) != 0) {
+        rc = 1;
+    } else {
+        // receive the data, the card sends blocks until it is stopped
+        for (uint32_t i = 0; i < count && rc == 0; i++) {
+            rc = _read_block(buffer + i * 512, 512);
+        }
+
+        if(count > 1 && _stop_transmission() != 0)
+            rc = 1;
     }
 
-    // receive the data
-    int rc =0; //Did we read the SD Card properly?
-    rc = _read(buffer, 512);
+    _cs = 1;
+    _spi.write(0xFF);
 
     busyflag = false;
 
@@ -332,9 +410,20 @@ int SDCard::disk_read(char *buffer, uint32_t block_number)
 }
 
 int SDCard::disk_status() { return (_sectors > 0)?0:1; }
+// the DMA is done when a block is, so this only waits for the card to finish programming
 int SDCard::disk_sync() {
-    // TODO: wait for DMA, wait for card not busy
-    return 0;
+    if (busyflag)
+        return 0;
+
+    if (cardtype == SDCARD_FAIL)
+        return -1;
+
+    _cs = 0;
+    bool ready = _wait_ready(SD_WRITE_TIMEOUT_MS);
+    _cs = 1;
+    _spi.write(0xFF);
+
+    return ready ? 0 : 1;
 }
 uint32_t SDCard::disk_sectors() { return _sectors; }
 uint64_t SDCard::disk_size() { return ((uint64_t) _sectors) << 9; }
@@ -456,52 +545,59 @@ int SDCard::_cmd8() {
     return -1; // timeout
 }
 
-int SDCard::_read(char *buffer, int length) {
+static int ext_bits(const char *data, int msb, int lsb) {
+    int bits = 0;
+    int size = 1 + msb - lsb;
+    for(int i=0; i<size; i++) {
+        int position = lsb + i;
+        int byte = 15 - (position >> 3);
+        int bit = position & 0x7;
+        int value = (data[byte] >> bit) & 1;
+        bits |= value << i;
+    }
+    return bits;
+}
 
+int SDCard::_read(char *buffer, int length) {
     _cs = 0;
 
-    // read until start byte (0xFF)
-//    while(_spi.write(0xFF) != 0xFE);
-     uint8_t r;
-     volatile uint32_t j;
-     j = 262144;
-     while(((r = _spi.write(0xFF)) != 0xFE) && (j))
-     {
-//         iprintf("0x%02X ", r);
-         j--;
-//         for (volatile uint32_t j = 262144; j; j--);
-     }
-     if(r == 0xFE) {
-//         iprintf("Got start byte after waiting %lu, reading data\n",j);
-
-         // read data
-         for(int i=0; i<length; i++) {
-             buffer[i] = _spi.write(0xFF);
-         }
-         _spi.write(0xFF); // checksum
-         _spi.write(0xFF);
-
-         _cs = 1;
-         _spi.write(0xFF);
-         return 0;
-     } else {
-         //timed out
-         _cs = 1;
-         _spi.write(0xFF);
-         return -1;
-     }
+    int rc = _read_block(buffer, length);
+
+    _cs = 1;
+    _spi.write(0xFF);
+    return rc;
 }
 
-int SDCard::_write(const char *buffer, int length) {
-    _cs = 0;
+// reads one data block once its start byte comes, with cs already low
+int SDCard::_read_block(char *buffer, int length) {
+    // read until start byte (0xFE)
+    uint8_t r;
+    uint32_t j = 262144;
+    while(((r = _spi.write(0xFF)) != 0xFE) && (j)) {
+        j--;
+    }
+    if(r != 0xFE) {
+        //timed out
+        return -1;
+    }
+
+    // read data
+    if(_transfer(buffer, NULL, length) != 0)
+        return -1;
+
+    _spi.write(0xFF); // checksum
+    _spi.write(0xFF);
+    return 0;
+}
 
+// writes one data block after the token and waits for the card to program it, with cs already low
+int SDCard::_write_block(const char *buffer, uint8_t token) {
     // indicate start of block
-    _spi.write(0xFE);
+    _spi.write(token);
 
     // write the data
-    for(int i=0; i<length; i++) {
-        _spi.write(buffer[i]);
-    }
+    if(_transfer(NULL, buffer, 512) != 0)
+        return 1;
 
     // write the checksum
     _spi.write(0xFF);
@@ -509,46 +605,171 @@ int SDCard::_write(const char *buffer, int length) {
 
     // check the repsonse token
     if((_spi.write(0xFF) & 0x1F) != 0x05) {
-        _cs = 1;
-        _spi.write(0xFF);
         return 1;
     }
 
     // wait for write to finish
-    while(_spi.write(0xFF) == 0);
+    return _wait_ready(SD_WRITE_TIMEOUT_MS) ? 0 : 1;
+}
 
-    _cs = 1;
-    _spi.write(0xFF);
-    return 0;
+// ends a multiple block read (CMD12), the card is sending data so a byte is skipped before the response
+int SDCard::_stop_transmission() {
+    _spi.write(0x40 | SDCMD_STOP_TRANSMISSION);
+    _spi.write(0x00);
+    _spi.write(0x00);
+    _spi.write(0x00);
+    _spi.write(0x00);
+    _spi.write(0x95);
+    _spi.write(0xFF); // stuff byte
+
+    // wait for the repsonse (response[7] == 0), R1b so then wait while it is busy
+    for(int i=0; i<SD_COMMAND_TIMEOUT; i++) {
+        int response = _spi.write(0xFF);
+        if(!(response & 0x80)) {
+            if(!_wait_ready(SD_WRITE_TIMEOUT_MS))
+                return -1;
+            return response;
+        }
+    }
+    return -1; // timeout
 }
 
-static int ext_bits(char *data, int msb, int lsb) {
-    int bits = 0;
-    int size = 1 + msb - lsb;
-    for(int i=0; i<size; i++) {
-        int position = lsb + i;
-        int byte = 15 - (position >> 3);
-        int bit = position & 0x7;
-        int value = (data[byte] >> bit) & 1;
-        bits |= value << i;
+// the card holds data out low while it is busy
+bool SDCard::_wait_ready(uint32_t ms) {
+    uint32_t start = us_ticker_read();
+    while(_spi.write(0xFF) != 0xFF) {
+        if(us_ticker_read() - start > ms * 1000)
+            return false;
     }
-    return bits;
+    return true;
 }
 
-uint32_t SDCard::_sd_sectors() {
+// the GPDMA only reaches the two SRAM banks, not the flash
+static bool dma_reaches(const void *p) {
+    uint32_t a = (uint32_t)p;
+    return (a >= 0x10000000 && a < 0x10008000) || (a >= 0x2007C000 && a < 0x20084000);
+}
 
-    // CMD9, Response R2 (R1 byte + 16-byte block read)
-    if(_cmdx(SDCMD_SEND_CSD, 0) != 0) {
-        fprintf(stderr, "Didn't get a response from the disk\n");
+// what is clocked out when only reading and where what is clocked in goes when only writing, the DMA does not
+// increment either
+static uint8_t dma_fill = 0xFF;
+static uint8_t dma_discard;
+
+// Moves length bytes through the SSP, rx or tx is NULL to only read or only write. Both directions go by DMA while
+// the CPU waits for the receive channel, which is done once the last byte is clocked in. Buffers the DMA cannot reach
+// are moved a byte at a time. Returns 0, or -1 if the DMA failed or did not finish in SD_DMA_TIMEOUT_MS
+int SDCard::_transfer(char *rx, const char *tx, int length) {
+    if((rx != NULL && !dma_reaches(rx)) || (tx != NULL && !dma_reaches(tx)) || length > 0xFFF) {
+        for(int i=0; i<length; i++) {
+            int r = _spi.write(tx != NULL ? tx[i] : 0xFF);
+            if(rx != NULL)
+                rx[i] = r;
+        }
         return 0;
     }
 
-    char csd[16];
-    if(_read(csd, 16) != 0) {
-        fprintf(stderr, "Couldn't read csd response from disk\n");
-        return 0;
+    LPC_SSP_TypeDef *ssp = _spi.get_ssp();
+    uint32_t rx_request = (ssp == LPC_SSP0) ? 1 : 3;
+    uint32_t tx_request = rx_request - 1;
+
+    LPC_SC->PCONP |= (1 << 29);
+    LPC_GPDMA->DMACConfig = 1;
+
+    // nothing left over in the receive FIFO
+    while(ssp->SR & (1 << 2))
+        (void)ssp->DR;
+
+    LPC_GPDMA->DMACIntTCClear = SD_DMA_RX_MASK | SD_DMA_TX_MASK;
+    LPC_GPDMA->DMACIntErrClr = SD_DMA_RX_MASK | SD_DMA_TX_MASK;
+
+    // bursts of 4 bytes, a byte wide
+    uint32_t control = length | (1 << 12) | (1 << 15);
+
+    SD_DMA_RX_CHANNEL->DMACCSrcAddr = (uint32_t)&ssp->DR;
+    SD_DMA_RX_CHANNEL->DMACCDestAddr = (uint32_t)(rx != NULL ? (uint8_t *)rx : &dma_discard);
+    SD_DMA_RX_CHANNEL->DMACCLLI = 0;
+    SD_DMA_RX_CHANNEL->DMACCControl = control | (rx != NULL ? (1 << 27) : 0);
+
+    SD_DMA_TX_CHANNEL->DMACCSrcAddr = (uint32_t)(tx != NULL ? (const uint8_t *)tx : &dma_fill);
+    SD_DMA_TX_CHANNEL->DMACCDestAddr = (uint32_t)&ssp->DR;
+    SD_DMA_TX_CHANNEL->DMACCLLI = 0;
+    SD_DMA_TX_CHANNEL->DMACCControl = control | (tx != NULL ? (1 << 26) : 0);
+
+    ssp->DMACR = 3;
+
+    // peripheral to memory, then memory to peripheral which starts the clock
+    SD_DMA_RX_CHANNEL->DMACCConfig = 1 | (rx_request << 1) | (2 << 11);
+    SD_DMA_TX_CHANNEL->DMACCConfig = 1 | (tx_request << 6) | (1 << 11);
+
+    int rc = 0;
+    uint32_t start = us_ticker_read();
+    while(LPC_GPDMA->DMACEnbldChns & SD_DMA_RX_MASK) {
+        if((LPC_GPDMA->DMACRawIntErrStat & (SD_DMA_RX_MASK | SD_DMA_TX_MASK)) || us_ticker_read() - start > SD_DMA_TIMEOUT_MS * 1000) {
+            rc = -1;
+            break;
+        }
     }
+    if(LPC_GPDMA->DMACRawIntErrStat & (SD_DMA_RX_MASK | SD_DMA_TX_MASK))
+        rc = -1;
+
+    if(rc != 0) {
+        // stop both channels, and leave nothing in the FIFOs for the next command
+        SD_DMA_RX_CHANNEL->DMACCConfig = 0;
+        SD_DMA_TX_CHANNEL->DMACCConfig = 0;
+        LPC_GPDMA->DMACIntErrClr = SD_DMA_RX_MASK | SD_DMA_TX_MASK;
+        start = us_ticker_read();
+        while((ssp->SR & (1 << 4)) && us_ticker_read() - start < SD_DMA_TIMEOUT_MS * 1000);
+        while(ssp->SR & (1 << 2))
+            (void)ssp->DR;
+    }
+
+    ssp->DMACR = 0;
+    return rc;
+}
+
+// The SSP clock is the core clock divided by an even number, rounded up so the card is never clocked faster than hz
+void SDCard::_set_frequency(uint32_t hz) {
+    uint32_t div = (SystemCoreClock / 2 + hz - 1) / hz;
+    _frequency = SystemCoreClock / 2 / div;
+    _spi.frequency(_frequency);
+}
+
+// Tries the card's maximum clock from its CSD, then half that and so on, until the CSD reads back the same as it did
+// at the slow initialisation clock, never less than the 2.5MHz it always used
+uint32_t SDCard::_negotiate_frequency(const char *csd) {
+    // tran_speed : csd[103:96], a time value of tenths [6:3] times a rate unit [2:0] of 100kbit/s, 1Mbit/s...
+    static const uint8_t time_value[16] = {0, 10, 12, 13, 15, 20, 25, 30, 35, 40, 45, 50, 55, 60, 70, 80};
+    int tran_speed = ext_bits(csd, 103, 96);
+
+    uint32_t hz = time_value[(tran_speed >> 3) & 0x0F] * 10000;
+    for(int unit = tran_speed & 0x07; unit > 0 && hz < SD_FAST_FREQUENCY; unit--)
+        hz *= 10;
+    if(hz > SD_FAST_FREQUENCY)
+        hz = SD_FAST_FREQUENCY;
+
+    for(; hz > SD_SLOW_FREQUENCY; hz /= 2) {
+        _set_frequency(hz);
+        char check[16];
+        if(_read_csd(check) && memcmp(check, csd, 16) == 0)
+            return _frequency;
+    }
+
+    _set_frequency(SD_SLOW_FREQUENCY);
+    return _frequency;
+}
+
+// CMD9, Response R2 (R1 byte + 16-byte block read)
+bool SDCard::_read_csd(char *csd) {
+    if(_cmdx(SDCMD_SEND_CSD, 0) != 0) {
+        _cs = 1;
+        _spi.write(0xFF);
+        return false;
+    }
+
+    return _read(csd, 16) == 0;
+}
 
+uint32_t SDCard::_sd_sectors(const char *csd) {
     // csd_structure : csd[127:126]
     // c_size        : csd[73:62]
     // c_size_mult   : csd[49:47]
@@ -71,6 +71,8 @@ public:
     virtual int disk_initialize();
     virtual int disk_write(const char *buffer, uint32_t block_number);
     virtual int disk_read(char *buffer, uint32_t block_number);
+    virtual int disk_write_blocks(const char *buffer, uint32_t block_number, uint32_t count);
+    virtual int disk_read_blocks(char *buffer, uint32_t block_number, uint32_t count);
     virtual int disk_status();
     virtual int disk_sync();
     virtual uint32_t disk_sectors();
@@ -82,7 +84,16 @@ public:
 
     bool busy();
 
+    // the SPI clock agreed with the card when it was initialised
+    uint32_t get_frequency() const { return _frequency; }
+
 protected:
+    // the mbed SPI with its SSP, which the DMA feeds
+    class SSP : public mbed::SPI {
+    public:
+        SSP(PinName mosi, PinName miso, PinName sclk) : mbed::SPI(mosi, miso, sclk) {}
+        LPC_SSP_TypeDef *get_ssp() { return _spi.spi; }
+    };
 
     int _cmd(int cmd, uint32_t arg);
     int _cmdx(int cmd, uint32_t arg);
@@ -93,12 +104,20 @@ protected:
     CARD_TYPE initialise_card_v2();
 
     int _read(char *buffer, int length);
-    int _write(const char *buffer, int length);
-
-    uint32_t _sd_sectors();
+    int _read_block(char *buffer, int length);
+    int _write_block(const char *buffer, uint8_t token);
+    int _stop_transmission();
+    bool _wait_ready(uint32_t ms);
+    int _transfer(char *rx, const char *tx, int length);
+    void _set_frequency(uint32_t hz);
+    uint32_t _negotiate_frequency(const char *csd);
+
+    bool _read_csd(char *csd);
+    uint32_t _sd_sectors(const char *csd);
     uint32_t _sectors;
+    uint32_t _frequency;
 
-    mbed::SPI _spi;
+    SSP _spi;
     GPIO _cs;
 
     volatile bool busyflag;
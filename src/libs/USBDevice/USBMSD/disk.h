@@ -23,6 +23,32 @@ public:
      */
     virtual int disk_write(const char * data, uint32_t block) { return 0; };
 
+    /*
+     * read count consecutive blocks, a disk that can do it in one go overrides this
+     *
+     * @returns 0 if successful
+     */
+    virtual int disk_read_blocks(char * data, uint32_t block, uint32_t count) {
+        for (uint32_t i = 0; i < count; i++) {
+            if (disk_read(data, block + i)) return 1;
+            data += disk_blocksize();
+        }
+        return 0;
+    };
+
+    /*
+     * write count consecutive blocks, a disk that can do it in one go overrides this
+     *
+     * @returns 0 if successful
+     */
+    virtual int disk_write_blocks(const char * data, uint32_t block, uint32_t count) {
+        for (uint32_t i = 0; i < count; i++) {
+            if (disk_write(data, block + i)) return 1;
+            data += disk_blocksize();
+        }
+        return 0;
+    };
+
     /*
      * Disk initilization
      */
@@ -24,6 +24,7 @@
 #include "libs/Kernel.h"
 #include "libs/SerialMessage.h"
 #include "StreamOutputPool.h"
+#include "Conveyor.h"
 
 // extern void setled(int, bool);
 #define setled(a, b) do {} while (0)
@@ -38,6 +39,10 @@ USBSerial::USBSerial(USB *u): USBCDC(u), rxbuf(256 + 8), txbuf(128 + 8)
     flush_to_nl = false;
     halt_flag = false;
     query_flag = false;
+    hold_flag = false;
+    resume_flag = false;
+    feed_override_reset = false;
+    feed_override_change = 0;
     last_char_was_dollar = false;
 }
 
@@ -188,7 +193,6 @@ bool USBSerial::USBEvent_EPOut(uint8_t bEP, uint8_t bEPStatus)
         }
 
         if(c[i] == 'X' - 'A' + 1) { // ^X
-            //THEKERNEL->set_feed_hold(false); // required to free stuff up
             halt_flag = true;
             continue;
         }
@@ -200,18 +204,27 @@ bool USBSerial::USBEvent_EPOut(uint8_t bEP, uint8_t bEPStatus)
 
         if(THEKERNEL->is_grbl_mode()) {
             if(c[i] == '!') { // safe pause
-                //THEKERNEL->set_feed_hold(true);
+                hold_flag = true;
                 continue;
             }
 
             if(c[i] == '~') { // safe resume
-                //THEKERNEL->set_feed_hold(false);
+                resume_flag = true;
                 continue;
             }
-            // if(last_char_was_dollar && (c[i] == 'X' || c[i] == 'H')) {
-            //     // we need to do this otherwise $X/$H won't work if there was a feed hold like when stop is clicked in bCNC
-            //     THEKERNEL->set_feed_hold(false);
-            // }
+            if(last_char_was_dollar && (c[i] == 'X' || c[i] == 'H')) {
+                // we need to do this otherwise $X/$H won't work if there was a feed hold like when stop is clicked in bCNC
+                resume_flag = true;
+            }
+
+            // these are UTF-8 continuation bytes, outside grbl mode they can be in the comments of a job
+            switch(c[i]) {
+                case FEED_OVERRIDE_RESET: feed_override_reset = true; feed_override_change = 0; continue;
+                case FEED_OVERRIDE_PLUS_10: feed_override_change += 10; continue;
+                case FEED_OVERRIDE_MINUS_10: feed_override_change -= 10; continue;
+                case FEED_OVERRIDE_PLUS_1: feed_override_change += 1; continue;
+                case FEED_OVERRIDE_MINUS_1: feed_override_change -= 1; continue;
+            }
         }
 
         last_char_was_dollar = (c[i] == '$');
@@ -296,6 +309,27 @@ void USBSerial::on_idle(void *argument)
         puts(THEKERNEL->get_query_string().c_str());
     }
 
+    if(hold_flag) {
+        hold_flag = false;
+        THEKERNEL->set_feed_hold(true);
+    }
+
+    if(resume_flag) {
+        resume_flag = false;
+        THEKERNEL->set_feed_hold(false);
+    }
+
+    if(feed_override_reset || feed_override_change != 0) {
+        // the receive interrupt changes both, they are taken and cleared together
+        __disable_irq();
+        bool reset = feed_override_reset;
+        int8_t change = feed_override_change;
+        feed_override_reset = false;
+        feed_override_change = 0;
+        __enable_irq();
+        float f = reset ? 1.0F : THECONVEYOR->get_feed_override();
+        THECONVEYOR->set_feed_override(f + change / 100.0F);
+    }
 }
 
 void USBSerial::on_main_loop(void *argument)
@@ -66,13 +66,19 @@ protected:
     // keep track of number of newlines in the buffer
     // this makes it trivial to detect if there's a new line available
     volatile int nl_in_rx;
+    // percent, from the real time feed override commands
+    volatile int8_t feed_override_change;
+    // set by the USB interrupt and cleared in on_idle, each its own byte so clearing one can not lose another
+    volatile bool halt_flag;
+    volatile bool query_flag;
+    volatile bool hold_flag;
+    volatile bool resume_flag;
+    volatile bool feed_override_reset;
 
 
     volatile struct {
         volatile bool attach:1;
         bool attached:1;
-        bool halt_flag:1;
-        bool query_flag:1;
         bool last_char_was_dollar:1;
         // if we receive a line that's longer than the buffer, to avoid a deadlock
         // we must flush the buffer.
@@ -117,6 +117,7 @@ void init() {
 
     bool sdok= (sd.disk_initialize() == 0);
     if(!sdok) kernel->streams->printf("SDCard failed to initialize\r\n");
+    else kernel->streams->printf("SDCard running @%luKHz\r\n", sd.get_frequency() / 1000);
 
     #ifdef NONETWORK
         kernel->streams->printf("NETWORK is disabled\r\n");
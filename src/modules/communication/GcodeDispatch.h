@@ -23,6 +23,8 @@ public:
     virtual void on_console_line_received(void *line);
 
     uint8_t get_modal_command() const { return modal_group_1<4 ? modal_group_1 : 0; }
+    // for moves that are planned without coming through here, a later G53 or bare XYZ line follows them
+    void set_modal_command(uint8_t g) { modal_group_1= g; }
 private:
     int currentline;
     std::string upload_filename;
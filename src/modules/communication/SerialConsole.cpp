@@ -16,6 +16,7 @@ using std::string;
 #include "libs/SerialMessage.h"
 #include "libs/StreamOutput.h"
 #include "libs/StreamOutputPool.h"
+#include "modules/robot/Conveyor.h"
 
 // Serial reading module
 // Treats every received line as a command and passes it ( via event call ) to the command dispatcher.
@@ -31,6 +32,10 @@ void SerialConsole::on_module_loaded() {
     this->serial->attach(this, &SerialConsole::on_serial_char_received, mbed::Serial::RxIrq);
     query_flag= false;
     halt_flag= false;
+    hold_flag= false;
+    resume_flag= false;
+    feed_override_reset= false;
+    feed_override_change= 0;
 
     // We only call the command dispatcher in the main loop, nowhere else
     this->register_for_event(ON_MAIN_LOOP);
@@ -52,6 +57,24 @@ void SerialConsole::on_serial_char_received(){
             halt_flag= true;
             continue;
         }
+        if(THEKERNEL->is_grbl_mode()) {
+            if(received == '!') { // feed hold
+                hold_flag= true;
+                continue;
+            }
+            if(received == '~') { // resume
+                resume_flag= true;
+                continue;
+            }
+            // these are UTF-8 continuation bytes, outside grbl mode they can be in the comments of a job
+            switch((uint8_t)received) {
+                case FEED_OVERRIDE_RESET: feed_override_reset= true; feed_override_change= 0; continue;
+                case FEED_OVERRIDE_PLUS_10: feed_override_change += 10; continue;
+                case FEED_OVERRIDE_MINUS_10: feed_override_change -= 10; continue;
+                case FEED_OVERRIDE_PLUS_1: feed_override_change += 1; continue;
+                case FEED_OVERRIDE_MINUS_1: feed_override_change -= 1; continue;
+            }
+        }
         // convert CR to NL (for host OSs that don't send NL)
         if( received == '\r' ){ received = '\n'; }
         this->buffer.push_back(received);
@@ -68,6 +91,25 @@ void SerialConsole::on_idle(void * argument)
         halt_flag= false;
         THEKERNEL->call_event(ON_HALT, nullptr);
     }
+    if(hold_flag) {
+        hold_flag= false;
+        THEKERNEL->set_feed_hold(true);
+    }
+    if(resume_flag) {
+        resume_flag= false;
+        THEKERNEL->set_feed_hold(false);
+    }
+    if(feed_override_reset || feed_override_change != 0) {
+        // the receive interrupt changes both, they are taken and cleared together
+        __disable_irq();
+        bool reset= feed_override_reset;
+        int8_t change= feed_override_change;
+        feed_override_reset= false;
+        feed_override_change= 0;
+        __enable_irq();
+        float f= reset ? 1.0F : THECONVEYOR->get_feed_override();
+        THECONVEYOR->set_feed_override(f + change / 100.0F);
+    }
 }
 
 // Actual event calling must happen in the main loop because if it happens in the interrupt we will loose data
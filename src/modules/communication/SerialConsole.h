@@ -38,10 +38,13 @@ class SerialConsole : public Module, public StreamOutput {
         //vector<std::string> received_lines;    // Received lines are stored here until they are requested
         RingBuffer<char,256> buffer;             // Receive buffer
         mbed::Serial* serial;
-        struct {
-          bool query_flag:1;
-          bool halt_flag:1;
-        };
+        volatile int8_t feed_override_change;    // percent, from the real time feed override commands
+        // set by the RX interrupt and cleared in on_idle, each its own byte so clearing one can not lose another
+        volatile bool query_flag;
+        volatile bool halt_flag;
+        volatile bool hold_flag;
+        volatile bool resume_flag;
+        volatile bool feed_override_reset;
 };
 
 #endif
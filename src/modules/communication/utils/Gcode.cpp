@@ -10,13 +10,17 @@
 #include "libs/StreamOutput.h"
 #include "utils.h"
 #include <stdlib.h>
-#include <algorithm>
+#include <string.h>
 
 // This is a gcode object. It represents a GCode string/command, and caches some important values about that command for the sake of performance.
 // It gets passed around in events, and attached to the queue ( that'll change )
-Gcode::Gcode(const string &command, StreamOutput *stream, bool strip)
+Gcode::Gcode(const char *line, StreamOutput *stream, bool strip) : Gcode(line, strlen(line), stream, strip)
 {
-    this->command= strdup(command.c_str());
+}
+
+Gcode::Gcode(const char *line, size_t len, StreamOutput *stream, bool strip)
+{
+    copy_line(line, len);
     this->m= 0;
     this->g= 0;
     this->subcode= 0;
@@ -29,66 +33,121 @@ Gcode::Gcode(const string &command, StreamOutput *stream, bool strip)
 
 Gcode::~Gcode()
 {
-    if(command != nullptr) {
-        // TODO we can reference count this so we share copies, may save more ram than the extra count we need to store
-        free(command);
-    }
+    if(line != buf) free(line);
 }
 
 Gcode::Gcode(const Gcode &to_copy)
 {
-    this->command               = strdup(to_copy.command); // TODO we can reference count this so we share copies, may save more ram than the extra count we need to store
+    copy_from(to_copy);
+}
+
+Gcode &Gcode::operator= (const Gcode &to_copy)
+{
+    if( this != &to_copy ) {
+        if(line != buf) free(line);
+        copy_from(to_copy);
+    }
+    return *this;
+}
+
+void Gcode::copy_line(const char *line, size_t len)
+{
+    this->line= len < sizeof(buf) ? buf : (char *)malloc(len + 1);
+    memcpy(this->line, line, len);
+    this->line[len]= '\0';
+}
+
+void Gcode::copy_from(const Gcode &to_copy)
+{
+    copy_line(to_copy.line, strlen(to_copy.line));
+    this->command               = this->line + (to_copy.command - to_copy.line);
+    this->letters               = to_copy.letters;
+    this->repeated              = to_copy.repeated;
+    memcpy(this->values, to_copy.values, sizeof(values));
+    memcpy(this->offsets, to_copy.offsets, sizeof(offsets));
+    this->num_args              = to_copy.num_args;
     this->has_m                 = to_copy.has_m;
     this->has_g                 = to_copy.has_g;
     this->m                     = to_copy.m;
     this->g                     = to_copy.g;
     this->subcode               = to_copy.subcode;
     this->add_nl                = to_copy.add_nl;
+    this->stripped              = to_copy.stripped;
     this->is_error              = to_copy.is_error;
     this->stream                = to_copy.stream;
     this->txt_after_ok.assign( to_copy.txt_after_ok );
 }
 
-Gcode &Gcode::operator= (const Gcode &to_copy)
+// Puts the letter at line[i] in the table, the first of a letter that is followed by a number gives it its value
+void Gcode::add_letter(size_t i)
 {
-    if( this != &to_copy ) {
-        this->command               = strdup(to_copy.command); // TODO we can reference count this so we share copies, may save more ram than the extra count we need to store
-        this->has_m                 = to_copy.has_m;
-        this->has_g                 = to_copy.has_g;
-        this->m                     = to_copy.m;
-        this->g                     = to_copy.g;
-        this->subcode               = to_copy.subcode;
-        this->add_nl                = to_copy.add_nl;
-        this->is_error              = to_copy.is_error;
-        this->stream                = to_copy.stream;
-        this->txt_after_ok.assign( to_copy.txt_after_ok );
+    char c= line[i];
+    if(letters & bit(c)) repeated |= bit(c);
+    else letters |= bit(c);
+
+    if(offsets[c - 'A'] == 0 && i < UINT16_MAX) {
+        char *cn;
+        float r= strtof(&line[i + 1], &cn);
+        if(cn > &line[i + 1]) {
+            values[c - 'A']= r;
+            offsets[c - 'A']= i + 1;
+        }
     }
-    return *this;
 }
 
+// Takes the first len characters of the line off the command, a letter that is only in them is no longer on it and one
+// that is also after them is looked for again from there
+void Gcode::drop_letters(size_t len)
+{
+    uint32_t again= 0;
+    for (size_t i = 0; i < len; ++i) {
+        char c= line[i];
+        if(!is_indexed(c)) continue;
+        if(c != 'T') --num_args;
+        if(repeated & bit(c)) again |= bit(c);
+        letters &= ~bit(c);
+        offsets[c - 'A']= 0;
+    }
+
+    if(again == 0) return;
+    repeated &= ~again;
+    for (size_t i = len; line[i]; ++i) {
+        if(is_indexed(line[i]) && (again & bit(line[i]))) add_letter(i);
+    }
+}
+
+// Where a letter that is not in the table is in the command
+const char *Gcode::find(char letter) const
+{
+    return strchr(command, letter);
+}
 
 // Whether or not a Gcode has a letter
 bool Gcode::has_letter( char letter ) const
 {
-    for (size_t i = 0; i < strlen(this->command); ++i) {
-        if( command[i] == letter ) {
-            return true;
-        }
-    }
-    return false;
+    if(is_indexed(letter)) return (letters & bit(letter)) != 0;
+    return letter != '\0' && find(letter) != nullptr;
 }
 
 // Retrieve the value for a given letter
 float Gcode::get_value( char letter, char **ptr ) const
 {
+    if(is_indexed(letter)) {
+        uint16_t o= offsets[letter - 'A'];
+        if(ptr != nullptr) {
+            if(o == 0) *ptr= nullptr;
+            else strtof(&line[o], ptr);
+        }
+        return o == 0 ? 0 : values[letter - 'A'];
+    }
+
     const char *cs = command;
     char *cn = NULL;
     for (; *cs; cs++) {
         if( letter == *cs ) {
-            cs++;
-            float r = strtof(cs, &cn);
+            float r = strtof(cs + 1, &cn);
             if(ptr != nullptr) *ptr= cn;
-            if (cn > cs)
+            if (cn > cs + 1)
                 return r;
         }
     }
@@ -100,12 +159,25 @@ int Gcode::get_int( char letter, char **ptr ) const
 {
     const char *cs = command;
     char *cn = NULL;
+    if(is_indexed(letter)) {
+        uint16_t o= offsets[letter - 'A'];
+        if(o == 0) {
+            if(ptr != nullptr) *ptr= nullptr;
+            return 0;
+        }
+        // the first value of the letter is where an int would be unless it is something like .5
+        int r = strtol(&line[o], &cn, 10);
+        if(cn > &line[o]) {
+            if(ptr != nullptr) *ptr= cn;
+            return r;
+        }
+    }
+
     for (; *cs; cs++) {
         if( letter == *cs ) {
-            cs++;
-            int r = strtol(cs, &cn, 10);
+            int r = strtol(cs + 1, &cn, 10);
             if(ptr != nullptr) *ptr= cn;
-            if (cn > cs)
+            if (cn > cs + 1)
                 return r;
         }
     }
@@ -117,12 +189,24 @@ uint32_t Gcode::get_uint( char letter, char **ptr ) const
 {
     const char *cs = command;
     char *cn = NULL;
+    if(is_indexed(letter)) {
+        uint16_t o= offsets[letter - 'A'];
+        if(o == 0) {
+            if(ptr != nullptr) *ptr= nullptr;
+            return 0;
+        }
+        uint32_t r = strtoul(&line[o], &cn, 10);
+        if(cn > &line[o]) {
+            if(ptr != nullptr) *ptr= cn;
+            return r;
+        }
+    }
+
     for (; *cs; cs++) {
         if( letter == *cs ) {
-            cs++;
-            int r = strtoul(cs, &cn, 10);
+            uint32_t r = strtoul(cs + 1, &cn, 10);
             if(ptr != nullptr) *ptr= cn;
-            if (cn > cs)
+            if (cn > cs + 1)
                 return r;
         }
     }
@@ -130,27 +214,20 @@ uint32_t Gcode::get_uint( char letter, char **ptr ) const
     return 0;
 }
 
-int Gcode::get_num_args() const
+// The letters that are arguments, all but T and the first one when not stripped
+uint32_t Gcode::args() const
 {
-    int count = 0;
-    for(size_t i = stripped?0:1; i < strlen(command); i++) {
-        if( this->command[i] >= 'A' && this->command[i] <= 'Z' ) {
-            if(this->command[i] == 'T') continue;
-            count++;
-        }
-    }
-    return count;
+    uint32_t a= letters & ~bit('T');
+    if(!stripped && is_indexed(command[0]) && !(repeated & bit(command[0]))) a &= ~bit(command[0]);
+    return a;
 }
 
 std::map<char,float> Gcode::get_args() const
 {
     std::map<char,float> m;
-    for(size_t i = stripped?0:1; i < strlen(command); i++) {
-        char c= this->command[i];
-        if( c >= 'A' && c <= 'Z' ) {
-            if(c == 'T') continue;
-            m[c]= get_value(c);
-        }
+    uint32_t a= args();
+    for (char c = 'A'; c <= 'Z'; ++c) {
+        if(a & bit(c)) m[c]= get_value(c);
     }
     return m;
 }
@@ -158,12 +235,9 @@ std::map<char,float> Gcode::get_args() const
 std::map<char,int> Gcode::get_args_int() const
 {
     std::map<char,int> m;
-    for(size_t i = stripped?0:1; i < strlen(command); i++) {
-        char c= this->command[i];
-        if( c >= 'A' && c <= 'Z' ) {
-            if(c == 'T') continue;
-            m[c]= get_int(c);
-        }
+    uint32_t a= args();
+    for (char c = 'A'; c <= 'Z'; ++c) {
+        if(a & bit(c)) m[c]= get_int(c);
     }
     return m;
 }
@@ -171,6 +245,18 @@ std::map<char,int> Gcode::get_args_int() const
 // Cache some of this command's properties, so we don't have to parse the string every time we want to look at them
 void Gcode::prepare_cached_values(bool strip)
 {
+    // the one pass over the line, every letter goes in the table
+    command= line;
+    letters= 0;
+    repeated= 0;
+    num_args= 0;
+    memset(offsets, 0, sizeof(offsets));
+    for (size_t i = 0; line[i]; ++i) {
+        if(!is_indexed(line[i])) continue;
+        if(line[i] != 'T') ++num_args;
+        add_letter(i);
+    }
+
     char *p= nullptr;
     if( this->has_letter('G') ) {
         this->has_g = true;
@@ -198,45 +284,15 @@ void Gcode::prepare_cached_values(bool strip)
         }
     }
 
-    if(!strip) return;
+    if(!strip) {
+        // the first letter is the command, it is not an argument
+        if(is_indexed(line[0]) && line[0] != 'T') --num_args;
+        return;
+    }
 
-    // remove the Gxxx or Mxxx from string
+    // remove the Gxxx or Mxxx from the command
     if (p != nullptr) {
-        char *n= strdup(p); // create new string starting at end of the numeric value
-        free(command);
-        command= n;
-    }
-}
-
-// strip off X Y Z I J K parameters if G0/1/2/3
-void Gcode::strip_parameters()
-{
-    if(has_g && g < 4){
-        // strip the command of the XYZIJK parameters
-        string newcmd;
-        char *cn= command;
-        // find the start of each parameter
-        char *pch= strpbrk(cn, "XYZIJK");
-        while (pch != nullptr) {
-            if(pch > cn) {
-                // copy non parameters to new string
-                newcmd.append(cn, pch-cn);
-            }
-            // find the end of the parameter and its value
-            char *eos;
-            strtof(pch+1, &eos);
-            cn= eos; // point to end of last parameter
-            pch= strpbrk(cn, "XYZIJK"); // find next parameter
-        }
-        // append anything left on the line
-        newcmd.append(cn);
-
-        // strip whitespace to save even more, this causes problems so don't do it
-        //newcmd.erase(std::remove_if(newcmd.begin(), newcmd.end(), ::isspace), newcmd.end());
-
-        // release the old one
-        free(command);
-        // copy the new shortened one
-        command= strdup(newcmd.c_str());
+        drop_letters(p - line);
+        command= p;
     }
 }
@@ -10,28 +10,36 @@
 #define GCODE_H
 #include <string>
 #include <map>
+#include <stdint.h>
 
 using std::string;
 
 class StreamOutput;
 
+// most lines fit in the Gcode itself, longer ones are copied to the heap
+#define GCODE_INLINE_SIZE 96
+
 // Object to represent a Gcode command
+// The line is parsed once when it is made, the value of each letter A-Z goes into a table so asking for it does not
+// parse the line again. Any other letter, like the checksum *, is looked for in the text.
 class Gcode {
     public:
-        Gcode(const string&, StreamOutput*, bool strip=true);
+        Gcode(const char *line, StreamOutput*, bool strip=true);
+        Gcode(const char *line, size_t len, StreamOutput*, bool strip=true);
+        Gcode(const string& line, StreamOutput *stream, bool strip=true) : Gcode(line.data(), line.size(), stream, strip) {}
         Gcode(const Gcode& to_copy);
         Gcode& operator= (const Gcode& to_copy);
         ~Gcode();
 
+        // the text after the Gxxx or Mxxx when stripped
         const char* get_command() const { return command; }
         bool has_letter ( char letter ) const;
         float get_value ( char letter, char **ptr= nullptr ) const;
         int get_int ( char letter, char **ptr= nullptr ) const;
         uint32_t get_uint ( char letter, char **ptr= nullptr ) const;
-        int get_num_args() const;
+        int get_num_args() const { return num_args; }
         std::map<char,float> get_args() const;
         std::map<char,int> get_args_int() const;
-        void strip_parameters();
 
         // FIXME these should be private
         unsigned int m;
@@ -50,7 +58,24 @@ class Gcode {
         string txt_after_ok;
 
     private:
+        void copy_line(const char *line, size_t len);
+        void copy_from(const Gcode& to_copy);
+        void add_letter(size_t i);
+        void drop_letters(size_t len);
+        const char *find(char letter) const;
+        uint32_t args() const;
         void prepare_cached_values(bool strip=true);
-        char *command;
+
+        static bool is_indexed(char letter) { return letter >= 'A' && letter <= 'Z'; }
+        static uint32_t bit(char letter) { return 1 << (letter - 'A'); }
+
+        char *line;             // the whole line, points to buf unless it is too long for it
+        const char *command;    // where the command starts in line
+        uint32_t letters;       // bit per letter A-Z on the command
+        uint32_t repeated;      // the ones that are on it more than once
+        float values[26];       // value of the first of each letter that has one
+        uint16_t offsets[26];   // where that value starts in line, 0 if the letter has no value
+        uint16_t num_args;
+        char buf[GCODE_INLINE_SIZE];
 };
 #endif
@@ -21,11 +21,17 @@
 
 using std::string;
 #include <vector>
+#include <atomic>
 
 #define STEP_TICKER_FREQUENCY THEKERNEL->step_ticker->get_frequency()
 #define STEP_TICKER_FREQUENCY_2 (STEP_TICKER_FREQUENCY*STEP_TICKER_FREQUENCY)
 
 uint8_t Block::n_actuators= 0;
+uint32_t Block::raster_t::allocated= 0;
+
+// the blocks and this spare trade trapezoids as they are replanned, there is always one more than there are blocks
+static Block::trapezoid_t spare_trapezoid;
+Block::trapezoid_t *Block::spare= &spare_trapezoid;
 
 // A block represents a movement, it's length for each stepper motor, and the corresponding acceleration curves.
 // It's stacked on a queue, and that queue is then executed in order, to move the motors.
@@ -34,9 +40,16 @@ uint8_t Block::n_actuators= 0;
 
 Block::Block()
 {
+    trapezoid= &own_trapezoid;
     clear();
 }
 
+// the trapezoids were traded between the old blocks, so the spare may be one of theirs
+void Block::reset_spare()
+{
+    spare= &spare_trapezoid;
+}
+
 void Block::clear()
 {
     is_ready            = false;
@@ -51,6 +64,7 @@ void Block::clear()
     exit_speed          = 0.0F;
     acceleration        = 100.0F; // we don't want to get divide by zeroes if this is not set
     initial_rate        = 0.0F;
+    maximum_rate        = 0.0F;
     accelerate_until    = 0;
     decelerate_after    = 0;
     direction_bits      = 0;
@@ -59,16 +73,27 @@ void Block::clear()
     max_entry_speed     = 0.0F;
     is_ticking          = false;
     is_g123             = false;
-    locked              = false;
+    is_arc              = false;
     s_value             = 0.0F;
 
+    // always done from idle context, never from the ISR
+    delete raster;
+    raster              = nullptr;
+
     acceleration_per_tick= 0;
     deceleration_per_tick= 0;
     total_move_ticks= 0;
-    if(tick_info.size() != n_actuators) {
-        tick_info.resize(n_actuators);
-    }
-    for(auto &i : tick_info) {
+    jerk= 0;
+    cruise_speed= 0;
+    accel_time= 0;
+    cruise_time= 0;
+    decel_time= 0;
+    // whichever trapezoid this block has now, the step ticker is done with it
+    trapezoid->accelerate_until= 0;
+    trapezoid->decelerate_after= 0;
+    trapezoid->total_move_ticks= 0;
+    for (uint8_t m = 0; m < n_actuators; ++m) {
+        tickinfo_t &i= trapezoid->tick_info[m];
         i.steps_per_tick= 0;
         i.counter= 0;
         i.acceleration_change= 0;
@@ -86,7 +111,7 @@ void Block::debug() const
     for (size_t i = E_AXIS; i < n_actuators; ++i) {
         THEKERNEL->streams->printf("%c:%lu ", 'A' + i-E_AXIS, this->steps[i]);
     }
-    THEKERNEL->streams->printf("(max:%lu) nominal:r%1.4f/s%1.4f mm:%1.4f acc:%1.2f accu:%lu decu:%lu ticks:%lu rates:%1.4f/%1.4f entry/max:%1.4f/%1.4f exit:%1.4f primary:%d ready:%d locked:%d ticking:%d recalc:%d nomlen:%d time:%f\r\n",
+    THEKERNEL->streams->printf("(max:%lu) nominal:r%1.4f/s%1.4f mm:%1.4f acc:%1.2f accu:%lu decu:%lu ticks:%lu rates:%1.4f/%1.4f entry/max:%1.4f/%1.4f exit:%1.4f primary:%d ready:%d ticking:%d recalc:%d nomlen:%d time:%f\r\n",
                                this->steps_event_count,
                                this->nominal_rate,
                                this->nominal_speed,
@@ -102,7 +127,6 @@ void Block::debug() const
                                this->exit_speed,
                                this->primary_axis,
                                this->is_ready,
-                               this->locked,
                                this->is_ticking,
                                recalculate_flag ? 1 : 0,
                                nominal_length_flag ? 1 : 0,
@@ -120,10 +144,10 @@ void Block::debug() const
 //                              +-------------+
 //                                  time -->
 */
-void Block::calculate_trapezoid( float entryspeed, float exitspeed )
+bool Block::calculate_trapezoid( float entryspeed, float exitspeed )
 {
     // if block is currently executing, don't touch anything!
-    if (is_ticking) return;
+    if (is_ticking) return false;
 
     float initial_rate = this->nominal_rate * (entryspeed / this->nominal_speed); // steps/sec
     float final_rate = this->nominal_rate * (exitspeed / this->nominal_speed);
@@ -139,13 +163,13 @@ void Block::calculate_trapezoid( float entryspeed, float exitspeed )
     // Now this is the maximum rate we'll achieve this move, either because
     // it's the higher we can achieve, or because it's the higher we are
     // allowed to achieve
-    this->maximum_rate = std::min(maximum_possible_rate, this->nominal_rate);
+    float maximum_rate = std::min(maximum_possible_rate, this->nominal_rate);
 
     // Now figure out how long it takes to accelerate in seconds
-    float time_to_accelerate = ( this->maximum_rate - initial_rate ) / acceleration_per_second;
+    float time_to_accelerate = ( maximum_rate - initial_rate ) / acceleration_per_second;
 
     // Now figure out how long it takes to decelerate
-    float time_to_decelerate = ( final_rate -  this->maximum_rate ) / -acceleration_per_second;
+    float time_to_decelerate = ( final_rate -  maximum_rate ) / -acceleration_per_second;
 
     // Now we know how long it takes to accelerate and decelerate, but we must
     // also know how long the entire move takes so we can figure out how long
@@ -155,14 +179,14 @@ void Block::calculate_trapezoid( float entryspeed, float exitspeed )
     // Only if there is actually a plateau ( we are limited by nominal_rate )
     if(maximum_possible_rate > this->nominal_rate) {
         // Figure out the acceleration and deceleration distances ( in steps )
-        float acceleration_distance = ( ( initial_rate + this->maximum_rate ) / 2.0F ) * time_to_accelerate;
-        float deceleration_distance = ( ( this->maximum_rate + final_rate ) / 2.0F ) * time_to_decelerate;
+        float acceleration_distance = ( ( initial_rate + maximum_rate ) / 2.0F ) * time_to_accelerate;
+        float deceleration_distance = ( ( maximum_rate + final_rate ) / 2.0F ) * time_to_decelerate;
 
         // Figure out the plateau steps
         float plateau_distance = this->steps_event_count - acceleration_distance - deceleration_distance;
 
         // Figure out the plateau time in seconds
-        plateau_time = plateau_distance / this->maximum_rate;
+        plateau_time = plateau_distance / maximum_rate;
     }
 
     // Figure out how long the move takes total ( in seconds )
@@ -189,21 +213,28 @@ void Block::calculate_trapezoid( float entryspeed, float exitspeed )
     float acceleration_time = acceleration_ticks / STEP_TICKER_FREQUENCY;  // This can be moved into the operation below, separated for clarity, note we need to do this instead of using time_to_accelerate(seconds) directly because time_to_accelerate(seconds) and acceleration_ticks(seconds) do not have the same value anymore due to the rounding
     float deceleration_time = deceleration_ticks / STEP_TICKER_FREQUENCY;
 
-    float acceleration_in_steps = (acceleration_time > 0.0F ) ? ( this->maximum_rate - initial_rate ) / acceleration_time : 0;
-    float deceleration_in_steps =  (deceleration_time > 0.0F ) ? ( this->maximum_rate - final_rate ) / deceleration_time : 0;
-
-    // we have a potential race condition here as we could get interrupted anywhere in the middle of this call, we need to lock
-    // the updates to the blocks to get around it
-    this->locked= true;
-    // Now figure out the two acceleration ramp change events in ticks
-    this->accelerate_until = acceleration_ticks;
-    this->decelerate_after = total_move_ticks - deceleration_ticks;
+    float acceleration_in_steps = (acceleration_time > 0.0F ) ? ( maximum_rate - initial_rate ) / acceleration_time : 0;
+    float deceleration_in_steps =  (deceleration_time > 0.0F ) ? ( maximum_rate - final_rate ) / deceleration_time : 0;
 
     // Now figure out the acceleration PER TICK, this should ideally be held as a float, even a double if possible as it's very critical to the block timing
     // steps/tick^2
+    float acceleration_per_tick = acceleration_in_steps / STEP_TICKER_FREQUENCY_2;
+    float deceleration_per_tick = deceleration_in_steps / STEP_TICKER_FREQUENCY_2;
+
+    // the step ticker can take this block at any time, even part way through this call, so what it runs from is worked out
+    // in the spare trapezoid and swapped in whole. Nothing in the block changes if it took the block first
+    trapezoid_t *t = spare;
+    t->accelerate_until = acceleration_ticks;
+    t->decelerate_after = total_move_ticks - deceleration_ticks;
+    t->total_move_ticks = total_move_ticks;
+    prepare(t, initial_rate, maximum_rate, acceleration_per_tick, deceleration_per_tick);
+    if(!publish(t)) return false;
 
-    this->acceleration_per_tick = acceleration_in_steps / STEP_TICKER_FREQUENCY_2;
-    this->deceleration_per_tick = deceleration_in_steps / STEP_TICKER_FREQUENCY_2;
+    // Now figure out the two acceleration ramp change events in ticks
+    this->accelerate_until = t->accelerate_until;
+    this->decelerate_after = t->decelerate_after;
+    this->acceleration_per_tick = acceleration_per_tick;
+    this->deceleration_per_tick = deceleration_per_tick;
 
     // We now have everything we need for this block to call a Steppermotor->move method !!!!
     // Theorically, if accel is done per tick, the speed curve should be perfect.
@@ -212,17 +243,147 @@ void Block::calculate_trapezoid( float entryspeed, float exitspeed )
     //puts "accelerate_until: #{this->accelerate_until}, decelerate_after: #{this->decelerate_after}, acceleration_per_tick: #{this->acceleration_per_tick}, total_move_ticks: #{this->total_move_ticks}"
 
     this->initial_rate = initial_rate;
+    this->maximum_rate = maximum_rate;
     this->exit_speed = exitspeed;
 
-    // prepare the block for stepticker
-    this->prepare();
-    this->locked= false;
+    // only the segmenter follows the S-curve and it takes no blocks while the planner runs, so it does not need to be swapped in
+    if(this->jerk > 0) {
+        calculate_s_curve(entryspeed, exitspeed);
+    }
+
+    return true;
+}
+
+// Swaps the trapezoid t in for the step ticker. It reads the pointer once when it takes the block so it gets either the
+// old trapezoid or the new one, never a mix. Returns false if it took the block before the swap and is running the old one,
+// the block then keeps that and t stays the spare
+bool Block::publish(trapezoid_t *t)
+{
+    trapezoid_t *old = this->trapezoid;
+    // all of t must be written before the step ticker can see it
+    std::atomic_signal_fence(std::memory_order_release);
+    this->trapezoid = t;
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+
+    if(this->is_ticking && THEKERNEL->step_ticker->get_current_trapezoid() == old) {
+        this->trapezoid = old;
+        return false;
+    }
+
+    spare = old;
+    return true;
+}
+
+/*
+ * Jerk limited profile, the speed changes along an S-curve where the acceleration ramps up at the jerk limit,
+ * stays at the acceleration limit (if the speed change is big enough to reach it) and ramps back down.
+ * The ramps are symmetric, so the distance they cover is the average speed times the ramp time.
+ */
+
+// time taken to change speed by dv
+float Block::s_curve_time(float dv) const
+{
+    if(dv * this->jerk >= this->acceleration * this->acceleration) {
+        return dv / this->acceleration + this->acceleration / this->jerk;
+    }
+    return 2.0F * sqrtf(dv / this->jerk);
+}
+
+// distance covered changing speed from v0 to v1
+float Block::s_curve_distance(float v0, float v1) const
+{
+    return 0.5F * (v0 + v1) * s_curve_time(fabsf(v1 - v0));
+}
+
+// distance covered t seconds into the change of speed from v0 to v1
+float Block::s_curve_position(float v0, float v1, float t) const
+{
+    float dv = fabsf(v1 - v0);
+    float a = this->acceleration;
+    float j = this->jerk;
+    float t1, t2, ap;
+    if(dv * j >= a * a) {
+        ap = a;
+        t1 = a / j;
+        t2 = dv / a - t1;
+    } else {
+        t1 = sqrtf(dv / j);
+        ap = j * t1;
+        t2 = 0;
+    }
+    float tt = 2.0F * t1 + t2;
+    if(t > tt) t = tt;
+
+    // the distance gained over running at v0 for the whole time
+    float e;
+    if(t <= t1) {
+        e = j * t * t * t / 6.0F;
+    } else if(t <= t1 + t2) {
+        float tau = t - t1;
+        e = j * t1 * t1 * t1 / 6.0F + 0.5F * ap * t1 * tau + 0.5F * ap * tau * tau;
+    } else {
+        float u = tt - t;
+        e = 0.5F * dv * tt - (dv * u - j * u * u * u / 6.0F);
+    }
+
+    return (v1 >= v0) ? v0 * t + e : v0 * t - e;
+}
+
+// the highest speed that can be reached from (or brought down to) speed within distance
+float Block::s_curve_max_speed(float speed, float distance) const
+{
+    float a = this->acceleration;
+    float j = this->jerk;
+
+    // with a constant acceleration phase (2v + x)(x/a + a/j) = 2L, solve the quadratic for the speed change x
+    float b = 2.0F * speed / a + a / j;
+    float c = 2.0F * speed * a / j - 2.0F * distance;
+    float x = 0.5F * a * (sqrtf(b * b - 4.0F * c / a) - b);
+    if(x * j >= a * a) return speed + x;
+
+    // the acceleration limit is not reached, (2v + j y²) y = L where x = j y², newton from above converges monotonically
+    float y = cbrtf(distance / j);
+    if(speed > 0 && distance / (2.0F * speed) < y) y = distance / (2.0F * speed);
+    for (int i = 0; i < 4; ++i) {
+        y -= (j * y * y * y + 2.0F * speed * y - distance) / (3.0F * j * y * y + 2.0F * speed);
+    }
+    return speed + j * y * y;
+}
+
+// works out the S-curve for the given entry and exit speeds, the cruise speed is lowered until the ramps fit in the block
+void Block::calculate_s_curve(float entryspeed, float exitspeed)
+{
+    float vc = this->nominal_speed;
+    float d_acc = s_curve_distance(entryspeed, vc);
+    float d_dec = s_curve_distance(vc, exitspeed);
+
+    if(d_acc + d_dec > this->millimeters) {
+        float lo = std::max(entryspeed, exitspeed);
+        float hi = vc;
+        for (int i = 0; i < 12; ++i) {
+            float mid = 0.5F * (lo + hi);
+            if(s_curve_distance(entryspeed, mid) + s_curve_distance(mid, exitspeed) > this->millimeters) hi = mid;
+            else lo = mid;
+        }
+        vc = lo;
+        d_acc = s_curve_distance(entryspeed, vc);
+        d_dec = s_curve_distance(vc, exitspeed);
+    }
+
+    this->cruise_speed = vc;
+    this->accel_time = s_curve_time(vc - entryspeed);
+    this->decel_time = s_curve_time(vc - exitspeed);
+    float d_cruise = this->millimeters - d_acc - d_dec;
+    this->cruise_time = (d_cruise > 0 && vc > 0) ? d_cruise / vc : 0;
+
+    this->total_move_ticks = ceilf((this->accel_time + this->cruise_time + this->decel_time) * STEP_TICKER_FREQUENCY);
 }
 
 // Calculates the maximum allowable speed at this point when you must be able to reach target_velocity using the
 // acceleration within the allotted distance.
 float Block::max_allowable_speed(float acceleration, float target_velocity, float distance)
 {
+    if(this->jerk > 0) return s_curve_max_speed(target_velocity, distance);
     return sqrtf(target_velocity * target_velocity - 2.0F * acceleration * distance);
 }
 
@@ -296,40 +457,41 @@ float Block::max_exit_speed()
     return min(max, nominal_speed);
 }
 
-// prepare block for the step ticker, called everytime the block changes
+// prepare the trapezoid for the step ticker, called everytime the block changes
 // this is done during planning so does not delay tick generation and step ticker can simply grab the next block during the interrupt
-void Block::prepare()
+void Block::prepare(trapezoid_t *t, float initial_rate, float maximum_rate, float acceleration_per_tick, float deceleration_per_tick) const
 {
     float inv = 1.0F / this->steps_event_count;
     for (uint8_t m = 0; m < n_actuators; m++) {
+        tickinfo_t &ti = t->tick_info[m];
         uint32_t steps = this->steps[m];
-        this->tick_info[m].steps_to_move = steps;
+        ti.steps_to_move = steps;
         if(steps == 0) continue;
 
         float aratio = inv * steps;
-        this->tick_info[m].steps_per_tick = STEPTICKER_TOFP((this->initial_rate * aratio) / STEP_TICKER_FREQUENCY); // steps/sec / tick frequency to get steps per tick in 2.30 fixed point
-        this->tick_info[m].counter = 0; // 2.30 fixed point
-        this->tick_info[m].step_count = 0;
-        this->tick_info[m].next_accel_event = this->total_move_ticks + 1;
+        ti.steps_per_tick = STEPTICKER_TOFP((initial_rate * aratio) / STEP_TICKER_FREQUENCY); // steps/sec / tick frequency to get steps per tick in 2.30 fixed point
+        ti.counter = 0; // 2.30 fixed point
+        ti.step_count = 0;
+        ti.next_accel_event = t->total_move_ticks + 1;
 
         float acceleration_change = 0;
-        if(this->accelerate_until != 0) { // If the next accel event is the end of accel
-            this->tick_info[m].next_accel_event = this->accelerate_until;
-            acceleration_change = this->acceleration_per_tick;
+        if(t->accelerate_until != 0) { // If the next accel event is the end of accel
+            ti.next_accel_event = t->accelerate_until;
+            acceleration_change = acceleration_per_tick;
 
-        } else if(this->decelerate_after == 0 /*&& this->accelerate_until == 0*/) {
+        } else if(t->decelerate_after == 0 /*&& t->accelerate_until == 0*/) {
             // we start off decelerating
-            acceleration_change = -this->deceleration_per_tick;
+            acceleration_change = -deceleration_per_tick;
 
-        } else if(this->decelerate_after != this->total_move_ticks /*&& this->accelerate_until == 0*/) {
+        } else if(t->decelerate_after != t->total_move_ticks /*&& t->accelerate_until == 0*/) {
             // If the next event is the start of decel ( don't set this if the next accel event is accel end )
-            this->tick_info[m].next_accel_event = this->decelerate_after;
+            ti.next_accel_event = t->decelerate_after;
         }
 
         // convert to fixed point after scaling
-        this->tick_info[m].acceleration_change= STEPTICKER_TOFP(acceleration_change * aratio);
-        this->tick_info[m].deceleration_change= -STEPTICKER_TOFP(this->deceleration_per_tick * aratio);
-        this->tick_info[m].plateau_rate= STEPTICKER_TOFP((this->maximum_rate * aratio) / STEP_TICKER_FREQUENCY);
+        ti.acceleration_change= STEPTICKER_TOFP(acceleration_change * aratio);
+        ti.deceleration_change= -STEPTICKER_TOFP(deceleration_per_tick * aratio);
+        ti.plateau_rate= STEPTICKER_TOFP((maximum_rate * aratio) / STEP_TICKER_FREQUENCY);
     }
 }
 
@@ -338,5 +500,53 @@ float Block::get_trapezoid_rate(int i) const
 {
     // convert steps per tick from fixed point to float and convert to steps/sec
     // FIXME steps_per_tick can change at any time, potential race condition if it changes while being read here
-    return STEPTICKER_FROMFP(tick_info[i].steps_per_tick) * STEP_TICKER_FREQUENCY;
+    return STEPTICKER_FROMFP(trapezoid->tick_info[i].steps_per_tick) * STEP_TICKER_FREQUENCY;
+}
+
+// returns how far along the primary axis (in steps of steps_event_count) the trapezoid is at the given tick
+// used by the step segmenter to sample the velocity profile off the ISR
+float Block::get_steps_at(float tick) const
+{
+    if(this->jerk > 0) {
+        float t = tick / STEP_TICKER_FREQUENCY;
+        float mm;
+        if(t <= this->accel_time) {
+            mm = s_curve_position(this->entry_speed, this->cruise_speed, t);
+        } else {
+            mm = s_curve_distance(this->entry_speed, this->cruise_speed);
+            t -= this->accel_time;
+            if(t <= this->cruise_time) {
+                mm += this->cruise_speed * t;
+            } else {
+                mm += this->cruise_speed * this->cruise_time + s_curve_position(this->cruise_speed, this->exit_speed, t - this->cruise_time);
+            }
+        }
+
+        float s = mm * this->steps_event_count / this->millimeters;
+        if(s > this->steps_event_count) s = this->steps_event_count;
+        return s;
+    }
+
+    float v0 = this->initial_rate / STEP_TICKER_FREQUENCY;
+    float vmax = this->maximum_rate / STEP_TICKER_FREQUENCY;
+    float ta = this->accelerate_until;
+    float td = this->decelerate_after;
+
+    float s;
+    if(tick <= ta) {
+        s = (v0 + 0.5F * this->acceleration_per_tick * tick) * tick;
+
+    } else {
+        s = (v0 + 0.5F * this->acceleration_per_tick * ta) * ta;
+        if(tick <= td) {
+            s += vmax * (tick - ta);
+
+        } else {
+            float t = tick - td;
+            s += vmax * (td - ta) + (vmax - 0.5F * this->deceleration_per_tick * t) * t;
+        }
+    }
+
+    if(s > this->steps_event_count) s = this->steps_event_count;
+    return s;
 }
@@ -7,14 +7,14 @@
 
 #pragma once
 
-#include <vector>
 #include <bitset>
+#include <vector>
 #include "ActuatorCoordinates.h"
 
 class Block {
     public:
         Block();
-        void calculate_trapezoid( float entry_speed, float exit_speed );
+        bool calculate_trapezoid( float entry_speed, float exit_speed );
         float max_allowable_speed( float acceleration, float target_velocity, float distance);
 
         float reverse_pass(float exit_speed);
@@ -23,9 +23,19 @@ class Block {
         void debug() const;
         void ready() { is_ready= true; }
         void clear();
-        void prepare();
+        static void reset_spare();
 
         float get_trapezoid_rate(int i) const;
+        float get_steps_at(float tick) const;
+
+    private:
+        float s_curve_max_speed(float speed, float distance) const;
+        float s_curve_time(float dv) const;
+        float s_curve_distance(float v0, float v1) const;
+        float s_curve_position(float v0, float v1, float t) const;
+        void calculate_s_curve(float entryspeed, float exitspeed);
+
+    public:
 
         std::array<uint32_t, k_max_actuators> steps; // Number of steps for each axis for this block
         uint32_t steps_event_count;  // Steps for the longest axis
@@ -41,6 +51,13 @@ class Block {
         float acceleration_per_tick{0};
         float deceleration_per_tick {0};
 
+        // jerk limited (S-curve) profile, only used when jerk is set, the segmenter follows this instead of the trapezoid
+        float jerk;               // mm/sec³
+        float cruise_speed;       // mm/sec
+        float accel_time;         // seconds
+        float cruise_time;
+        float decel_time;
+
         float max_entry_speed;
 
         // this is tick info needed for this block. applies to all motors
@@ -61,9 +78,41 @@ class Block {
             uint32_t next_accel_event;
         };
 
-        // need info for each active motor
-        //std::array<tickinfo_t, k_max_actuators> tick_info;
-        std::vector<tickinfo_t> tick_info;
+        // geometry of an arc block, the step segmenter steps along the arc instead of a straight line
+        // the arc never crosses a quadrant so each motor keeps the same direction for the whole block
+        using arc_t= struct {
+            float center[2];         // in the plane of the arc, mm
+            float radius;
+            float start_angle;       // radians
+            float angular_travel;    // radians, positive is CCW
+            float linear_start;      // the axis perpendicular to the plane, mm
+            float linear_travel;
+            int32_t start_steps[3];  // motor positions at the start of the arc
+            uint8_t axis[3];         // the two plane axis then the linear axis, also the motor index
+        };
+        arc_t arc;
+
+        // a laser raster scan line, the power of each pixel along the block, the step ticker works out which pixel the
+        // laser is on from the lead motor's steps. The block owns it once queued and deletes it when cleared
+        struct raster_t {
+            raster_t(uint16_t n) : power(n, 0) { allocated += n; }
+            ~raster_t() { allocated -= power.size(); }
+            std::vector<uint8_t> power;       // 0 to 255 of the laser's maximum power
+            uint32_t pixels_per_step{0};      // 8.24 fixed point, set by the planner
+            static uint32_t allocated;        // pixels held by all the rasters, they are never made or deleted in the ISR
+        };
+        raster_t *raster{nullptr};
+
+        // what the step ticker steps this block from, the ticks of the trapezoid and the state of each motor, only the
+        // first n_actuators are used. The planner works out a new one in the spare and swaps it in, so the step ticker
+        // always gets a whole trapezoid and never has to skip a tick while the block is replanned
+        struct trapezoid_t {
+            uint32_t accelerate_until;
+            uint32_t decelerate_after;
+            uint32_t total_move_ticks;
+            std::array<tickinfo_t, k_max_actuators> tick_info;
+        };
+        trapezoid_t * volatile trapezoid;
         static uint8_t n_actuators;
 
         struct {
@@ -72,8 +121,15 @@ class Block {
             bool is_ready:1;
             bool primary_axis:1;                 // set if this move is a primary axis
             bool is_g123:1;                      // set if this is a G1, G2 or G3
+            bool is_arc:1;                       // set if arc holds the path of this block
             volatile bool is_ticking:1;          // set when this block is being actively ticked by the stepticker
-            volatile bool locked:1;              // set to true when the critical data is being updated, stepticker will have to skip if this is set
             uint16_t s_value:12;                 // for laser 1.11 Fixed point
         };
+
+    private:
+        void prepare(trapezoid_t *t, float initial_rate, float maximum_rate, float acceleration_per_tick, float deceleration_per_tick) const;
+        bool publish(trapezoid_t *t);
+
+        trapezoid_t own_trapezoid;    // brought by this block, other blocks or the spare may be using it by now
+        static trapezoid_t *spare;
 };
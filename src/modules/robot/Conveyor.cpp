@@ -23,7 +23,12 @@
 #include "StepTicker.h"
 #include "Robot.h"
 #include "StepperMotor.h"
+#include "StepSegmenter.h"
+#include "Gcode.h"
+#include "StreamOutput.h"
+#include "platform_memory.h"
 
+#include <algorithm>
 #include <functional>
 #include <vector>
 
@@ -31,6 +36,26 @@
 
 #define planner_queue_size_checksum CHECKSUM("planner_queue_size")
 #define queue_delay_time_ms_checksum CHECKSUM("queue_delay_time_ms")
+#define queue_lookahead_ms_checksum CHECKSUM("queue_lookahead_ms")
+#define step_segment_ms_checksum CHECKSUM("step_segment_ms")
+
+#define SHAPER_CHECKSUMS(X) {           \
+    CHECKSUM(X "_shaper_type"),         \
+    CHECKSUM(X "_shaper_frequency"),    \
+    CHECKSUM(X "_shaper_damping")       \
+}
+
+// the queue only goes in AHB0 if this much is left after it for modules that allocate at runtime
+#define QUEUE_AHB0_RESERVE 2048
+#define DEFAULT_QUEUE_SIZE 32
+#define AUTO_QUEUE_MAX 128
+// what is tried when the configured size does not fit
+#define FALLBACK_QUEUE_SIZE 8
+
+// the lowest feed override
+#define MIN_FEED_OVERRIDE 0.1F
+// longest idle interval the time scale ramp allows for, so a slow idle loop can't make it jump
+#define MAX_SCALE_STEP_S 0.01F
 
 /*
  * The conveyor holds the queue of blocks, takes care of creating them, and starting the executing chain of blocks
@@ -66,31 +91,231 @@ Conveyor::Conveyor()
     halted = false;
     allow_fetch = false;
     flush= false;
+    supplied= false;
 }
 
 void Conveyor::on_module_loaded()
 {
     register_for_event(ON_IDLE);
     register_for_event(ON_HALT);
+    register_for_event(ON_GCODE_RECEIVED);
 
     // Attach to the end_of_move stepper event
     //THEKERNEL->step_ticker->finished_fnc = std::bind( &Conveyor::all_moves_finished, this);
-    queue_size = THEKERNEL->config->value(planner_queue_size_checksum)->by_default(32)->as_number();
+    // 0 sizes the queue from the free AHB0 RAM once everything else has been loaded, never less than the default
+    queue_size = THEKERNEL->config->value(planner_queue_size_checksum)->by_default(DEFAULT_QUEUE_SIZE)->as_number();
     queue_delay_time_ms = THEKERNEL->config->value(queue_delay_time_ms_checksum)->by_default(100)->as_number();
+    // if set the step ticker starts once this much motion is queued instead of waiting for a full queue or queue_delay_time_ms
+    queue_lookahead_ms = THEKERNEL->config->value(queue_lookahead_ms_checksum)->by_default(0)->as_number();
+    // if set blocks are cut into constant rate segments of this length before they get to the step ticker
+    step_segment_ms = THEKERNEL->config->value(step_segment_ms_checksum)->by_default(0)->as_number();
+
+    // input shaping of the first three actuators, only done when the blocks are cut into segments
+    const uint16_t checksums[][3] = {
+        SHAPER_CHECKSUMS("alpha"),
+        SHAPER_CHECKSUMS("beta"),
+        SHAPER_CHECKSUMS("gamma")
+    };
+    for (int i = 0; i < 3; ++i) {
+        InputShaper::TYPE_T type = InputShaper::type_from_string(THEKERNEL->config->value(checksums[i][0])->by_default("none")->as_string());
+        float frequency = THEKERNEL->config->value(checksums[i][1])->by_default(0)->as_number();
+        float damping = THEKERNEL->config->value(checksums[i][2])->by_default(0.1F)->as_number();
+        shapers[i].set(type, frequency, damping);
+    }
 }
 
 // we allocate the queue here after config is completed so we do not run out of memory during config
 void Conveyor::start(uint8_t n)
 {
-    Block::n_actuators= n; // set the number of motors which determines how big the tick info vector is
-    queue.resize(queue_size);
+    Block::n_actuators= n; // set the number of motors which determines how big the tick info is
+    if(!resize_queue(queue_size)) {
+        THEKERNEL->streams->printf("Error: not enough memory for a planner queue of %u blocks\n", queue_size);
+        resize_queue(FALLBACK_QUEUE_SIZE);
+    }
+    if(step_segment_ms > 0) {
+        segmenter = new StepSegmenter(step_segment_ms, shapers);
+        THEKERNEL->step_ticker->refill_fnc = std::bind(&StepSegmenter::prepare, segmenter);
+        THEKERNEL->step_ticker->set_segment_mode(true);
+    }
     running = true;
 }
 
+// The blocks live in one contiguous arena, in AHB0 if it fits there with QUEUE_AHB0_RESERVE left over, otherwise on
+// the heap. Must only be called when the queue is empty and the step ticker is idle
+bool Conveyor::resize_queue(unsigned int n)
+{
+    if(!queue.is_empty() || queue.isr_tail_i != queue.tail_i) return false;
+    if(n == 1) return false;
+
+    size_t block_size= sizeof(Block);
+    prep_locked= true;
+
+    // the old arena is freed first so it can be reused
+    void *old_arena= arena;
+    bool old_in_ahb0= arena_in_ahb0;
+    unsigned int old_length= queue.length;
+    if(old_arena != nullptr) {
+        queue.resize(0);
+        for (unsigned int i = 0; i < old_length; ++i) ((Block*)old_arena)[i].~Block();
+        if(old_in_ahb0) AHB0.dealloc(old_arena);
+        else free(old_arena);
+        arena= nullptr;
+    }
+
+    if(n == 0) {
+        // as many as fit in AHB0 above the reserve, but a deeper queue than the default is the only reason for it
+        uint32_t f= AHB0.free();
+        n= (f > QUEUE_AHB0_RESERVE) ? (f - QUEUE_AHB0_RESERVE) / block_size : 0;
+        if(n > AUTO_QUEUE_MAX) n= AUTO_QUEUE_MAX;
+        if(n < DEFAULT_QUEUE_SIZE) n= DEFAULT_QUEUE_SIZE;
+    }
+
+    size_t size= n * block_size;
+    void *v= nullptr;
+    if(AHB0.free() >= size + QUEUE_AHB0_RESERVE) v= AHB0.alloc(size);
+    arena_in_ahb0= (v != nullptr);
+    if(v == nullptr) v= malloc(size);
+    if(v == nullptr) {
+        prep_locked= false;
+        return false;
+    }
+
+    Block *blocks= (Block*)v;
+    for (unsigned int i = 0; i < n; ++i) {
+        new(&blocks[i]) Block();
+    }
+    Block::reset_spare();
+
+    arena= v;
+    queue.provide(blocks, n);
+    queue_size= n;
+    prep_i= planned_i= 0;
+    prep_locked= false;
+
+    depth_high_water= depth_sum= depth_samples= starved_count= underrun_count= 0;
+    return true;
+}
+
+// M398 - report the queue stats, M398 Snnn - resize the queue to nnn blocks, S0 sizes it from free AHB0 RAM but never
+// below the default
+void Conveyor::on_gcode_received(void *argument)
+{
+    Gcode *gcode = static_cast<Gcode*>(argument);
+    if(!gcode->has_m) return;
+    if(gcode->m == 593 || gcode->m == 500 || gcode->m == 503) {
+        handle_shaper_gcode(gcode);
+        return;
+    }
+    if(gcode->m != 398) return;
+
+    if(gcode->has_letter('S')) {
+        // the queue can only be changed when nothing is queued or moving
+        wait_for_idle();
+        unsigned int n= gcode->get_value('S');
+        if(!resize_queue(n)) {
+            gcode->stream->printf("Error: could not resize the planner queue to %u, using %u blocks\n", n, queue_size);
+            if(queue.length == 0) resize_queue(FALLBACK_QUEUE_SIZE);
+        }
+    }
+
+    dump_stats(gcode->stream);
+}
+
+/*
+    M593 - report the input shapers
+    M593 [A B C]<frequency> [S<type>] [D<damping>] - sets the shaper of alpha, beta and/or gamma, a frequency of 0 turns it off
+        S 0 none, 1 zv, 2 zvd, 3 mzv, and D the damping ratio, both apply to the actuators given or all three if none are
+*/
+void Conveyor::handle_shaper_gcode(Gcode *gcode)
+{
+    static const char names[3][6] = {"alpha", "beta", "gamma"};
+
+    if(gcode->m == 500 || gcode->m == 503) {
+        if(segmenter == nullptr) return;
+        gcode->stream->printf(";Input shaping, S0 none S1 zv S2 zvd S3 mzv:\n");
+        for (int i = 0; i < 3; ++i) {
+            const InputShaper &sh = shapers[i];
+            gcode->stream->printf("M593 %c%1.2f S%d D%1.4f\n", 'A' + i, sh.get_frequency(), sh.get_type(), sh.get_damping());
+        }
+        return;
+    }
+
+    if(segmenter == nullptr) {
+        gcode->stream->printf("Error: input shaping needs step_segment_ms to be set\n");
+        return;
+    }
+
+    bool any = gcode->has_letter('A') || gcode->has_letter('B') || gcode->has_letter('C');
+    if(any || gcode->has_letter('S') || gcode->has_letter('D')) {
+        // the shapers look back over the motion already stepped so they can only be changed when everything has stopped
+        wait_for_idle();
+        for (int i = 0; i < 3; ++i) {
+            char c = 'A' + i;
+            if(any && !gcode->has_letter(c)) continue;
+
+            InputShaper &sh = shapers[i];
+            InputShaper::TYPE_T type = sh.get_type();
+            float frequency = gcode->has_letter(c) ? gcode->get_value(c) : sh.get_frequency();
+            float damping = gcode->has_letter('D') ? gcode->get_value('D') : sh.get_damping();
+            if(gcode->has_letter('S')) {
+                int t = gcode->get_int('S');
+                type = (t >= InputShaper::ZV && t <= InputShaper::MZV) ? (InputShaper::TYPE_T)t : InputShaper::NONE;
+            } else if(type == InputShaper::NONE) {
+                type = InputShaper::MZV;
+            }
+            if(frequency <= 0) type = InputShaper::NONE;
+            sh.set(type, frequency, damping);
+        }
+        segmenter->reset_shaping();
+    }
+
+    for (int i = 0; i < 3; ++i) {
+        const InputShaper &sh = shapers[i];
+        if(sh.is_enabled()) {
+            gcode->stream->printf("%s shaper: %s %1.2f Hz damping %1.4f, %1.1f ms\n", names[i], InputShaper::type_name(sh.get_type()),
+                sh.get_frequency(), sh.get_damping(), sh.get_duration() * 1000);
+        } else {
+            gcode->stream->printf("%s shaper: none\n", names[i]);
+        }
+    }
+}
+
+void Conveyor::dump_stats(StreamOutput *stream)
+{
+    stream->printf("planner queue: %u blocks of %u bytes in %s\n", queue.length, sizeof(Block), arena_in_ahb0 ? "AHB0" : "heap");
+    stream->printf("queue depth: high water %lu, mean %1.2f, starved %lu\n", depth_high_water,
+        depth_samples > 0 ? (float)depth_sum / depth_samples : 0.0F, starved_count);
+    stream->printf("motion buffered: %1.1f ms, underruns %lu\n", get_buffered_ms(), underrun_count);
+}
+
+// planned blocks know how long they take, the ones still waiting for the planner are counted at their nominal speed
+float Conveyor::get_buffered_ms()
+{
+    uint32_t ticks= 0;
+    float seconds= 0;
+    for (unsigned int i = queue.isr_tail_i; i != queue.head_i; i = queue.next(i)) {
+        Block *b= queue.item_ref(i);
+        if(b->is_ticking) continue;
+        if(b->total_move_ticks > 0) ticks += b->total_move_ticks;
+        else if(b->nominal_speed > 0) seconds += b->millimeters / b->nominal_speed;
+    }
+    return (ticks / THEKERNEL->step_ticker->get_frequency() + seconds) * 1000.0F;
+}
+
+Block *Conveyor::get_planned_block(unsigned int n)
+{
+    unsigned int i= queue.isr_tail_i;
+    if(n >= (planned_i + queue.length - i) % queue.length) return nullptr;
+    return queue.item_ref((i + n) % queue.length);
+}
+
 void Conveyor::on_halt(void* argument)
 {
     if(argument == nullptr) {
         halted = true;
+        // a halt also ends any feed hold so the step ticker can throw the blocks away
+        THEKERNEL->set_feed_hold(false);
+        THEKERNEL->step_ticker->set_time_scale(feed_override);
         flush_queue();
     } else {
         halted = false;
@@ -103,6 +328,14 @@ void Conveyor::on_idle(void*)
         check_queue();
     }
 
+    // plan the blocks queued since the last replan, only does something when the planner is batching
+    if(!flush) THEKERNEL->planner->check_replan();
+
+    // keep the step ticker supplied with segments, the step ticker asks for more itself as it uses them
+    if(segmenter != nullptr) THEKERNEL->step_ticker->request_refill();
+
+    update_time_scale();
+
     // we can garbage collect the block queue here
     if (queue.tail_i != queue.isr_tail_i) {
         if (queue.is_empty()) {
@@ -117,6 +350,48 @@ void Conveyor::on_idle(void*)
     }
 }
 
+void Conveyor::set_feed_override(float f)
+{
+    feed_override = std::min(std::max(f, MIN_FEED_OVERRIDE), 1.0F);
+}
+
+// The feed hold and feed override are done by scaling the step ticker time, so they take effect within a step event
+// rather than after everything already queued. The actual speed is the planned speed times the scale, the scale is
+// ramped so that speed moves towards the target by no more than the acceleration of the block being stepped, whatever
+// the planned profile is doing at the time. A hold ramps all the way down to a standstill and a resume up from it
+void Conveyor::update_time_scale()
+{
+    uint32_t now = us_ticker_read();
+    float dt = std::min((now - last_scale_time) / 1000000.0F, MAX_SCALE_STEP_S);
+    last_scale_time = now;
+
+    StepTicker *st = THEKERNEL->step_ticker;
+    float scale = st->get_time_scale();
+    float target = THEKERNEL->get_feed_hold() ? 0.0F : feed_override;
+    const Block *block = st->get_current_block();
+    float planned = (block != nullptr) ? st->get_planned_speed() * block->nominal_speed : 0;
+    if(scale == target) {
+        scaled_speed = scale * planned;
+        return;
+    }
+
+    if(planned <= 0 || block->acceleration <= 0) {
+        // nothing is moving so it can change straight away
+        st->set_time_scale(target);
+        scaled_speed = 0;
+        return;
+    }
+
+    // the planned profile has already changed the speed since the last update, that comes out of the same acceleration
+    float dv = dt * block->acceleration;
+    float speed = std::min(std::max(target * planned, scaled_speed - dv), scaled_speed + dv);
+    float s = std::max(speed, 0.0F) / planned;
+    // never away from the target, when the planned profile changes the speed the right way it can just be held
+    s = (target > scale) ? std::min(std::max(s, scale), target) : std::min(std::max(s, target), scale);
+    st->set_time_scale(s);
+    scaled_speed = s * planned;
+}
+
 // see if we are idle
 // this checks the block queue is empty, and that the step queue is empty and
 // checks that all motors are no longer moving
@@ -150,6 +425,8 @@ void Conveyor::wait_for_idle(bool wait_for_motors)
         }
     }
 
+    // the step ticker running dry here was intended and is not an underrun
+    starved_time= 0;
     running = true;
     // returning now means that everything has totally finished
 }
@@ -172,7 +449,17 @@ void Conveyor::queue_head_block()
         return; // if we got a halt then we are done here
     }
 
+    // the step ticker ran dry while the host was still sending, so it was not sending fast enough
+    bool was_empty= queue.isr_tail_i == queue.head_i;
+    uint32_t wait_ms= queue_lookahead_ms > 0 ? queue_lookahead_ms : queue_delay_time_ms;
+    if(was_empty && starved_time != 0 && (us_ticker_read() - starved_time) < wait_ms * 1000) underrun_count++;
+
     queue.produce_head();
+    // the lookahead wait is from the last block queued, so the step ticker starts once the host stops sending
+    if(queue_lookahead_ms > 0) last_time_check= us_ticker_read();
+
+    uint32_t depth= get_queue_depth();
+    if(depth > depth_high_water) depth_high_water= depth;
 
     // not sure if this is the correct place but we need to turn on the motors if they were not already on
     THEKERNEL->call_event(ON_ENABLE, (void*)1); // turn all enable pins on
@@ -180,17 +467,25 @@ void Conveyor::queue_head_block()
 
 void Conveyor::check_queue(bool force)
 {
-    static uint32_t last_time_check = us_ticker_read();
-
     if(queue.is_empty()) {
         allow_fetch = false;
         last_time_check = us_ticker_read(); // reset timeout
         return;
     }
 
+    if(allow_fetch) return;
+
     // if we have been waiting for more than the required waiting time and the queue is not empty, or the queue is full, then allow stepticker to get the tail
     // we do this to allow an idle system to pre load the queue a bit so the first few blocks run smoothly.
-    if(force || queue.is_full() || (us_ticker_read() - last_time_check) >= (queue_delay_time_ms * 1000)) {
+    // With queue_lookahead_ms set it starts as soon as that much motion is queued, and waits that long for more otherwise
+    bool ready;
+    if(queue_lookahead_ms > 0) {
+        ready= get_buffered_ms() >= queue_lookahead_ms || (us_ticker_read() - last_time_check) >= (queue_lookahead_ms * 1000);
+    } else {
+        ready= (us_ticker_read() - last_time_check) >= (queue_delay_time_ms * 1000);
+    }
+
+    if(force || queue.is_full() || ready) {
         last_time_check = us_ticker_read(); // reset timeout
         if(!flush) allow_fetch = true;
         return;
@@ -210,24 +505,70 @@ bool Conveyor::get_next_block(Block **block)
     // default the feerate to zero if there is no block available
     this->current_feedrate= 0;
 
-    if(halted || queue.isr_tail_i == queue.head_i) return false; // we do not have anything to give
-
-    // wait for queue to fill up, optimizes planning
-    if(!allow_fetch) return false;
+    if(halted || queue.isr_tail_i == queue.head_i || queue.isr_tail_i == planned_i || !allow_fetch) {
+        // nothing we can give, either nothing is queued, it has not been planned yet or we wait for the queue to fill up
+        update_fetch_stats(false);
+        return false;
+    }
 
+    // the planner never leaves a block half updated, it swaps a whole new trapezoid in so this can always be taken
     Block *b= queue.item_ref(queue.isr_tail_i);
-    // we cannot use this now if it is being updated
-    if(!b->locked) {
+    if(!b->is_ready) __debugbreak(); // should never happen
+
+    b->is_ticking= true;
+    b->recalculate_flag= false;
+    this->current_feedrate= b->nominal_speed;
+    *block= b;
+    update_fetch_stats(true);
+    return true;
+}
+
+// called from the step segmenter in PendSV, hands out the blocks in the same order as get_next_block but ahead of
+// the step ticker. When flushing the blocks are handed out to be discarded, so they still get finished by the step ticker in order.
+// Nothing is handed out while the planner or a resize has the queue, the segmenter is refilled again once they are done
+bool Conveyor::get_next_prep_block(Block **block, bool& discard)
+{
+    if(prep_locked) return false;
+
+    if(prep_i == queue.head_i) {
+        update_fetch_stats(false);
+        return false;
+    }
+
+    discard= flush;
+    if(!discard) {
+        if(halted || !allow_fetch || prep_i == planned_i) {
+            update_fetch_stats(false);
+            return false;
+        }
+
+        Block *b= queue.item_ref(prep_i);
         if(!b->is_ready) __debugbreak(); // should never happen
 
         b->is_ticking= true;
         b->recalculate_flag= false;
         this->current_feedrate= b->nominal_speed;
-        *block= b;
-        return true;
+        update_fetch_stats(true);
     }
 
-    return false;
+    *block= queue.item_ref(prep_i);
+    prep_i= queue.next(prep_i);
+    return true;
+}
+
+// counts the times the blocks run out, and the depth of the queue each block sees when it gets fetched
+void Conveyor::update_fetch_stats(bool fetched)
+{
+    if(fetched) {
+        depth_sum += get_queue_depth();
+        depth_samples++;
+        supplied= true;
+
+    } else if(supplied) {
+        starved_count++;
+        starved_time= us_ticker_read();
+        supplied= false;
+    }
 }
 
 // called from step ticker ISR when block is finished, do not do anything slow here
@@ -254,6 +595,8 @@ void Conveyor::flush_queue()
     // now wait until the block queue has been flushed
     wait_for_idle(false);
 
+    // the flushed blocks were never planned
+    planned_i= queue.head_i;
     flush= false;
 }
 
@@ -9,9 +9,19 @@
 
 #include "libs/Module.h"
 #include "HeapRing.h"
+#include "InputShaper.h"
+
+// grbl 1.1 real time feed override commands, they are handled by the consoles as they are received
+#define FEED_OVERRIDE_RESET      0x90
+#define FEED_OVERRIDE_PLUS_10    0x91
+#define FEED_OVERRIDE_MINUS_10   0x92
+#define FEED_OVERRIDE_PLUS_1     0x93
+#define FEED_OVERRIDE_MINUS_1    0x94
 
 class Gcode;
 class Block;
+class StepSegmenter;
+class StreamOutput;
 
 class Conveyor : public Module
 {
@@ -22,19 +32,41 @@ public:
     void on_module_loaded(void);
     void on_idle(void *);
     void on_halt(void *);
+    void on_gcode_received(void *);
 
     void wait_for_idle(bool wait_for_motors=true);
     bool is_queue_empty() { return queue.is_empty(); };
     bool is_queue_full() { return queue.is_full(); };
     bool is_idle() const;
+    // number of blocks queued that have not yet been finished by the step ticker
+    size_t get_queue_depth() const { return (queue.head_i + queue.length - queue.isr_tail_i) % queue.length; }
+    size_t get_queue_size() const { return queue.length; }
+    // the nth planned block the step ticker has not finished, nullptr past the last one
+    Block *get_planned_block(unsigned int n);
+    // resizes the block queue, must only be called when idle, 0 sizes it from the free AHB0 RAM but never below 32
+    bool resize_queue(unsigned int n);
+    void dump_stats(StreamOutput *stream);
+    // ms of motion queued that the step ticker has not started yet
+    float get_buffered_ms();
+    // times the step ticker ran out of blocks and the next one turned up shortly after
+    uint32_t get_underrun_count() const { return underrun_count; }
 
     // returns next available block writes it to block and returns true
     bool get_next_block(Block **block);
+    // returns the next block for the step segmenter, discard is set if it is being flushed
+    bool get_next_prep_block(Block **block, bool& discard);
     void block_finished();
 
     void dump_queue(void);
     void flush_queue(void);
     float get_current_feedrate() const { return current_feedrate; }
+    // real time feed override as a fraction of the planned speed, it does not replan so it can only slow things down
+    void set_feed_override(float f);
+    float get_feed_override() const { return feed_override; }
+    // 0 when the blocks are not cut into segments
+    float get_step_segment_ms() const { return segmenter != nullptr ? step_segment_ms : 0; }
+    // input shaper of alpha, beta or gamma
+    const InputShaper& get_shaper(int i) const { return shapers[i]; }
 
     friend class Planner; // for queue
 
@@ -42,20 +74,45 @@ private:
     // void all_moves_finished();
     void check_queue(bool force= false);
     void queue_head_block(void);
+    void update_fetch_stats(bool fetched);
+    void update_time_scale();
+    void handle_shaper_gcode(Gcode *gcode);
 
     using  Queue_t= HeapRing<Block>;
     Queue_t queue;  // Queue of Blocks
+    unsigned int prep_i{0}; // next block for the step segmenter, lives between isr_tail_i and head_i
+    volatile bool prep_locked{false}; // set from idle while the blocks the step segmenter has not taken are being changed
+    volatile unsigned int planned_i{0}; // blocks before this have been planned and can be handed out, lives between isr_tail_i and head_i
+    StepSegmenter *segmenter{nullptr};
+    InputShaper shapers[3]; // for alpha, beta and gamma, only used by the step segmenter
+    void *arena{nullptr};   // holds the queue Blocks
+    bool arena_in_ahb0{false};
     //volatile unsigned int gc_pending;
 
     uint32_t queue_delay_time_ms;
+    float queue_lookahead_ms;
+    uint32_t last_time_check{0};
     size_t queue_size;
+    float step_segment_ms;
     float current_feedrate{0}; // actual nominal feedrate that current block is running at in mm/sec
+    float feed_override{1};
+    uint32_t last_scale_time{0};
+    float scaled_speed{0}; // mm/sec, the speed the time scale was last set to give
+
+    // queue occupancy stats, updated as the blocks are queued and fetched
+    uint32_t depth_high_water{0};
+    uint32_t depth_sum{0};        // queue depth seen by each block when it was fetched
+    uint32_t depth_samples{0};
+    uint32_t starved_count{0};    // times the step ticker ran out of blocks
+    uint32_t underrun_count{0};
+    volatile uint32_t starved_time{0}; // us_ticker time the step ticker last ran out of blocks
 
     struct {
         volatile bool running:1;
         volatile bool halted:1;
         volatile bool allow_fetch:1;
         bool flush:1;
+        volatile bool supplied:1; // the last fetch got a block
     };
 
 };
@@ -0,0 +1,84 @@
+/*
+      This file is part of Smoothie (http://smoothieware.org/). The motion control part is heavily based on Grbl (https://github.com/simen/grbl).
+      Smoothie is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+      Smoothie is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+      You should have received a copy of the GNU General Public License along with Smoothie. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "InputShaper.h"
+
+#include <math.h>
+
+// frequency is the resonance in Hz and damping its damping ratio, a frequency of 0 turns the shaper off
+void InputShaper::set(TYPE_T type, float frequency, float damping)
+{
+    this->type = type;
+    this->frequency = frequency;
+    this->damping = damping;
+    n = 0;
+    if(type == NONE || frequency <= 0 || damping < 0 || damping >= 1) return;
+
+    // the damped period of the resonance
+    float s = sqrtf(1.0F - damping * damping);
+    float td = 1.0F / (frequency * s);
+
+    switch(type) {
+        case ZV: {
+            float k = expf(-damping * M_PI / s);
+            amplitude[0] = 1;
+            amplitude[1] = k;
+            time[0] = 0;
+            time[1] = td / 2;
+            n = 2;
+            break;
+        }
+        case ZVD: {
+            float k = expf(-damping * M_PI / s);
+            amplitude[0] = 1;
+            amplitude[1] = 2 * k;
+            amplitude[2] = k * k;
+            time[0] = 0;
+            time[1] = td / 2;
+            time[2] = td;
+            n = 3;
+            break;
+        }
+        case MZV: {
+            // the impulses are 3/8 of a period apart, shorter than ZVD for much the same tolerance to a wrong frequency
+            float k = expf(-0.75F * damping * M_PI / s);
+            float a1 = 1.0F - 1.0F / sqrtf(2.0F);
+            amplitude[0] = a1;
+            amplitude[1] = (sqrtf(2.0F) - 1.0F) * k;
+            amplitude[2] = a1 * k * k;
+            time[0] = 0;
+            time[1] = 0.375F * td;
+            time[2] = 0.75F * td;
+            n = 3;
+            break;
+        }
+        default:
+            return;
+    }
+
+    float sum = 0;
+    for (int i = 0; i < n; ++i) sum += amplitude[i];
+    for (int i = 0; i < n; ++i) amplitude[i] /= sum;
+}
+
+InputShaper::TYPE_T InputShaper::type_from_string(const std::string& s)
+{
+    if(s == "zv") return ZV;
+    if(s == "zvd") return ZVD;
+    if(s == "mzv") return MZV;
+    return NONE;
+}
+
+const char *InputShaper::type_name(TYPE_T t)
+{
+    switch(t) {
+        case ZV: return "zv";
+        case ZVD: return "zvd";
+        case MZV: return "mzv";
+        default: return "none";
+    }
+}
@@ -0,0 +1,39 @@
+/*
+      This file is part of Smoothie (http://smoothieware.org/). The motion control part is heavily based on Grbl (https://github.com/simen/grbl).
+      Smoothie is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+      Smoothie is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+      You should have received a copy of the GNU General Public License along with Smoothie. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <string>
+
+// The impulses of a ZV, ZVD or MZV input shaper. An actuator's motion convolved with them no longer excites
+// a resonance at the shaper's frequency, at the cost of being spread out over the shaper's duration
+class InputShaper
+{
+public:
+    enum TYPE_T { NONE, ZV, ZVD, MZV };
+
+    void set(TYPE_T type, float frequency, float damping);
+    TYPE_T get_type() const { return type; }
+    float get_frequency() const { return frequency; }
+    float get_damping() const { return damping; }
+    // seconds from the first impulse to the last
+    float get_duration() const { return n > 0 ? time[n - 1] : 0; }
+    bool is_enabled() const { return n > 0; }
+
+    static TYPE_T type_from_string(const std::string& s);
+    static const char *type_name(TYPE_T t);
+
+    uint8_t n{0};           // number of impulses, 0 when off
+    float amplitude[3];     // they add up to 1
+    float time[3];          // seconds, the first is always 0
+
+private:
+    TYPE_T type{NONE};
+    float frequency{0};
+    float damping{0};
+};
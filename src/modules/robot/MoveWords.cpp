@@ -0,0 +1,22 @@
+/*
+      This file is part of Smoothie (http://smoothieware.org/). The motion control part is heavily based on Grbl (https://github.com/simen/grbl).
+      Smoothie is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+      Smoothie is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+      You should have received a copy of the GNU General Public License along with Smoothie. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "MoveWords.h"
+#include "Gcode.h"
+
+const char MoveWords::letters[]= "XYZEABCIJKFS";
+
+MoveWords::MoveWords(const Gcode *gcode, bool inch_mode) : mask(0)
+{
+    for (int w = 0; w < NUMBER_OF_WORDS; ++w) {
+        if(!gcode->has_letter(letters[w])) continue;
+        float v= gcode->get_value(letters[w]);
+        // the lengths and the feed rate, E is left to the extruder which may be in mm³ and ABC may be rotary
+        if(inch_mode && (w <= MOVE_Z || (w >= MOVE_I && w <= MOVE_F))) v *= 25.4F;
+        set((WORD)w, v);
+    }
+}
@@ -0,0 +1,40 @@
+/*
+      This file is part of Smoothie (http://smoothieware.org/). The motion control part is heavily based on Grbl (https://github.com/simen/grbl).
+      Smoothie is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+      Smoothie is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+      You should have received a copy of the GNU General Public License along with Smoothie. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <stdint.h>
+
+class Gcode;
+
+// The words of a G0-G3 that Robot plans the move from. XYZ, IJK and F are in millimeters, E, ABC and S are as they
+// were given. They are read off a Gcode, or out of a compiled job where the host converted them already.
+class MoveWords {
+    public:
+        enum WORD {
+            MOVE_X, MOVE_Y, MOVE_Z,
+            MOVE_E,
+            MOVE_A, MOVE_B, MOVE_C,
+            MOVE_I, MOVE_J, MOVE_K,
+            MOVE_F,
+            MOVE_S,
+            NUMBER_OF_WORDS
+        };
+
+        MoveWords() : mask(0) {}
+        MoveWords(const Gcode *gcode, bool inch_mode);
+
+        bool has(WORD w) const { return mask & (1 << w); }
+        float get(WORD w) const { return value[w]; }
+        void set(WORD w, float v) { value[w]= v; mask |= 1 << w; }
+
+        // the letter of each word, in the order of WORD
+        static const char letters[NUMBER_OF_WORDS + 1];
+
+        uint16_t mask;                  // bit per WORD that was given
+        float value[NUMBER_OF_WORDS];   // only those in mask are set
+};
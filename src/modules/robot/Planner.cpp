@@ -22,6 +22,8 @@ using namespace std;
 #include "checksumm.h"
 #include "Robot.h"
 #include "ConfigValue.h"
+#include "StepTicker.h"
+#include "Profiler.h"
 
 #include <math.h>
 #include <algorithm>
@@ -29,14 +31,19 @@ using namespace std;
 #define junction_deviation_checksum    CHECKSUM("junction_deviation")
 #define z_junction_deviation_checksum  CHECKSUM("z_junction_deviation")
 #define minimum_planner_speed_checksum CHECKSUM("minimum_planner_speed")
+#define s_curve_jerk_checksum          CHECKSUM("s_curve_jerk")
+#define planner_batch_size_checksum    CHECKSUM("planner_batch_size")
+#define per_axis_junction_checksum     CHECKSUM("per_axis_junction_enable")
 
 // The Planner does the acceleration math for the queue of Blocks ( movements ).
 // It makes sure the speed stays within the configured constraints ( acceleration, junction_deviation, etc )
 // It goes over the list in both direction, every time a block is added, re-doing the math to make sure everything is optimal
+// When planner_batch_size is set the appended blocks only get their junction limits, and the math is done once for a batch of them
 
 Planner::Planner()
 {
     memset(this->previous_unit_vec, 0, sizeof this->previous_unit_vec);
+    memset(this->previous_actuator_unit_vec, 0, sizeof this->previous_actuator_unit_vec);
     config_load();
 }
 
@@ -46,15 +53,32 @@ void Planner::config_load()
     this->junction_deviation = THEKERNEL->config->value(junction_deviation_checksum)->by_default(0.05F)->as_number();
     this->z_junction_deviation = THEKERNEL->config->value(z_junction_deviation_checksum)->by_default(NAN)->as_number(); // disabled by default
     this->minimum_planner_speed = THEKERNEL->config->value(minimum_planner_speed_checksum)->by_default(0.0f)->as_number();
+    this->s_curve_jerk = THEKERNEL->config->value(s_curve_jerk_checksum)->by_default(0.0f)->as_number(); // mm/sec³, 0 disables
+    this->batch_size = THEKERNEL->config->value(planner_batch_size_checksum)->by_default(0)->as_number(); // 0 replans on every block
+    // limit the junction speeds with each actuator's own acceleration instead of the acceleration of the whole move
+    this->per_axis_junction = THEKERNEL->config->value(per_axis_junction_checksum)->by_default(false)->as_bool();
 }
 
 
 // Append a block to the queue, compute it's speed factors
-bool Planner::append_block( ActuatorCoordinates &actuator_pos, uint8_t n_motors, float rate_mm_s, float distance, float *unit_vec, float acceleration, float s_value, bool g123)
+// for an arc block unit_vec is the direction at the start of the arc, and exit_unit_vec the direction at the end
+// a raster is handed over to the block, unless there turn out to be no steps when it is left with the caller
+bool Planner::append_block( ActuatorCoordinates &actuator_pos, uint8_t n_motors, float rate_mm_s, float distance, float *unit_vec, float acceleration, float s_value, bool g123, const Block::arc_t *arc, const float *exit_unit_vec, Block::raster_t *raster)
 {
+    Profiler::Scope profile(Profiler::APPEND_BLOCK);
+
     // Create ( recycle ) a new block
     Block* block = THECONVEYOR->queue.head_ref();
 
+    if(arc != nullptr) {
+        // the segmenter needs to know where the motors start from, so grab that before the milestones get updated
+        block->arc = *arc;
+        for (int i = 0; i < 3; ++i) {
+            block->arc.start_steps[i] = THEROBOT->actuators[arc->axis[i]]->get_last_milestone_steps();
+        }
+        block->is_arc = true;
+    }
+
     // Direction bits
     bool has_steps = false;
     for (size_t i = 0; i < n_motors; i++) {
@@ -108,10 +132,19 @@ bool Planner::append_block( ActuatorCoordinates &actuator_pos, uint8_t n_motors,
 
     block->acceleration = acceleration; // save in block
 
+    // the S-curve profile is followed by the step segmenter, the fixed rate ISR can only do trapezoids
+    block->jerk = (this->s_curve_jerk > 0 && THEKERNEL->step_ticker->is_segment_mode()) ? this->s_curve_jerk : 0;
+
     // Max number of steps, for all axes
     auto mi = std::max_element(block->steps.begin(), block->steps.end());
     block->steps_event_count = *mi;
 
+    if(raster != nullptr) {
+        // the pixel the laser is on is the lead motor's steps times this
+        raster->pixels_per_step = std::min(((uint64_t)raster->power.size() << 24) / block->steps_event_count, (uint64_t)0xFFFFFFFF);
+        block->raster = raster;
+    }
+
     block->millimeters = distance;
 
     // Calculate speed in mm/sec for each axis. No divide by zero due to previous checks.
@@ -140,8 +173,25 @@ bool Planner::append_block( ActuatorCoordinates &actuator_pos, uint8_t n_motors,
 
     // NOTE however it does not take into account independent axis, in most cartesian X and Y and Z are totally independent
     // and this allows one to stop with little to no decleration in many cases. This is particualrly bad on leadscrew based systems that will skip steps.
+    // With per_axis_junction_enable set each actuator's share of the centripetal acceleration is limited instead, see junction_limit()
     float vmax_junction = minimum_planner_speed; // Set default max junction speed
 
+    // how far each actuator moves per mm of travel, at the start of this block
+    float actuator_unit_vec[N_PRIMARY_AXIS];
+    if(per_axis_junction && unit_vec != nullptr) {
+        for (int i = 0; i < N_PRIMARY_AXIS; ++i) {
+            if(arc != nullptr) {
+                // arcs are only done on cartesian machines, the chord is not the direction they start in
+                actuator_unit_vec[i] = unit_vec[i];
+            } else if(i < n_motors && distance > 0.0F) {
+                float d = block->steps[i] / THEROBOT->actuators[i]->get_steps_per_mm();
+                actuator_unit_vec[i] = (block->direction_bits[i] ? -d : d) / distance;
+            } else {
+                actuator_unit_vec[i] = 0;
+            }
+        }
+    }
+
     // if unit_vec was null then it was not a primary axis move so we skip the junction deviation stuff
     if (unit_vec != nullptr && !THECONVEYOR->is_queue_empty()) {
         Block *prev_block = THECONVEYOR->queue.item_ref(THECONVEYOR->queue.prev(THECONVEYOR->queue.head_i));
@@ -166,7 +216,8 @@ bool Planner::append_block( ActuatorCoordinates &actuator_pos, uint8_t n_motors,
                 if (cos_theta > -0.95F) {
                     // Compute maximum junction velocity based on maximum acceleration and junction deviation
                     float sin_theta_d2 = sqrtf(0.5F * (1.0F - cos_theta)); // Trig half angle identity. Always positive.
-                    vmax_junction = std::min(vmax_junction, sqrtf(acceleration * junction_deviation * sin_theta_d2 / (1.0F - sin_theta_d2)));
+                    float limit = per_axis_junction ? junction_limit(unit_vec, actuator_unit_vec) : acceleration * junction_deviation;
+                    vmax_junction = std::min(vmax_junction, sqrtf(limit * sin_theta_d2 / (1.0F - sin_theta_d2)));
                 }
             }
         }
@@ -174,7 +225,7 @@ bool Planner::append_block( ActuatorCoordinates &actuator_pos, uint8_t n_motors,
     block->max_entry_speed = vmax_junction;
 
     // Initialize block entry speed. Compute based on deceleration to user-defined minimum_planner_speed.
-    float v_allowable = max_allowable_speed(-acceleration, minimum_planner_speed, block->millimeters);
+    float v_allowable = block->max_allowable_speed(-acceleration, minimum_planner_speed, block->millimeters);
     block->entry_speed = std::min(vmax_junction, v_allowable);
 
     // Initialize planner efficiency flags
@@ -193,23 +244,97 @@ bool Planner::append_block( ActuatorCoordinates &actuator_pos, uint8_t n_motors,
 
     // Update previous path unit_vector and nominal speed
     if(unit_vec != nullptr) {
-        memcpy(previous_unit_vec, unit_vec, sizeof(previous_unit_vec)); // previous_unit_vec[] = unit_vec[]
+        memcpy(previous_unit_vec, exit_unit_vec != nullptr ? exit_unit_vec : unit_vec, sizeof(previous_unit_vec)); // previous_unit_vec[] = unit_vec[]
+        if(per_axis_junction) {
+            memcpy(previous_actuator_unit_vec, exit_unit_vec != nullptr ? exit_unit_vec : actuator_unit_vec, sizeof(previous_actuator_unit_vec));
+        }
     } else {
         memset(previous_unit_vec, 0, sizeof(previous_unit_vec));
+        memset(previous_actuator_unit_vec, 0, sizeof(previous_actuator_unit_vec));
     }
 
-    // Math-heavy re-computing of the whole queue to take the new
-    this->recalculate();
+    if(this->batch_size == 0) {
+        // Math-heavy re-computing of the whole queue to take the new
+        this->recalculate(THECONVEYOR->queue.head_i);
+
+        // The block can now be used
+        block->ready();
+
+        profile.stop();
+        THECONVEYOR->queue_head_block();
+        THECONVEYOR->planned_i = THECONVEYOR->queue.head_i;
+
+    } else {
+        // queue it unplanned, the step ticker will not get it until the batch has been replanned
+        block->ready();
 
-    // The block can now be used
-    block->ready();
+        profile.stop();
+        THECONVEYOR->queue_head_block();
 
-    THECONVEYOR->queue_head_block();
+        Conveyor::Queue_t &queue = THECONVEYOR->queue;
+        if((queue.head_i + queue.length - THECONVEYOR->planned_i) % queue.length >= this->batch_size) {
+            replan();
+        }
+    }
 
     return true;
 }
 
-void Planner::recalculate()
+// The corner is taken as an arc of centripetal acceleration along the change in direction, so each actuator only sees
+// its share of it, the change in its own direction over the whole change. Returns the smallest acceleration times
+// junction deviation any actuator allows. z_junction_deviation if it is set and not negative is used for the Z actuator,
+// only on a cartesian arm where actuator and axis are the same, on a delta the third actuator is a tower not Z
+float Planner::junction_limit(const float unit_vec[], const float actuator_unit_vec[]) const
+{
+    bool z_override = THEROBOT->cartesian_arm && this->z_junction_deviation >= 0.0F;
+
+    float du = 0;
+    for (int i = 0; i < N_PRIMARY_AXIS; ++i) {
+        du += powf(unit_vec[i] - previous_unit_vec[i], 2);
+    }
+    du = sqrtf(du);
+
+    float limit = INFINITY;
+    for (int i = 0; i < N_PRIMARY_AXIS; ++i) {
+        float dua = fabsf(actuator_unit_vec[i] - previous_actuator_unit_vec[i]);
+        if(dua < 0.000001F) continue; // this actuator goes round the corner without changing speed
+
+        float a = THEROBOT->actuators[i]->get_acceleration();
+        if(isnan(a)) a = THEROBOT->get_default_acceleration();
+        float jd = (z_override && i == Z_AXIS) ? this->z_junction_deviation : this->junction_deviation;
+        limit = std::min(limit, a * jd * du / dua);
+    }
+
+    return isinf(limit) ? THEROBOT->get_default_acceleration() * this->junction_deviation : limit;
+}
+
+// plans all the blocks queued since the last replan in one pass and hands them to the step ticker
+// called at the end of each move and from Conveyor::on_idle, does nothing if there is nothing new
+void Planner::replan()
+{
+    Conveyor::Queue_t &queue = THECONVEYOR->queue;
+    if(THECONVEYOR->planned_i == queue.head_i) return;
+
+    Profiler::Scope profile(Profiler::REPLAN);
+    this->recalculate(queue.prev(queue.head_i));
+    THECONVEYOR->planned_i = queue.head_i;
+}
+
+// called from Conveyor::on_idle, replans once a full batch is waiting or when the step ticker is running low on planned blocks
+// so a full queue does not end up being replanned one block at a time as the step ticker frees them
+void Planner::check_replan()
+{
+    Conveyor::Queue_t &queue = THECONVEYOR->queue;
+    unsigned int planned_i = THECONVEYOR->planned_i;
+    if(planned_i == queue.head_i) return;
+
+    unsigned int unplanned = (queue.head_i + queue.length - planned_i) % queue.length;
+    unsigned int ready = (planned_i + queue.length - queue.isr_tail_i) % queue.length;
+    if(unplanned >= this->batch_size || ready < this->batch_size) replan();
+}
+
+// newest is the index of the last block added, either the head block that is about to be queued or the last queued one
+void Planner::recalculate(unsigned int newest)
 {
     Conveyor::Queue_t &queue = THECONVEYOR->queue;
 
@@ -251,10 +376,13 @@ void Planner::recalculate()
 
     float entry_speed = minimum_planner_speed;
 
-    block_index = queue.head_i;
+    // the step segmenter refills from PendSV and must not take a block part way through it being replanned
+    THECONVEYOR->prep_locked = true;
+
+    block_index = newest;
     current     = queue.item_ref(block_index);
 
-    if (!queue.is_empty()) {
+    if (newest != queue.tail_i) {
         while ((block_index != queue.tail_i) && current->recalculate_flag) {
             entry_speed = current->reverse_pass(entry_speed);
 
@@ -273,7 +401,7 @@ void Planner::recalculate()
 
         float exit_speed = current->max_exit_speed();
 
-        while (block_index != queue.head_i) {
+        while (block_index != newest) {
             previous    = current;
             block_index = queue.next(block_index);
             current     = queue.item_ref(block_index);
@@ -282,7 +410,13 @@ void Planner::recalculate()
             // so this block can decide if it's accel or decel limited and update its fields as appropriate
             exit_speed = current->forward_pass(exit_speed);
 
-            previous->calculate_trapezoid(previous->entry_speed, current->entry_speed);
+            if(!previous->calculate_trapezoid(previous->entry_speed, current->entry_speed)) {
+                // the step ticker has it, possibly taken since its exit speed was used above, so this block starts
+                // at the speed it actually ends at
+                current->entry_speed = std::min(current->entry_speed, previous->exit_speed);
+                exit_speed = current->max_exit_speed();
+            }
+            ++trapezoid_count;
         }
     }
 
@@ -291,9 +425,13 @@ void Planner::recalculate()
      * work out trapezoid for final (and newest) block
      */
 
-    // now current points to the head item
+    // now current points to the newest item
     // which has not had calculate_trapezoid run yet
     current->calculate_trapezoid(current->entry_speed, minimum_planner_speed);
+    ++trapezoid_count;
+
+    THECONVEYOR->prep_locked = false;
+    if(THEKERNEL->step_ticker->is_segment_mode()) THEKERNEL->step_ticker->request_refill();
 }
 
 
@@ -9,24 +9,35 @@
 #define PLANNER_H
 
 #include "ActuatorCoordinates.h"
-class Block;
+#include "Block.h"
+#include <stdint.h>
 
 class Planner
 {
 public:
     Planner();
     float max_allowable_speed( float acceleration, float target_velocity, float distance);
+    void replan();
+    void check_replan();
+    // number of trapezoids calculated so far, to measure how much replanning is done
+    uint32_t get_trapezoid_count() const { return trapezoid_count; }
 
-    friend class Robot; // for acceleration, junction deviation, minimum_planner_speed
+    friend class Robot; // for acceleration, junction deviation, minimum_planner_speed, s_curve_jerk
 
 private:
-    bool append_block(ActuatorCoordinates &target, uint8_t n_motors, float rate_mm_s, float distance, float unit_vec[], float accleration, float s_value, bool g123);
-    void recalculate();
+    bool append_block(ActuatorCoordinates &target, uint8_t n_motors, float rate_mm_s, float distance, float unit_vec[], float accleration, float s_value, bool g123, const Block::arc_t *arc= nullptr, const float *exit_unit_vec= nullptr, Block::raster_t *raster= nullptr);
+    void recalculate(unsigned int newest);
     void config_load();
+    float junction_limit(const float unit_vec[], const float actuator_unit_vec[]) const;
     float previous_unit_vec[N_PRIMARY_AXIS];
+    float previous_actuator_unit_vec[N_PRIMARY_AXIS]; // actuator mm per mm of travel at the end of the last block
     float junction_deviation;    // Setting
     float z_junction_deviation;  // Setting
     float minimum_planner_speed; // Setting
+    float s_curve_jerk;          // Setting
+    uint16_t batch_size;         // Setting
+    bool per_axis_junction;      // Setting
+    uint32_t trapezoid_count{0};
 };
 
 
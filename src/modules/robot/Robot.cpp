@@ -45,6 +45,7 @@
 #define  default_feed_rate_checksum          CHECKSUM("default_feed_rate")
 #define  mm_per_line_segment_checksum        CHECKSUM("mm_per_line_segment")
 #define  delta_segments_per_second_checksum  CHECKSUM("delta_segments_per_second")
+#define  mm_max_segment_error_checksum       CHECKSUM("mm_max_segment_error")
 #define  mm_per_arc_segment_checksum         CHECKSUM("mm_per_arc_segment")
 #define  mm_max_arc_error_checksum           CHECKSUM("mm_max_arc_error")
 #define  arc_correction_checksum             CHECKSUM("arc_correction")
@@ -52,6 +53,7 @@
 #define  y_axis_max_speed_checksum           CHECKSUM("y_axis_max_speed")
 #define  z_axis_max_speed_checksum           CHECKSUM("z_axis_max_speed")
 #define  segment_z_moves_checksum            CHECKSUM("segment_z_moves")
+#define  native_arcs_enable_checksum         CHECKSUM("native_arcs_enable")
 #define  save_g92_checksum                   CHECKSUM("save_g92")
 #define  set_g92_checksum                    CHECKSUM("set_g92")
 
@@ -140,18 +142,23 @@ void Robot::load_config()
     // Here we read the config to find out which arm solution to use
     if (this->arm_solution) delete this->arm_solution;
     int solution_checksum = get_checksum(THEKERNEL->config->value(arm_solution_checksum)->by_default("cartesian")->as_string());
+    this->cartesian_arm= false;
+    this->linear_arm= false;
     // Note checksums are not const expressions when in debug mode, so don't use switch
     if(solution_checksum == hbot_checksum || solution_checksum == corexy_checksum) {
         this->arm_solution = new HBotSolution(THEKERNEL->config);
+        this->linear_arm= true;
 
     } else if(solution_checksum == corexz_checksum) {
         this->arm_solution = new CoreXZSolution(THEKERNEL->config);
+        this->linear_arm= true;
 
     } else if(solution_checksum == rostock_checksum || solution_checksum == kossel_checksum || solution_checksum == delta_checksum || solution_checksum ==  linear_delta_checksum) {
         this->arm_solution = new LinearDeltaSolution(THEKERNEL->config);
 
     } else if(solution_checksum == rotatable_cartesian_checksum) {
         this->arm_solution = new RotatableCartesianSolution(THEKERNEL->config);
+        this->linear_arm= true;
 
     } else if(solution_checksum == rotary_delta_checksum) {
         this->arm_solution = new RotaryDeltaSolution(THEKERNEL->config);
@@ -161,15 +168,20 @@ void Robot::load_config()
 
     } else if(solution_checksum == cartesian_checksum) {
         this->arm_solution = new CartesianSolution(THEKERNEL->config);
+        this->cartesian_arm= true;
+        this->linear_arm= true;
 
     } else {
         this->arm_solution = new CartesianSolution(THEKERNEL->config);
+        this->cartesian_arm= true;
+        this->linear_arm= true;
     }
 
     this->feed_rate           = THEKERNEL->config->value(default_feed_rate_checksum   )->by_default(  100.0F)->as_number();
     this->seek_rate           = THEKERNEL->config->value(default_seek_rate_checksum   )->by_default(  100.0F)->as_number();
     this->mm_per_line_segment = THEKERNEL->config->value(mm_per_line_segment_checksum )->by_default(    0.0F)->as_number();
     this->delta_segments_per_second = THEKERNEL->config->value(delta_segments_per_second_checksum )->by_default(0.0f   )->as_number();
+    this->mm_max_segment_error = THEKERNEL->config->value(mm_max_segment_error_checksum )->by_default(0.0f   )->as_number();
     this->mm_per_arc_segment  = THEKERNEL->config->value(mm_per_arc_segment_checksum  )->by_default(    0.0f)->as_number();
     this->mm_max_arc_error    = THEKERNEL->config->value(mm_max_arc_error_checksum    )->by_default(   0.01f)->as_number();
     this->arc_correction      = THEKERNEL->config->value(arc_correction_checksum      )->by_default(    5   )->as_number();
@@ -180,6 +192,7 @@ void Robot::load_config()
     this->max_speeds[Z_AXIS]  = THEKERNEL->config->value(z_axis_max_speed_checksum    )->by_default(  300.0F)->as_number() / 60.0F;
 
     this->segment_z_moves     = THEKERNEL->config->value(segment_z_moves_checksum     )->by_default(true)->as_bool();
+    this->native_arcs         = THEKERNEL->config->value(native_arcs_enable_checksum  )->by_default(false)->as_bool();
     this->save_g92            = THEKERNEL->config->value(save_g92_checksum            )->by_default(false)->as_bool();
     string g92                = THEKERNEL->config->value(set_g92_checksum             )->by_default("")->as_string();
     if(!g92.empty()) {
@@ -710,7 +723,7 @@ void Robot::on_gcode_received(void *argument)
                 }
                 break;
 
-            case 205: // M205 Xnnn - set junction deviation, Z - set Z junction deviation, Snnn - Set minimum planner speed
+            case 205: // M205 Xnnn - set junction deviation, Z - set Z junction deviation, Snnn - Set minimum planner speed, Jnnn - set S-curve jerk
                 if (gcode->has_letter('X')) {
                     float jd = gcode->get_value('X');
                     // enforce minimum
@@ -732,6 +745,13 @@ void Robot::on_gcode_received(void *argument)
                         mps = 0.0F;
                     THEKERNEL->planner->minimum_planner_speed = mps;
                 }
+                if (gcode->has_letter('J')) {
+                    float jerk = gcode->get_value('J');
+                    // 0 disables S-curve, only takes effect when step segments are enabled
+                    if (jerk < 0.0F)
+                        jerk = 0.0F;
+                    THEKERNEL->planner->s_curve_jerk = jerk;
+                }
                 break;
 
             case 220: // M220 - speed override percentage
@@ -773,7 +793,7 @@ void Robot::on_gcode_received(void *argument)
                 }
                 gcode->stream->printf("\n");
 
-                gcode->stream->printf(";X- Junction Deviation, Z- Z junction deviation, S - Minimum Planner speed mm/sec:\nM205 X%1.5f Z%1.5f S%1.5f\n", THEKERNEL->planner->junction_deviation, isnan(THEKERNEL->planner->z_junction_deviation)?-1:THEKERNEL->planner->z_junction_deviation, THEKERNEL->planner->minimum_planner_speed);
+                gcode->stream->printf(";X- Junction Deviation, Z- Z junction deviation, S - Minimum Planner speed mm/sec, J - S-curve jerk mm/sec³:\nM205 X%1.5f Z%1.5f S%1.5f J%1.5f\n", THEKERNEL->planner->junction_deviation, isnan(THEKERNEL->planner->z_junction_deviation)?-1:THEKERNEL->planner->z_junction_deviation, THEKERNEL->planner->minimum_planner_speed, THEKERNEL->planner->s_curve_jerk);
 
                 gcode->stream->printf(";Max cartesian feedrates in mm/sec:\nM203 X%1.5f Y%1.5f Z%1.5f\n", this->max_speeds[X_AXIS], this->max_speeds[Y_AXIS], this->max_speeds[Z_AXIS]);
 
@@ -877,22 +897,38 @@ int Robot::get_active_extruder() const
 // process a G0/G1/G2/G3
 void Robot::process_move(Gcode *gcode, enum MOTION_MODE_T motion_mode)
 {
-    // we have a G0/G1/G2/G3 so extract parameters and apply offsets to get machine coordinate target
+    // we have a G0/G1/G2/G3 so extract parameters, in mm, and plan it
+    plan_move(gcode, MoveWords(gcode, this->inch_mode), motion_mode);
+}
+
+// a G0/G1/G2/G3 from a compiled job, its words were read off the Gcode and converted to mm by the host
+void Robot::compiled_move(uint8_t g, const MoveWords& words)
+{
+    if(g > 3) return;
+    enum MOTION_MODE_T motion_mode= (MOTION_MODE_T)(SEEK + g);
+    is_g123= motion_mode != SEEK;
+    plan_move(nullptr, words, motion_mode);
+    next_command_is_MCS = false;
+}
+
+// apply offsets to the words of a move to get the machine coordinate target and queue it, gcode is nullptr for a
+// compiled move, which has nothing to report errors on
+void Robot::plan_move(Gcode *gcode, const MoveWords& words, enum MOTION_MODE_T motion_mode)
+{
     // get XYZ and one E (which goes to the selected extruder)
     float param[4]{NAN, NAN, NAN, NAN};
 
     // process primary axis
     for(int i= X_AXIS; i <= Z_AXIS; ++i) {
-        char letter= 'X'+i;
-        if( gcode->has_letter(letter) ) {
-            param[i] = this->to_millimeters(gcode->get_value(letter));
+        if( words.has((MoveWords::WORD)(MoveWords::MOVE_X + i)) ) {
+            param[i] = words.get((MoveWords::WORD)(MoveWords::MOVE_X + i));
         }
     }
 
     float offset[3]{0,0,0};
-    for(char letter = 'I'; letter <= 'K'; letter++) {
-        if( gcode->has_letter(letter) ) {
-            offset[letter - 'I'] = this->to_millimeters(gcode->get_value(letter));
+    for(int i= 0; i < 3; ++i) {
+        if( words.has((MoveWords::WORD)(MoveWords::MOVE_I + i)) ) {
+            offset[i] = words.get((MoveWords::WORD)(MoveWords::MOVE_I + i));
         }
     }
 
@@ -934,9 +970,9 @@ void Robot::process_move(Gcode *gcode, enum MOTION_MODE_T motion_mode)
     #if MAX_ROBOT_ACTUATORS > 3
     // process extruder parameters, for active extruder only (only one active extruder at a time)
     int selected_extruder= 0;
-    if(gcode->has_letter('E')) {
+    if(words.has(MoveWords::MOVE_E)) {
         selected_extruder= get_active_extruder();
-        param[E_AXIS]= gcode->get_value('E');
+        param[E_AXIS]= words.get(MoveWords::MOVE_E);
     }
 
     // do E for the selected extruder
@@ -951,10 +987,10 @@ void Robot::process_move(Gcode *gcode, enum MOTION_MODE_T motion_mode)
     }
 
     // process ABC axis, this is mutually exclusive to using E for an extruder, so if E is used and A then the results are undefined
-    for (int i = A_AXIS; i < n_motors; ++i) {
-        char letter= 'A'+i-A_AXIS;
-        if(gcode->has_letter(letter)) {
-            float p= gcode->get_value(letter);
+    for (int i = A_AXIS; i < n_motors && i - A_AXIS <= MoveWords::MOVE_C - MoveWords::MOVE_A; ++i) {
+        MoveWords::WORD w= (MoveWords::WORD)(MoveWords::MOVE_A + i - A_AXIS);
+        if(words.has(w)) {
+            float p= words.get(w);
             if(this->absolute_mode) {
                 target[i]= p;
             }else{
@@ -964,28 +1000,29 @@ void Robot::process_move(Gcode *gcode, enum MOTION_MODE_T motion_mode)
     }
     #endif
 
-    if( gcode->has_letter('F') ) {
+    if( words.has(MoveWords::MOVE_F) ) {
         if( motion_mode == SEEK )
-            this->seek_rate = this->to_millimeters( gcode->get_value('F') );
+            this->seek_rate = words.get(MoveWords::MOVE_F);
         else
-            this->feed_rate = this->to_millimeters( gcode->get_value('F') );
+            this->feed_rate = words.get(MoveWords::MOVE_F);
     }
 
     // S is modal When specified on a G0/1/2/3 command
-    if(gcode->has_letter('S')) s_value= gcode->get_value('S');
+    if(words.has(MoveWords::MOVE_S)) s_value= words.get(MoveWords::MOVE_S);
 
     bool moved= false;
+    bool xy_move= words.has(MoveWords::MOVE_X) || words.has(MoveWords::MOVE_Y);
 
     // Perform any physical actions
     switch(motion_mode) {
         case NONE: break;
 
         case SEEK:
-            moved= this->append_line(gcode, target, this->seek_rate / seconds_per_minute, delta_e );
+            moved= this->append_line(gcode, target, this->seek_rate / seconds_per_minute, delta_e, xy_move );
             break;
 
         case LINEAR:
-            moved= this->append_line(gcode, target, this->feed_rate / seconds_per_minute, delta_e );
+            moved= this->append_line(gcode, target, this->feed_rate / seconds_per_minute, delta_e, xy_move );
             break;
 
         case CW_ARC:
@@ -1094,7 +1131,7 @@ void Robot::reset_position_from_current_actuator_position()
 // Convert target (in machine coordinates) to machine_position, then convert to actuator position and append this to the planner
 // target is in machine coordinates without the compensation transform, however we save a compensated_machine_position that includes
 // all transforms and is what we actually convert to actuator positions
-bool Robot::append_milestone(const float target[], float rate_mm_s)
+bool Robot::append_milestone(const float target[], float rate_mm_s, Block::raster_t *raster)
 {
     float deltas[n_motors];
     float transformed_target[n_motors]; // adjust target for bed compensation
@@ -1224,7 +1261,7 @@ bool Robot::append_milestone(const float target[], float rate_mm_s)
 
     // Append the block to the planner
     // NOTE that distance here should be either the distance travelled by the XYZ axis, or the E mm travel if a solo E move
-    if(THEKERNEL->planner->append_block( actuator_pos, n_motors, rate_mm_s, distance, auxilliary_move ? nullptr : unit_vec, acceleration, s_value, is_g123)) {
+    if(THEKERNEL->planner->append_block( actuator_pos, n_motors, rate_mm_s, distance, auxilliary_move ? nullptr : unit_vec, acceleration, s_value, is_g123, nullptr, nullptr, raster)) {
         // this is the new compensated machine position
         memcpy(this->compensated_machine_position, transformed_target, n_motors*sizeof(float));
         return true;
@@ -1262,13 +1299,37 @@ bool Robot::delta_move(const float *delta, float rate_mm_s, uint8_t naxis)
     return false;
 }
 
+// Queue a laser raster scan line, a straight XY move from the current position that carries the power of each pixel along it.
+// It is one block and is never segmented, so it can only be done where a straight move is straight for the actuators.
+// The block owns the raster once it is queued, if this returns false it is still the caller's
+bool Robot::raster_move(const float delta[], float rate_mm_s, Block::raster_t *raster)
+{
+    if(THEKERNEL->is_halted() || !linear_arm || disable_arm_solution || rate_mm_s <= 0.0F) return false;
+
+    float target[n_motors];
+    memcpy(target, machine_position, n_motors*sizeof(float));
+    target[X_AXIS] += delta[X_AXIS];
+    target[Y_AXIS] += delta[Y_AXIS];
+
+    // the laser only fires on G1-G3 blocks
+    bool was_g123= is_g123;
+    is_g123= true;
+    bool moved= append_milestone(target, rate_mm_s, raster);
+    is_g123= was_g123;
+
+    if(moved) memcpy(machine_position, target, n_motors*sizeof(float));
+    return moved;
+}
+
 // Append a move to the queue ( cutting it into segments if needed )
-bool Robot::append_line(Gcode *gcode, const float target[], float rate_mm_s, float delta_e)
+bool Robot::append_line(Gcode *gcode, const float target[], float rate_mm_s, float delta_e, bool xy_move)
 {
     // catch negative or zero feed rates and return the same error as GRBL does
     if(rate_mm_s <= 0.0F) {
-        gcode->is_error= true;
-        gcode->txt_after_ok= (rate_mm_s == 0 ? "Undefined feed rate" : "feed rate < 0");
+        if(gcode != nullptr) {
+            gcode->is_error= true;
+            gcode->txt_after_ok= (rate_mm_s == 0 ? "Undefined feed rate" : "feed rate < 0");
+        }
         return false;
     }
 
@@ -1286,7 +1347,7 @@ bool Robot::append_line(Gcode *gcode, const float target[], float rate_mm_s, flo
         We ask Extruder to do all the work but we need to pass in the relevant data.
         NOTE we need to do this before we segment the line (for deltas)
     */
-    if(!isnan(delta_e) && gcode->has_g && gcode->g == 1) {
+    if(!isnan(delta_e) && is_g123) {
         float data[2]= {delta_e, rate_mm_s / millimeters_of_travel};
         if(PublicData::set_value(extruder_checksum, target_checksum, data)) {
             rate_mm_s *= data[1]; // adjust the feedrate
@@ -1296,11 +1357,15 @@ bool Robot::append_line(Gcode *gcode, const float target[], float rate_mm_s, flo
     // We cut the line into smaller segments. This is only needed on a cartesian robot for zgrid, but always necessary for robots with rotational axes like Deltas.
     // In delta robots either mm_per_line_segment can be used OR delta_segments_per_second
     // The latter is more efficient and avoids splitting fast long lines into very small segments, like initial z move to 0, it is what Johanns Marlin delta port does
+    // mm_max_segment_error overrides both and places the segments where the arm solution needs them, see append_segments()
     uint16_t segments;
 
-    if(this->disable_segmentation || (!segment_z_moves && !gcode->has_letter('X') && !gcode->has_letter('Y'))) {
+    if(this->disable_segmentation || (!segment_z_moves && !xy_move)) {
         segments= 1;
 
+    } else if(this->mm_max_segment_error > 0.0F) {
+        segments= 0; // adaptive
+
     } else if(this->delta_segments_per_second > 1.0F) {
         // enabled if set to something > 1, it is set to 0.0 by default
         // segment based on current speed and requested segments per second
@@ -1319,7 +1384,13 @@ bool Robot::append_line(Gcode *gcode, const float target[], float rate_mm_s, flo
     }
 
     bool moved= false;
-    if (segments > 1) {
+    if (segments == 0) {
+        ActuatorCoordinates start_pos, end_pos;
+        get_segment_actuators(machine_position, start_pos);
+        get_segment_actuators(target, end_pos);
+        moved= append_segments(machine_position, start_pos, target, end_pos, rate_mm_s, 0);
+
+    } else if (segments > 1) {
         // A vector to keep track of the endpoint of each segment
         float segment_delta[n_motors];
         float segment_end[n_motors];
@@ -1345,11 +1416,72 @@ bool Robot::append_line(Gcode *gcode, const float target[], float rate_mm_s, flo
     // Append the end of this full move to the queue
     if(this->append_milestone(target, rate_mm_s)) moved= true;
 
+    // plan all the segments in one go if the planner is batching
+    THEKERNEL->planner->replan();
+
     this->next_command_is_MCS = false; // always reset this
 
     return moved;
 }
 
+// Limits the bisection in append_segments() to 1024 segments per line
+#define MAX_SEGMENT_DEPTH 10
+
+// Queue the points between start and end, not end itself.
+// The steppers move each actuator linearly from one milestone to the next, which for anything but a cartesian arm
+// is not a straight line. The line is bisected until the actuator position at the midpoint of each segment is within
+// mm_max_segment_error of the straight actuator interpolation, so segments are short where the arm solution is strongly
+// nonlinear, eg near the edge of a delta bed, and long where it is not.
+// The error is measured in actuator units, for a delta that is mm of tower travel.
+// mm_per_line_segment, if set, still limits the segment length, which bed compensation may need
+bool Robot::append_segments(const float start[], const ActuatorCoordinates& start_pos, const float end[], const ActuatorCoordinates& end_pos, float rate_mm_s, uint8_t depth)
+{
+    if(depth >= MAX_SEGMENT_DEPTH) return false;
+
+    float mid[n_motors];
+    float sos= 0;
+    for (size_t i = X_AXIS; i <= Z_AXIS; i++) {
+        mid[i]= (start[i] + end[i]) / 2.0F;
+        sos += powf(end[i] - start[i], 2);
+    }
+    for (size_t i = N_PRIMARY_AXIS; i < n_motors; i++) {
+        mid[i]= (start[i] + end[i]) / 2.0F;
+    }
+
+    ActuatorCoordinates mid_pos;
+    get_segment_actuators(mid, mid_pos);
+
+    bool split= mm_per_line_segment > 0.0F && sos > powf(mm_per_line_segment, 2);
+    for (size_t i = X_AXIS; i <= Z_AXIS && !split; i++) {
+        float e= mid_pos[i] - (start_pos[i] + end_pos[i]) / 2.0F;
+        split= fabsf(e) > mm_max_segment_error;
+    }
+    if(!split) return false;
+
+    if(THEKERNEL->is_halted()) return false; // don't queue any more segments
+
+    bool moved= append_segments(start, start_pos, mid, mid_pos, rate_mm_s, depth + 1);
+    if(this->append_milestone(mid, rate_mm_s)) moved= true;
+    if(append_segments(mid, mid_pos, end, end_pos, rate_mm_s, depth + 1)) moved= true;
+    return moved;
+}
+
+// the actuator positions append_milestone() would move to for this target, XYZ only
+void Robot::get_segment_actuators(const float target[], ActuatorCoordinates& pos) const
+{
+    float transformed_target[N_PRIMARY_AXIS];
+    memcpy(transformed_target, target, sizeof(transformed_target));
+    if(compensationTransform) compensationTransform(transformed_target, false);
+
+    if(disable_arm_solution) {
+        for (size_t i = X_AXIS; i <= Z_AXIS; i++) {
+            pos[i] = transformed_target[i];
+        }
+
+    } else {
+        arm_solution->cartesian_to_actuator(transformed_target, pos);
+    }
+}
 
 // Append an arc to the queue ( cutting it into segments as needed )
 // TODO does not support any E parameters so cannot be used for 3D printing.
@@ -1358,8 +1490,10 @@ bool Robot::append_arc(Gcode * gcode, const float target[], const float offset[]
     float rate_mm_s= this->feed_rate / seconds_per_minute;
     // catch negative or zero feed rates and return the same error as GRBL does
     if(rate_mm_s <= 0.0F) {
-        gcode->is_error= true;
-        gcode->txt_after_ok= (rate_mm_s == 0 ? "Undefined feed rate" : "feed rate < 0");
+        if(gcode != nullptr) {
+            gcode->is_error= true;
+            gcode->txt_after_ok= (rate_mm_s == 0 ? "Undefined feed rate" : "feed rate < 0");
+        }
         return false;
     }
 
@@ -1389,6 +1523,15 @@ bool Robot::append_arc(Gcode * gcode, const float target[], const float offset[]
         return false;
     }
 
+    // on a cartesian machine stepping from prepared segments the segmenter can follow the arc itself,
+    // so the arc only needs one block per quadrant instead of being cut into lines
+    if(this->native_arcs && this->cartesian_arm && !this->disable_arm_solution && !compensationTransform && THEKERNEL->step_ticker->is_segment_mode()) {
+        bool moved= append_arc_blocks(target, center_axis0, center_axis1, radius, atan2f(r_axis1, r_axis0), angular_travel, linear_travel, rate_mm_s);
+        // plan all the blocks in one go if the planner is batching
+        THEKERNEL->planner->replan();
+        return moved;
+    }
+
     // limit segments by maximum arc error
     float arc_segment = this->mm_per_arc_segment;
     if ((this->mm_max_arc_error > 0) && (2 * radius > this->mm_max_arc_error)) {
@@ -1476,9 +1619,137 @@ bool Robot::append_arc(Gcode * gcode, const float target[], const float offset[]
     // Ensure last segment arrives at target location.
     if(this->append_milestone(target, rate_mm_s)) moved= true;
 
+    // plan all the segments in one go if the planner is batching
+    THEKERNEL->planner->replan();
+
     return moved;
 }
 
+// Append an arc as one block for each quadrant it passes through, so every motor keeps going the same way within a block
+bool Robot::append_arc_blocks(const float target[], float center_axis0, float center_axis1, float radius, float start_angle, float angular_travel, float linear_travel, float rate_mm_s)
+{
+    const float quadrant= PI / 2;
+    float dir= (angular_travel > 0) ? 1.0F : -1.0F;
+    float end_angle= start_angle + angular_travel;
+    float linear_start= this->machine_position[this->plane_axis_2];
+    float angle= start_angle;
+    bool moved= false;
+
+    while(true) {
+        if(THEKERNEL->is_halted()) return false; // don't queue any more blocks
+
+        // the next axis crossing in the direction of travel, or the end of the arc
+        float next= (dir > 0) ? (floorf(angle / quadrant + 1E-4F) + 1) * quadrant : (ceilf(angle / quadrant - 1E-4F) - 1) * quadrant;
+        bool last= ((end_angle - next) * dir <= 1E-4F);
+        if(last) next= end_angle;
+
+        float piece_target[n_motors];
+        if(last) {
+            // make sure we end up exactly on the target
+            memcpy(piece_target, target, n_motors*sizeof(float));
+        } else {
+            memcpy(piece_target, this->machine_position, n_motors*sizeof(float));
+            piece_target[this->plane_axis_0]= center_axis0 + radius * cosf(next);
+            piece_target[this->plane_axis_1]= center_axis1 + radius * sinf(next);
+            piece_target[this->plane_axis_2]= linear_start + linear_travel * (next - start_angle) / angular_travel;
+        }
+
+        Block::arc_t arc;
+        arc.center[0]= center_axis0;
+        arc.center[1]= center_axis1;
+        arc.radius= radius;
+        arc.start_angle= angle;
+        arc.angular_travel= next - angle;
+        arc.linear_start= linear_start + linear_travel * (angle - start_angle) / angular_travel;
+        arc.linear_travel= linear_travel * (next - angle) / angular_travel;
+        arc.axis[0]= this->plane_axis_0;
+        arc.axis[1]= this->plane_axis_1;
+        arc.axis[2]= this->plane_axis_2;
+
+        if(append_arc_milestone(piece_target, arc, rate_mm_s)) moved= true;
+
+        if(last) break;
+        angle= next;
+    }
+
+    return moved;
+}
+
+// the append_milestone for an arc block, the limits are worked out for the fastest each axis goes anywhere along the arc
+bool Robot::append_arc_milestone(const float target[], const Block::arc_t& arc, float rate_mm_s)
+{
+    float plane_travel= arc.radius * fabsf(arc.angular_travel);
+    float distance= hypotf(plane_travel, arc.linear_travel);
+    if(distance < 0.00001F) return false;
+
+    // the most of the feed rate each axis of the arc sees
+    float fraction[3]= { plane_travel / distance, plane_travel / distance, fabsf(arc.linear_travel) / distance };
+
+    // direction of travel at the start and at the end of the arc
+    float unit_vec[N_PRIMARY_AXIS];
+    float exit_unit_vec[N_PRIMARY_AXIS];
+    memset(unit_vec, 0, sizeof(unit_vec));
+    memset(exit_unit_vec, 0, sizeof(exit_unit_vec));
+    float tangential= (arc.angular_travel > 0 ? 1 : -1) * plane_travel / distance;
+    float end_angle= arc.start_angle + arc.angular_travel;
+    unit_vec[arc.axis[0]]= -sinf(arc.start_angle) * tangential;
+    unit_vec[arc.axis[1]]= cosf(arc.start_angle) * tangential;
+    unit_vec[arc.axis[2]]= arc.linear_travel / distance;
+    exit_unit_vec[arc.axis[0]]= -sinf(end_angle) * tangential;
+    exit_unit_vec[arc.axis[1]]= cosf(end_angle) * tangential;
+    exit_unit_vec[arc.axis[2]]= arc.linear_travel / distance;
+
+    for (int i = 0; i < 3; ++i) {
+        float max_speed= max_speeds[arc.axis[i]];
+        if(max_speed > 0 && fraction[i] * rate_mm_s > max_speed) {
+            rate_mm_s= max_speed / fraction[i];
+        }
+    }
+
+    ActuatorCoordinates actuator_pos;
+    arm_solution->cartesian_to_actuator(target, actuator_pos);
+#if MAX_ROBOT_ACTUATORS > 3
+    for (size_t i = E_AXIS; i < n_motors; i++) {
+        actuator_pos[i]= target[i];
+        if(actuators[i]->is_extruder() && get_e_scale_fnc) actuator_pos[i] *= get_e_scale_fnc();
+    }
+#endif
+
+    float acceleration= default_acceleration;
+    for (size_t actuator = 0; actuator < n_motors; actuator++) {
+        if(!actuators[actuator]->is_selected()) continue;
+        float f= fabsf(actuator_pos[actuator] - actuators[actuator]->get_last_milestone()) / distance;
+        for (int i = 0; i < 3; ++i) {
+            if(arc.axis[i] == actuator) f= fraction[i];
+        }
+        if(f == 0) continue;
+
+        float actuator_rate= f * rate_mm_s;
+        if (actuator_rate > actuators[actuator]->get_max_rate()) {
+            rate_mm_s *= (actuators[actuator]->get_max_rate() / actuator_rate);
+        }
+
+        if(actuator < N_PRIMARY_AXIS) {
+            float ma= actuators[actuator]->get_acceleration(); // in mm/sec²
+            if(!isnan(ma)) {
+                float ca= f * acceleration;
+                if (ca > ma) acceleration *= ( ma / ca );
+            }
+        }
+    }
+
+    // going round the arc needs centripetal acceleration, which must stay within the acceleration too
+    float max_arc_rate= sqrtf(acceleration * arc.radius);
+    if(rate_mm_s > max_arc_rate) rate_mm_s= max_arc_rate;
+
+    if(THEKERNEL->planner->append_block(actuator_pos, n_motors, rate_mm_s, distance, unit_vec, acceleration, s_value, is_g123, &arc, exit_unit_vec)) {
+        memcpy(this->compensated_machine_position, target, n_motors*sizeof(float));
+        return true;
+    }
+
+    return false;
+}
+
 // Do the math for an arc and add it to the queue
 bool Robot::compute_arc(Gcode * gcode, const float offset[], const float target[], enum MOTION_MODE_T motion_mode)
 {
@@ -18,6 +18,8 @@ using std::string;
 #include "libs/Module.h"
 #include "ActuatorCoordinates.h"
 #include "nuts_bolts.h"
+#include "Block.h"
+#include "MoveWords.h"
 
 class Gcode;
 class BaseSolution;
@@ -59,6 +61,8 @@ class Robot : public Module {
         std::tuple<float, float, float, uint8_t> get_last_probe_position() const { return last_probe_position; }
         void set_last_probe_position(std::tuple<float, float, float, uint8_t> p) { last_probe_position = p; }
         bool delta_move(const float delta[], float rate_mm_s, uint8_t naxis);
+        bool raster_move(const float delta[], float rate_mm_s, Block::raster_t *raster);
+        void compiled_move(uint8_t g, const MoveWords& words);
         uint8_t register_motor(StepperMotor*);
         uint8_t get_number_registered_motors() const {return n_motors; }
 
@@ -86,6 +90,9 @@ class Robot : public Module {
             bool segment_z_moves:1;
             bool save_g92:1;                                  // save g92 on M500 if set
             bool is_g123:1;
+            bool cartesian_arm:1;                             // set if the arm solution is plain cartesian
+            bool linear_arm:1;                                // set if straight moves are straight for the actuators too
+            bool native_arcs:1;                               // Setting : step arcs along the arc in the segmenter instead of cutting them into lines
             uint8_t plane_axis_0:2;                           // Current plane ( XY, XZ, YZ )
             uint8_t plane_axis_1:2;
             uint8_t plane_axis_2:2;
@@ -101,11 +108,16 @@ class Robot : public Module {
         };
 
         void load_config();
-        bool append_milestone(const float target[], float rate_mm_s);
-        bool append_line( Gcode* gcode, const float target[], float rate_mm_s, float delta_e);
+        bool append_milestone(const float target[], float rate_mm_s, Block::raster_t *raster= nullptr);
+        bool append_line( Gcode* gcode, const float target[], float rate_mm_s, float delta_e, bool xy_move);
+        bool append_segments(const float start[], const ActuatorCoordinates& start_pos, const float end[], const ActuatorCoordinates& end_pos, float rate_mm_s, uint8_t depth);
+        void get_segment_actuators(const float target[], ActuatorCoordinates& pos) const;
         bool append_arc( Gcode* gcode, const float target[], const float offset[], float radius, bool is_clockwise );
+        bool append_arc_blocks(const float target[], float center_axis0, float center_axis1, float radius, float start_angle, float angular_travel, float linear_travel, float rate_mm_s);
+        bool append_arc_milestone(const float target[], const Block::arc_t& arc, float rate_mm_s);
         bool compute_arc(Gcode* gcode, const float offset[], const float target[], enum MOTION_MODE_T motion_mode);
         void process_move(Gcode *gcode, enum MOTION_MODE_T);
+        void plan_move(Gcode *gcode, const MoveWords& words, enum MOTION_MODE_T);
 
         float theta(float x, float y);
         void select_plane(uint8_t axis_0, uint8_t axis_1, uint8_t axis_2);
@@ -130,6 +142,7 @@ class Robot : public Module {
         float mm_per_arc_segment;                            // Setting : Used to split arcs into segments
         float mm_max_arc_error;                              // Setting : Used to limit total arc segments to max error
         float delta_segments_per_second;                     // Setting : Used to split lines into segments for delta based on speed
+        float mm_max_segment_error;                          // Setting : Used to split lines into segments where the arm solution needs them
         float seconds_per_minute;                            // for realtime speed change
         float default_acceleration;                          // the defualt accleration if not set for each axis
         float s_value;                                       // modal S value
@@ -0,0 +1,468 @@
+/*
+      This file is part of Smoothie (http://smoothieware.org/). The motion control part is heavily based on Grbl (https://github.com/simen/grbl).
+      Smoothie is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+      Smoothie is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+      You should have received a copy of the GNU General Public License along with Smoothie. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "StepSegmenter.h"
+
+#include "libs/Kernel.h"
+#include "StepTicker.h"
+#include "Block.h"
+#include "Conveyor.h"
+#include "Robot.h"
+#include "StepperMotor.h"
+#include "InputShaper.h"
+#include "utils.h"
+
+#include "system_LPC17xx.h" // mbed.h lib
+#include <math.h>
+#include <algorithm>
+
+// the shaped tail after the last block is only stepped out once the step ticker is down to this many segments,
+// until then a new block may still turn up and carry it on
+#define TAIL_LOW_WATER 4
+
+StepSegmenter::StepSegmenter(float segment_ms, const InputShaper *shapers)
+{
+    float f = THEKERNEL->step_ticker->get_frequency();
+    this->segment_ticks = floorf(f * segment_ms / 1000.0F);
+    if(this->segment_ticks < 1) this->segment_ticks = 1;
+    this->timer_counts_per_tick = (SystemCoreClock / 4.0F) / f; // SystemCoreClock/4 = Timer increments in a second
+    this->frequency = f;
+    this->block_tick = 0;
+    this->block_s = 0;
+    this->issued.fill(0);
+    this->advance.fill(0);
+    this->advance_rate.fill(0);
+    this->count_carry = 0;
+    this->shapers = shapers;
+    this->now = 0;
+    reset_shaping();
+}
+
+StepSegmenter::~StepSegmenter()
+{
+    delete [] knots;
+}
+
+void StepSegmenter::reset_shaping()
+{
+    shaping = false;
+    duration_ticks = 0;
+    for (uint8_t m = 0; m < N_SHAPED_ACTUATORS; m++) {
+        position[m] = 0;
+        shaped[m] = 0;
+        block_start[m] = 0;
+        if(shapers == nullptr || !shapers[m].is_enabled()) continue;
+        shaping = true;
+        for (uint8_t i = 0; i < shapers[m].n; i++) {
+            impulse_ticks[m][i] = lroundf(shapers[m].time[i] * frequency);
+            if(impulse_ticks[m][i] > duration_ticks) duration_ticks = impulse_ticks[m][i];
+        }
+    }
+
+    delete [] knots;
+    knots = nullptr;
+    knots_size = 0;
+    if(!shaping) return;
+
+    // one knot a segment, with room for short blocks that end part way through one
+    knots_size = 2 * duration_ticks / segment_ticks + 32;
+    knots = new knot_t[knots_size];
+    restart_shaping();
+}
+
+// forgets the history and any tail that was left, the motors are taken as being at rest where they are now
+void StepSegmenter::restart_shaping()
+{
+    if(!shaping) return;
+    for (uint8_t m = 0; m < N_SHAPED_ACTUATORS; m++) shaped[m] = position[m];
+    knots_head = 0;
+    knots_count = 0;
+    last_motion_tick = now - duration_ticks;
+    add_knot();
+}
+
+// remembers the unshaped position at the end of the segment just cut
+void StepSegmenter::add_knot()
+{
+    if(knots_count > 0) {
+        const knot_t &k = knots[knots_head];
+        for (uint8_t m = 0; m < N_SHAPED_ACTUATORS; m++) {
+            if(k.position[m] != position[m]) last_motion_tick = now;
+        }
+        knots_head = (knots_head + 1) % knots_size;
+    }
+    if(knots_count < knots_size) ++knots_count;
+
+    knot_t &k = knots[knots_head];
+    k.tick = now;
+    for (uint8_t m = 0; m < N_SHAPED_ACTUATORS; m++) k.position[m] = position[m];
+
+    // the oldest knot is not needed once the one after it is further back than any shaper looks
+    while(knots_count > 1) {
+        const knot_t &next = knots[(knots_head + knots_size - knots_count + 2) % knots_size];
+        if((int32_t)(now - next.tick) < (int32_t)duration_ticks) break;
+        --knots_count;
+    }
+}
+
+// unshaped position of motor m at tick t relative to where it is now, interpolated between the knots
+float StepSegmenter::unshaped_at(uint8_t m, uint32_t t) const
+{
+    uint16_t newer = knots_head;
+    for (uint16_t i = 0; i < knots_count; i++) {
+        uint16_t j = (knots_head + knots_size - i) % knots_size;
+        const knot_t &k = knots[j];
+        int32_t dt = t - k.tick;
+        if(dt >= 0) {
+            if(i == 0) return k.position[m] - position[m];
+            const knot_t &n = knots[newer];
+            float f = (float)dt / (n.tick - k.tick);
+            return (k.position[m] - position[m]) + f * (n.position[m] - k.position[m]);
+        }
+        newer = j;
+    }
+    // before the oldest knot it was still at rest there
+    return knots[newer].position[m] - position[m];
+}
+
+// the steps that take each shaped motor to its shaped position at the end of the segment, returns the most of them
+uint16_t StepSegmenter::shape_steps(step_segment_t& seg)
+{
+    uint16_t n_events = 0;
+    for (uint8_t m = 0; m < N_SHAPED_ACTUATORS; m++) {
+        const InputShaper &sh = shapers[m];
+        if(!sh.is_enabled()) continue;
+
+        float d = 0;
+        for (uint8_t i = 0; i < sh.n; i++) {
+            d += sh.amplitude[i] * unshaped_at(m, now - impulse_ticks[m][i]);
+        }
+        int32_t n = position[m] + lroundf(d) - shaped[m];
+        if(n > 0xFFFF) n = 0xFFFF;
+        if(n < -0xFFFF) n = -0xFFFF;
+        seg.steps[m] = labs(n);
+        seg.direction_bits[m] = (n < 0);
+        shaped[m] += n;
+        if(seg.steps[m] > n_events) n_events = seg.steps[m];
+    }
+    return n_events;
+}
+
+// a segment of the shaped motion or the advance left after the last block, the tail block is finished with the last of it
+void StepSegmenter::push_tail_segment()
+{
+    step_segment_t seg;
+    seg.block = tail_block;
+    seg.speed = 0;
+    seg.steps.fill(0);
+    seg.direction_bits = tail_block->direction_bits;
+
+    uint16_t n_events = 1;
+    if(shaping) {
+        now += segment_ticks;
+        add_knot();
+        n_events = std::max(n_events, shape_steps(seg));
+    }
+    n_events = std::max(n_events, advance_steps(seg, 0, segment_ticks));
+    seg.n_events = n_events;
+    seg.interval = segment_interval(segment_ticks, n_events);
+
+    // every shaper has looked past the end of the motion so all the motors are where the blocks took them
+    seg.last = !advancing();
+    if(shaping) {
+        if((int32_t)(now - last_motion_tick) < (int32_t)duration_ticks) seg.last = false;
+        for (uint8_t m = 0; m < N_SHAPED_ACTUATORS; m++) {
+            if(shaped[m] != position[m]) seg.last = false;
+        }
+    }
+    THEKERNEL->step_ticker->push_segment(seg);
+    if(seg.last) tail_block = nullptr;
+}
+
+// pushes an empty last segment so the step ticker finishes the block without stepping any more of it
+void StepSegmenter::finish_block(Block *b)
+{
+    step_segment_t seg;
+    seg.block = b;
+    seg.interval = 0;
+    seg.n_events = 0;
+    seg.speed = 0;
+    seg.steps.fill(0);
+    seg.last = true;
+    THEKERNEL->step_ticker->push_segment(seg);
+}
+
+// get the next block from the conveyor, discarded blocks are passed on as an empty segment so the step ticker finishes them in order
+bool StepSegmenter::next_block()
+{
+    StepTicker *st = THEKERNEL->step_ticker;
+    bool discard;
+    while(!st->is_segment_buffer_full() && THECONVEYOR->get_next_prep_block(&block, discard)) {
+        // a shaped tail carries on in the next block, the step ticker finishes the tail block when that starts
+        tail_block = nullptr;
+        if(!discard) {
+            block_tick = 0;
+            block_s = 0;
+            issued.fill(0);
+            block_now = now;
+            for (uint8_t m = 0; m < N_SHAPED_ACTUATORS; m++) block_start[m] = position[m];
+            return true;
+        }
+
+        // the queue is being flushed so whatever tail or advance there was is dropped
+        restart_shaping();
+        advance.fill(0);
+        advance_rate.fill(0);
+        finish_block(block);
+        block = nullptr;
+    }
+
+    return false;
+}
+
+// fill the segment buffer, only ever called from PendSV so there is just the one producer
+void StepSegmenter::prepare()
+{
+    StepTicker *st = THEKERNEL->step_ticker;
+
+    while(!st->is_segment_buffer_full()) {
+        if(tail_block != nullptr && THEKERNEL->is_halted()) {
+            finish_block(tail_block);
+            tail_block = nullptr;
+            restart_shaping();
+            advance.fill(0);
+            advance_rate.fill(0);
+            continue;
+        }
+
+        if(block == nullptr && !next_block()) {
+            // nothing more to cut up for now, the shaped tail is stepped out once the step ticker is running low
+            if(tail_block == nullptr || st->get_segment_count() > TAIL_LOW_WATER) return;
+            push_tail_segment();
+            continue;
+        }
+
+        step_segment_t seg;
+        seg.block = block;
+        seg.steps.fill(0);
+        seg.direction_bits = block->direction_bits;
+
+        if(THEKERNEL->is_halted()) {
+            // the step ticker is throwing everything away so just end the block
+            seg.interval = 0;
+            seg.n_events = 0;
+            seg.speed = 0;
+            seg.last = true;
+            st->push_segment(seg);
+            block = nullptr;
+            restart_shaping();
+            advance.fill(0);
+            advance_rate.fill(0);
+            continue;
+        }
+
+        float end_tick = block_tick + segment_ticks;
+        // do not leave a tiny segment at the end of the block
+        seg.last = (end_tick + segment_ticks / 2 >= block->total_move_ticks);
+        if(seg.last) end_tick = block->total_move_ticks;
+
+        float s = block->get_steps_at(end_tick) / block->steps_event_count;
+        uint16_t n_events = 1;
+        for (uint8_t m = 0; m < Block::n_actuators; m++) {
+            if(block->steps[m] == 0) continue;
+            uint32_t target;
+            if(seg.last) target = block->steps[m];
+            else if(block->is_arc) target = arc_steps(m, s);
+            else target = floorf(s * block->steps[m] + 0.5F);
+            if(target < issued[m]) target = issued[m];
+
+            if(shaping && m < N_SHAPED_ACTUATORS && shapers[m].is_enabled()) {
+                // only the unshaped position moves on here, the steps come from the shaped position below
+                issued[m] = target;
+                position[m] = block_start[m] + (block->direction_bits[m] ? -(int32_t)target : (int32_t)target);
+                continue;
+            }
+
+            uint32_t n = target - issued[m];
+            if(n > 0xFFFF) n = 0xFFFF; // the rest will go in the next segment
+            seg.steps[m] = n;
+            issued[m] += n;
+            if(n > n_events) n_events = n;
+        }
+        // a long block may not have got all its steps out if the segment was capped, keep going until it has
+        if(seg.last) {
+            for (uint8_t m = 0; m < Block::n_actuators; m++) {
+                if(issued[m] != block->steps[m]) seg.last = false;
+            }
+        }
+
+        float ticks = end_tick - block_tick;
+        if(ticks < 1) ticks = 1;
+
+        n_events = std::max(n_events, advance_steps(seg, seg.last ? (float)block->total_move_ticks : end_tick, ticks));
+
+        if(shaping) {
+            now = block_now + lroundf(end_tick);
+            add_knot();
+            n_events = std::max(n_events, shape_steps(seg));
+        }
+
+        seg.n_events = n_events;
+        seg.interval = segment_interval(ticks, n_events);
+
+        // the path speed over this segment as a fraction of the nominal speed, what the laser power follows
+        float end_s = seg.last ? 1.0F : s;
+        float ratio = (block->nominal_speed > 0) ? (end_s - block_s) * block->millimeters * frequency / (block->nominal_speed * ticks) : 0;
+        seg.speed = (ratio > 0) ? std::min(lroundf(ratio * 256), 0xFFFFL) : 0;
+        block_s = end_s;
+
+        // the shaped motors or the advance are still on their way, the block is kept for the tail unless they have all caught up
+        bool tail = false;
+        if(seg.last) {
+            if(shaping) {
+                tail = ((int32_t)(now - last_motion_tick) < (int32_t)duration_ticks);
+                for (uint8_t m = 0; m < N_SHAPED_ACTUATORS; m++) {
+                    if(shaped[m] != position[m]) tail = true;
+                }
+            }
+            if(advancing()) tail = true;
+            if(tail) seg.last = false;
+        }
+
+        st->push_segment(seg);
+        block_tick = end_tick;
+        if(seg.last || tail) {
+            if(tail) tail_block = block;
+            block = nullptr;
+        }
+    }
+}
+
+// timer counts between the step events of a segment, what is lost to rounding is made up in the next segment so the
+// segments do not drift from the time the blocks were planned to take
+uint32_t StepSegmenter::segment_interval(float ticks, uint16_t n_events)
+{
+    float counts = ticks * timer_counts_per_tick + count_carry;
+    int32_t interval = lroundf(counts / n_events);
+    if(interval < 1) {
+        count_carry = 0;
+        return 1;
+    }
+    count_carry = counts - (float)interval * n_events;
+    return interval;
+}
+
+// the planned rate at a tick of the block, in steps of the fastest motor per tick
+float StepSegmenter::rate_at(float tick) const
+{
+    // the end of the block is where the next one takes over at the exit speed
+    if(tick >= block->total_move_ticks) {
+        return (block->millimeters > 0) ? block->exit_speed * block->steps_event_count / (block->millimeters * frequency) : 0;
+    }
+    // otherwise from the profile a few ticks either side, the same for the trapezoid and the S-curve
+    float t0 = std::max(tick - 4.0F, 0.0F);
+    float t1 = std::min(tick + 4.0F, (float)block->total_move_ticks);
+    return (block->get_steps_at(t1) - block->get_steps_at(t0)) / (t1 - t0);
+}
+
+// pressure advance, each extruder that has it is taken toward its planned position plus its advance times its planned
+// rate at the end of the segment. Only when it extrudes along an XYZ move, otherwise the advance is taken back out, and
+// after the last block (block is nullptr) it is taken back out over the tail segments
+uint16_t StepSegmenter::advance_steps(step_segment_t& seg, float end_tick, float ticks)
+{
+    uint16_t n_events = 0;
+    bool xyz = block != nullptr && (block->steps[X_AXIS] | block->steps[Y_AXIS] | block->steps[Z_AXIS]) != 0;
+    float rate = -1;
+    for (uint8_t m = 0; m < Block::n_actuators; m++) {
+        StepperMotor *motor = THEROBOT->actuators[m];
+        if(!motor->is_extruder()) continue;
+        float k = motor->get_pressure_advance();
+        if(k <= 0 && advance[m] == 0 && advance_rate[m] == 0) continue;
+
+        int32_t a = 0;
+        if(k > 0 && xyz && block->steps[m] > 0 && !block->direction_bits[m]) {
+            if(rate < 0) rate = rate_at(end_tick);
+            a = lroundf(k * frequency * rate * block->steps[m] / block->steps_event_count);
+        }
+        if(a == advance[m] && advance_rate[m] == 0) continue;
+
+        int32_t planned = (block == nullptr) ? 0 : block->direction_bits[m] ? -(int32_t)seg.steps[m] : seg.steps[m];
+        int32_t n = planned + limit_advance(m, planned, a - advance[m], ticks);
+        if(n > 0xFFFF) n = 0xFFFF;
+        if(n < -0xFFFF) n = -0xFFFF;
+        advance[m] += n - planned;
+        seg.steps[m] = labs(n);
+        seg.direction_bits[m] = (n < 0);
+        if(seg.steps[m] > n_events) n_events = seg.steps[m];
+    }
+    return n_events;
+}
+
+// how much of r, the change still to be made to extruder m's advance, goes in a segment of ticks with planned steps in
+// it. The advance changes no faster than the extruder's acceleration allows, slowing down to stop where it is going,
+// and with the planned steps the extruder is held to its max rate. What is left is carried into the next segments
+int32_t StepSegmenter::limit_advance(uint8_t m, int32_t planned, int32_t r, float ticks)
+{
+    StepperMotor *motor = THEROBOT->actuators[m];
+    float steps_per_mm = motor->get_steps_per_mm();
+
+    // steps per tick
+    float want = r / ticks;
+    float acc = motor->get_acceleration() * steps_per_mm / (frequency * frequency);
+    if(acc > 0) {
+        float stop = sqrtf(2 * acc * labs(r));
+        want = confine(want, -stop, stop);
+        want = confine(want, advance_rate[m] - acc * ticks, advance_rate[m] + acc * ticks);
+    }
+
+    int32_t d = lroundf(want * ticks);
+    d = (r < 0) ? confine(d, r, 0) : confine(d, 0, r);
+    float max_rate = motor->get_max_rate();
+    if(max_rate > 0) {
+        int32_t max_steps = floorf(max_rate * steps_per_mm * ticks / frequency);
+        d = confine(d, std::min(-max_steps - planned, 0), std::max(max_steps - planned, 0));
+    }
+
+    // a rate too low to make a step this segment still builds up for the next one
+    advance_rate[m] = (d == lroundf(want * ticks)) ? want : d / ticks;
+    return d;
+}
+
+// an extruder's advance is not yet where it is going
+bool StepSegmenter::advancing() const
+{
+    for (uint8_t m = 0; m < Block::n_actuators; m++) {
+        if(advance[m] != 0 || advance_rate[m] != 0) return true;
+    }
+    return false;
+}
+
+// steps motor m should have made by fraction s of the path of an arc block
+uint32_t StepSegmenter::arc_steps(uint8_t m, float s) const
+{
+    const Block::arc_t &arc = block->arc;
+    float pos;
+    int i;
+    if(m == arc.axis[0]) {
+        i = 0;
+        pos = arc.center[0] + arc.radius * cosf(arc.start_angle + s * arc.angular_travel);
+    } else if(m == arc.axis[1]) {
+        i = 1;
+        pos = arc.center[1] + arc.radius * sinf(arc.start_angle + s * arc.angular_travel);
+    } else if(m == arc.axis[2]) {
+        i = 2;
+        pos = arc.linear_start + s * arc.linear_travel;
+    } else {
+        // not part of the arc (an extruder), moves in proportion
+        return floorf(s * block->steps[m] + 0.5F);
+    }
+
+    // the block never crosses a quadrant so the motor goes one way only
+    int32_t d = lroundf(pos * THEROBOT->actuators[m]->get_steps_per_mm()) - arc.start_steps[i];
+    uint32_t n = labs(d);
+    return (n > block->steps[m]) ? block->steps[m] : n;
+}
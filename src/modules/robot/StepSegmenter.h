@@ -0,0 +1,86 @@
+/*
+      This file is part of Smoothie (http://smoothieware.org/). The motion control part is heavily based on Grbl (https://github.com/simen/grbl).
+      Smoothie is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+      Smoothie is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+      You should have received a copy of the GNU General Public License along with Smoothie. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "ActuatorCoordinates.h"
+#include "StepTicker.h"
+
+#include <stdint.h>
+#include <array>
+
+class Block;
+class InputShaper;
+
+// only the first three actuators can be input shaped
+#define N_SHAPED_ACTUATORS 3
+
+// Cuts the blocks handed out by the Conveyor into short constant rate segments for the step ticker.
+// Runs from PendSV at the lowest priority so all the acceleration math is done off the step ISR, and a main loop
+// that is held up for longer than the segment buffer lasts does not stop the motors part way through a block.
+// Extruders with pressure advance are stepped ahead of the blocks by their advance times the planned extrusion rate,
+// the advance changes no faster than the extruder's acceleration and max rate allow and can run on past the last block.
+// When input shaping is on the shaped motors step out their motion convolved with the shaper's impulses instead,
+// which lags behind the blocks by up to the shaper's duration and runs on past the end of the last one
+class StepSegmenter
+{
+public:
+    StepSegmenter(float segment_ms, const InputShaper *shapers);
+    ~StepSegmenter();
+    void prepare();
+    // picks up changed shapers, only to be called when nothing is queued so a refill has nothing to touch
+    void reset_shaping();
+
+private:
+    bool next_block();
+    void finish_block(Block *b);
+    uint32_t arc_steps(uint8_t m, float s) const;
+    uint32_t segment_interval(float ticks, uint16_t n_events);
+    float rate_at(float tick) const;
+    uint16_t advance_steps(step_segment_t& seg, float end_tick, float ticks);
+    int32_t limit_advance(uint8_t m, int32_t planned, int32_t r, float ticks);
+    bool advancing() const;
+    void restart_shaping();
+    void add_knot();
+    uint16_t shape_steps(step_segment_t& seg);
+    float unshaped_at(uint8_t m, uint32_t t) const;
+    void push_tail_segment();
+
+    Block *block{nullptr};              // block currently being cut into segments
+    float block_tick;                   // how far into the block (in step ticker ticks) the segments have reached
+    float block_s;                      // fraction of the path the segments have reached
+    float segment_ticks;                // nominal segment length in step ticker ticks
+    float timer_counts_per_tick;
+    float frequency;
+    float count_carry;                  // timer counts the last segment was short by
+    std::array<uint32_t, k_max_actuators> issued; // steps already put in segments for each motor
+    std::array<int32_t, k_max_actuators> advance; // steps the extruders have been pushed ahead of the blocks by pressure advance
+    std::array<float, k_max_actuators> advance_rate; // steps per tick the advance changed by in the last segment
+
+    // input shaping, the unshaped position of the shaped motors is kept at the end of each segment (a knot)
+    // for as long as the shapers look back, the shaped position at any time is then the sum of the impulses
+    // times the unshaped position that long ago
+    struct knot_t {
+        uint32_t tick;
+        int32_t position[N_SHAPED_ACTUATORS];
+    };
+    const InputShaper *shapers;
+    uint32_t impulse_ticks[N_SHAPED_ACTUATORS][3];
+    uint32_t duration_ticks;            // the longest shaper
+    knot_t *knots{nullptr};
+    uint16_t knots_size{0};
+    uint16_t knots_head{0};             // the newest knot
+    uint16_t knots_count{0};
+    uint32_t now;                       // tick at the end of the last segment
+    uint32_t block_now;                 // tick at the start of the block
+    uint32_t last_motion_tick;          // tick at which the unshaped motion last ended
+    int32_t position[N_SHAPED_ACTUATORS];       // unshaped position in steps, relative to where shaping was reset
+    int32_t block_start[N_SHAPED_ACTUATORS];    // unshaped position at the start of the block
+    int32_t shaped[N_SHAPED_ACTUATORS];         // shaped position that has been put in segments
+    Block *tail_block{nullptr};         // block whose segments are all out but is kept going for the shaped or advance tail
+    bool shaping{false};
+};
@@ -19,11 +19,16 @@
 #define tower1_angle_checksum       CHECKSUM("delta_tower1_angle")
 #define tower2_angle_checksum       CHECKSUM("delta_tower2_angle")
 #define tower3_angle_checksum       CHECKSUM("delta_tower3_angle")
+#define fast_kinematics_checksum    CHECKSUM("delta_fast_kinematics")
 
 #define SQ(x) powf(x, 2)
 #define ROUND(x, y) (roundf(x * (float)(1e ## y)) / (float)(1e ## y))
 #define PIOVER180   0.01745329251994329576923690768489F
 
+// the fixed point kinematics work in 1/4096 mm
+#define FIXED_SHIFT 12
+#define FIXED_ONE   (1 << FIXED_SHIFT)
+
 LinearDeltaSolution::LinearDeltaSolution(Config* config)
 {
     // arm_length is the length of the arm from hinge to hinge
@@ -38,6 +43,9 @@ LinearDeltaSolution::LinearDeltaSolution(Config* config)
     tower2_offset = config->value(tower2_offset_checksum)->by_default(0.0f)->as_number();
     tower3_offset = config->value(tower3_offset_checksum)->by_default(0.0f)->as_number();
 
+    // there is no FPU so the float kinematics are all library calls, this does them in integer maths instead
+    fast_kinematics = config->value(fast_kinematics_checksum)->by_default(false)->as_bool();
+
     init();
 }
 
@@ -54,10 +62,58 @@ void LinearDeltaSolution::init()
     delta_tower2_y = (delta_radius + tower2_offset) * sinf((330.0F + tower2_angle) * PIOVER180);
     delta_tower3_x = (delta_radius + tower3_offset) * cosf((90.0F  + tower3_angle) * PIOVER180); // back middle tower
     delta_tower3_y = (delta_radius + tower3_offset) * sinf((90.0F  + tower3_angle) * PIOVER180);
+
+    tower_x_fixed[0] = lroundf(delta_tower1_x * FIXED_ONE);
+    tower_y_fixed[0] = lroundf(delta_tower1_y * FIXED_ONE);
+    tower_x_fixed[1] = lroundf(delta_tower2_x * FIXED_ONE);
+    tower_y_fixed[1] = lroundf(delta_tower2_y * FIXED_ONE);
+    tower_x_fixed[2] = lroundf(delta_tower3_x * FIXED_ONE);
+    tower_y_fixed[2] = lroundf(delta_tower3_y * FIXED_ONE);
+    int64_t l = lroundf(arm_length * FIXED_ONE);
+    arm_length_squared_fixed = l * l;
+}
+
+// rounded, the error in x and y is multiplied by how far the arms are from vertical
+static inline int32_t to_fixed(float mm)
+{
+    return mm * FIXED_ONE + (mm < 0.0F ? -0.5F : 0.5F);
+}
+
+// Square root of a 64 bit value to within +-1, for values below 2^46.
+// A 32 bit Newton iteration on the top bits, which only needs the hardware divide, gets the root
+// to 16 bits and one more Newton step on the remainder gets the rest.
+static uint32_t isqrt64(uint64_t n)
+{
+    uint32_t hi = n >> 32;
+    int bits = hi != 0 ? 64 - __builtin_clz(hi) : (n != 0 ? 32 - __builtin_clz((uint32_t)n) : 0);
+
+    // keep the shift even so the root is shifted by a whole number of bits
+    int shift = bits > 32 ? (bits - 31) & ~1 : 0;
+    uint32_t m = n >> shift;
+    if(m == 0) return 0;
+
+    // start above the root, Newton then converges down on floor(sqrt(m))
+    int mbits = 32 - __builtin_clz(m);
+    uint32_t x = 1U << ((mbits + 1) / 2);
+    while(true) {
+        uint32_t y = (x + m / x) >> 1;
+        if(y >= x) break;
+        x = y;
+    }
+    if(shift == 0) return x;
+
+    uint32_t r = x << (shift / 2);
+    // r is at or below the root and n - r*r is less than 2^31 for n below 2^46
+    uint32_t e = n - (uint64_t)r * r;
+    return r + e / (2 * r);
 }
 
 void LinearDeltaSolution::cartesian_to_actuator(const float cartesian_mm[], ActuatorCoordinates &actuator_mm ) const
 {
+    if(fast_kinematics) {
+        cartesian_to_actuator_fixed(cartesian_mm, actuator_mm);
+        return;
+    }
 
     actuator_mm[ALPHA_STEPPER] = sqrtf(this->arm_length_squared
                                        - SQ(delta_tower1_x - cartesian_mm[X_AXIS])
@@ -73,6 +129,27 @@ void LinearDeltaSolution::cartesian_to_actuator(const float cartesian_mm[], Actu
                                       ) + cartesian_mm[Z_AXIS];
 }
 
+// Same as the float version to within 0.001mm wherever the arms are at least 20 degrees above horizontal,
+// see sim/kinematics.cpp. The only float operations left are the conversions in and out
+void LinearDeltaSolution::cartesian_to_actuator_fixed(const float cartesian_mm[], ActuatorCoordinates &actuator_mm ) const
+{
+    int32_t x = to_fixed(cartesian_mm[X_AXIS]);
+    int32_t y = to_fixed(cartesian_mm[Y_AXIS]);
+    int32_t z = to_fixed(cartesian_mm[Z_AXIS]);
+
+    for (int i = 0; i < 3; ++i) {
+        int64_t dx = tower_x_fixed[i] - x;
+        int64_t dy = tower_y_fixed[i] - y;
+        int64_t d2 = arm_length_squared_fixed - dx * dx - dy * dy;
+        if(d2 <= 0) {
+            // out of reach, let the float version deal with it
+            actuator_mm[i] = sqrtf((float)d2) + cartesian_mm[Z_AXIS];
+            continue;
+        }
+        actuator_mm[i] = (int32_t)(isqrt64(d2) + z) * (1.0F / FIXED_ONE);
+    }
+}
+
 void LinearDeltaSolution::actuator_to_cartesian(const ActuatorCoordinates &actuator_mm, float cartesian_mm[] ) const
 {
     // from http://en.wikipedia.org/wiki/Circumscribed_circle#Barycentric_coordinates_from_cross-_and_dot-products
@@ -3,6 +3,8 @@
 #include "libs/Module.h"
 #include "BaseSolution.h"
 
+#include <stdint.h>
+
 class Config;
 
 class LinearDeltaSolution : public BaseSolution {
@@ -16,6 +18,7 @@ class LinearDeltaSolution : public BaseSolution {
 
     private:
         void init();
+        void cartesian_to_actuator_fixed(const float[], ActuatorCoordinates &) const;
 
         float arm_length;
         float arm_radius;
@@ -33,4 +36,13 @@ class LinearDeltaSolution : public BaseSolution {
         float tower1_angle;
         float tower2_angle;
         float tower3_angle;
+
+        // fixed point copies used by cartesian_to_actuator_fixed()
+        int32_t tower_x_fixed[3];
+        int32_t tower_y_fixed[3];
+        int64_t arm_length_squared_fixed;
+
+        struct {
+            bool fast_kinematics:1;
+        };
 };
@@ -20,6 +20,7 @@
 #define tool_offset_checksum            CHECKSUM("delta_tool_offset")
 
 #define delta_mirror_xy_checksum        CHECKSUM("delta_mirror_xy")
+#define delta_fast_kinematics_checksum  CHECKSUM("delta_fast_kinematics")
 
 const static float pi     = 3.14159265358979323846;    // PI
 const static float two_pi = 2 * pi;
@@ -56,10 +57,25 @@ RotaryDeltaSolution::RotaryDeltaSolution(Config *config)
     // mirror the XY axis
     mirror_xy= config->value(delta_mirror_xy_checksum)->by_default(true)->as_bool();
 
+    // use a polynomial for the atan in the inverse kinematics instead of the library atanf
+    fast_kinematics= config->value(delta_fast_kinematics_checksum)->by_default(false)->as_bool();
+
     debug_flag= false;
     init();
 }
 
+// atan to within 1E-5 radians (0.0006 degrees), Abramowitz and Stegun 4.4.49
+// this is about half the float operations of atanf, see sim/kinematics.cpp for the check against it
+static float fast_atanf(float x)
+{
+    bool invert = fabsf(x) > 1.0F;
+    if(invert) x = 1.0F / x;
+    float x2 = x * x;
+    float a = x * (0.9998660F + x2 * (-0.3302995F + x2 * (0.1801410F + x2 * (-0.0851330F + x2 * 0.0208351F))));
+    if(invert) a = (x > 0.0F ? pi / 2.0F : -pi / 2.0F) - a;
+    return a;
+}
+
 // inverse kinematics
 // helper functions, calculates angle theta1 (for YZ-pane)
 int RotaryDeltaSolution::delta_calcAngleYZ(float x0, float y0, float z0, float &theta) const
@@ -76,7 +92,8 @@ int RotaryDeltaSolution::delta_calcAngleYZ(float x0, float y0, float z0, float &
     float yj = (y1 - a * b - sqrtf(d)) / (b * b + 1.0F);               // choosing outer point
     float zj = a + b * yj;
 
-    theta = 180.0F * atanf(-zj / (y1 - yj)) / pi + ((yj > y1) ? 180.0F : 0.0F);
+    float t = -zj / (y1 - yj);
+    theta = 180.0F * (fast_kinematics ? fast_atanf(t) : atanf(t)) / pi + ((yj > y1) ? 180.0F : 0.0F);
     return 0;
 }
 
@@ -58,6 +58,7 @@
 #define retract_recover_feedrate_checksum    CHECKSUM("retract_recover_feedrate")
 #define retract_zlift_length_checksum        CHECKSUM("retract_zlift_length")
 #define retract_zlift_feedrate_checksum      CHECKSUM("retract_zlift_feedrate")
+#define pressure_advance_checksum            CHECKSUM("pressure_advance")
 
 #define PI 3.14159265358979F
 
@@ -134,6 +135,8 @@ void Extruder::config_load()
     stepper_motor->change_steps_per_mm(steps_per_millimeter);
     stepper_motor->set_selected(false); // not selected by default
     stepper_motor->set_extruder(true);  // indicates it is an extruder
+    // the extruder is pushed ahead by this many seconds of its planned rate, only when the blocks are cut into segments
+    stepper_motor->set_pressure_advance(THEKERNEL->config->value(extruder_checksum, this->identifier, pressure_advance_checksum)->by_default(0)->as_number());
 }
 
 void Extruder::select()
@@ -325,6 +328,24 @@ void Extruder::on_gcode_received(void *argument)
             if(gcode->has_letter('S')) retract_recover_length = gcode->get_value('S');
             if(gcode->has_letter('F')) retract_recover_feedrate = gcode->get_value('F') / 60.0F; // specified in mm/min converted to mm/sec
 
+        } else if (gcode->m == 900 && ( (this->selected && !gcode->has_letter('P')) || (gcode->has_letter('P') && gcode->get_value('P') == this->identifier)) ) {
+            // M900 Knnn set the pressure advance in seconds, 0 turns it off, M900 reports it
+            if(gcode->has_letter('K')) {
+                float k = gcode->get_value('K');
+                if(k < 0 || k > 1) {
+                    gcode->stream->printf("Error: pressure advance must be between 0 and 1 second\n");
+                } else {
+                    // the segmenter works the advance out for each segment so it can change between moves
+                    THECONVEYOR->wait_for_idle();
+                    stepper_motor->set_pressure_advance(k);
+                }
+            } else {
+                gcode->stream->printf("Pressure advance: %1.4f s\n", stepper_motor->get_pressure_advance());
+            }
+            if(stepper_motor->get_pressure_advance() > 0 && THECONVEYOR->get_step_segment_ms() == 0) {
+                gcode->stream->printf("Warning: pressure advance needs step_segment_ms to be set\n");
+            }
+
         } else if (gcode->m == 221 && this->selected) { // M221 S100 change flow rate by percentage
             if(gcode->has_letter('S')) {
                 float last_scale = this->extruder_multiplier;
@@ -350,6 +371,7 @@ void Extruder::on_gcode_received(void *argument)
             if(this->max_volumetric_rate > 0) {
                 gcode->stream->printf(";E max volumetric rate mm³/sec:\nM203 V%1.4f P%d\n", this->max_volumetric_rate, this->identifier);
             }
+            gcode->stream->printf(";E pressure advance seconds:\nM900 K%1.4f P%d\n", stepper_motor->get_pressure_advance(), this->identifier);
         }
 
     } else if( gcode->has_g && this->selected ) {
@@ -6,6 +6,7 @@
 */
 
 #include "Laser.h"
+#include "LaserRaster.h"
 #include "Module.h"
 #include "Kernel.h"
 #include "nuts_bolts.h"
@@ -16,7 +17,6 @@
 #include "ConfigValue.h"
 #include "StepTicker.h"
 #include "Block.h"
-#include "SlowTicker.h"
 #include "Robot.h"
 #include "utils.h"
 #include "Pin.h"
@@ -112,8 +112,11 @@ void Laser::on_module_loaded()
     this->register_for_event(ON_CONSOLE_LINE_RECEIVED);
     this->register_for_event(ON_GET_PUBLIC_DATA);
 
-    // no point in updating the power more than the PWM frequency, but no more than 1KHz
-    THEKERNEL->slow_ticker->attach(std::min(1000UL, 1000000/period), this, &Laser::set_proportional_power);
+    // the step ticker tells us as soon as the speed changes, every segment or step of the fastest motor
+    THEKERNEL->step_ticker->speed_fnc = [this](const Block *block, float ratio, uint16_t pixel) { speed_changed(block, ratio, pixel); };
+
+    // M660 scan lines
+    THEKERNEL->add_module(new LaserRaster());
 }
 
 void Laser::on_console_line_received( void *argument )
@@ -182,52 +185,17 @@ void Laser::on_gcode_received(void *argument)
     }
 }
 
-// calculates the current speed ratio from the currently executing block
-float Laser::current_speed_ratio(const Block *block) const
-{
-    // find the primary moving actuator (the one with the most steps)
-    size_t pm= 0;
-    uint32_t max_steps= 0;
-    for (size_t i = 0; i < THEROBOT->get_number_registered_motors(); i++) {
-        // find the motor with the most steps
-        if(block->steps[i] > max_steps) {
-            max_steps= block->steps[i];
-            pm= i;
-        }
-    }
-
-    // figure out the ratio of its speed, from 0 to 1 based on where it is on the trapezoid,
-    // this is based on the fraction it is of the requested rate (nominal rate)
-    float ratio= block->get_trapezoid_rate(pm) / block->nominal_rate;
-
-    return ratio;
-}
-
-// get laser power for the currently executing block, returns false if nothing running or a G0
-bool Laser::get_laser_power(float& power) const
-{
-    const Block *block = StepTicker::getInstance()->get_current_block();
-
-    // Note to avoid a race condition where the block is being cleared we check the is_ready flag which gets cleared first,
-    // as this is an interrupt if that flag is not clear then it cannot be cleared while this is running and the block will still be valid (albeit it may have finished)
-    if(block != nullptr && block->is_ready && block->is_g123) {
-        float requested_power = ((float)block->s_value/(1<<11)) / this->laser_maximum_s_value; // s_value is 1.11 Fixed point
-        float ratio = current_speed_ratio(block);
-        power = requested_power * ratio * scale;
-
-        return true;
-    }
-
-    return false;
-}
-
-// called every millisecond from timer ISR
-uint32_t Laser::set_proportional_power(uint32_t dummy)
+// called from the step ISR whenever the actual speed changes, ratio is the speed as a fraction of the block's nominal speed.
+// The power is set there and then, so it follows the acceleration and the energy per mm stays the same through the ramps.
+// On a raster block it is also called as the laser moves on to each pixel, and the pixel's power is used instead of S
+void Laser::speed_changed(const Block *block, float ratio, uint16_t pixel)
 {
-    if(manual_fire) return 0;
+    if(manual_fire) return;
 
-    float power;
-    if(get_laser_power(power)) {
+    if(block != nullptr && block->is_g123) {
+        float requested_power = (block->raster != nullptr) ? block->raster->power[pixel] / 255.0F :
+                                ((float)block->s_value/(1<<11)) / this->laser_maximum_s_value; // s_value is 1.11 Fixed point
+        float power = requested_power * ratio * scale;
         // adjust power to maximum power and actual velocity
         float proportional_power = ( (this->laser_maximum_power - this->laser_minimum_power) * power ) + this->laser_minimum_power;
         set_laser_power(proportional_power);
@@ -236,7 +204,6 @@ uint32_t Laser::set_proportional_power(uint32_t dummy)
         // turn laser off
         set_laser_power(0);
     }
-    return 0;
 }
 
 bool Laser::set_laser_power(float power)
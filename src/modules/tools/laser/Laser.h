@@ -33,9 +33,7 @@ class Laser : public Module{
         float get_current_power() const;
 
     private:
-        uint32_t set_proportional_power(uint32_t dummy);
-        bool get_laser_power(float& power) const;
-        float current_speed_ratio(const Block *block) const;
+        void speed_changed(const Block *block, float ratio, uint16_t pixel);
 
         mbed::PwmOut *pwm_pin;    // PWM output to regulate the laser power
         Pin *ttl_pin;				// TTL output to fire laser
@@ -0,0 +1,184 @@
+/*
+      This file is part of Smoothie (http://smoothieware.org/). The motion control part is heavily based on Grbl (https://github.com/simen/grbl).
+      Smoothie is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+      Smoothie is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+      You should have received a copy of the GNU General Public License along with Smoothie. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "LaserRaster.h"
+#include "Kernel.h"
+#include "Config.h"
+#include "ConfigValue.h"
+#include "checksumm.h"
+#include "Gcode.h"
+#include "Robot.h"
+#include "SerialMessage.h"
+#include "StreamOutput.h"
+
+#include <math.h>
+#include <stdio.h>
+
+#define laser_module_raster_buffer_size_checksum CHECKSUM("laser_module_raster_buffer_size")
+
+/*
+    M660 [Xnnn Ynnn] Innn Jnnn Pnnn Nnnn [Fnnn]
+        X Y  optional start of the scan line, it is moved to with a G0 first, otherwise it starts where the last move ended
+        I J  direction of the scan line in XY, does not need to be a unit vector
+        P    pixel pitch
+        N    number of pixels
+        F    speed of the scan line, remembered for the next M660
+
+    followed by lines of @ and the pixel powers in base64, 0 to 255 of the laser's maximum power, each line encoded on its own
+    and as many lines as needed. The data lines are not Gcode so they are not split on G or M, and base64 has none of the
+    real time characters (! ~ ?) that the serial drivers take out of the stream. Each line must fit in the 256 character
+    console buffer, so at most 180 pixels a line. Every data line is answered with ok like a Gcode line.
+*/
+
+LaserRaster::LaserRaster()
+{
+    raster = nullptr;
+    received = 0;
+    direction[0] = 1;
+    direction[1] = 0;
+    pitch = 0;
+    rate_mm_s = 0;
+}
+
+void LaserRaster::on_module_loaded()
+{
+    // the rasters are held by the queued blocks until they are done, this limits how much of the heap they take
+    buffer_size = THEKERNEL->config->value(laser_module_raster_buffer_size_checksum)->by_default(4096)->as_number();
+
+    this->register_for_event(ON_GCODE_RECEIVED);
+    this->register_for_event(ON_CONSOLE_LINE_RECEIVED);
+    this->register_for_event(ON_HALT);
+}
+
+void LaserRaster::on_gcode_received(void *argument)
+{
+    Gcode *gcode = static_cast<Gcode *>(argument);
+    if(!gcode->has_m || gcode->m != 660) return;
+
+    // a scan line that never got all its pixels is dropped
+    delete raster;
+    raster = nullptr;
+
+    float i = gcode->has_letter('I') ? gcode->get_value('I') : 0;
+    float j = gcode->has_letter('J') ? gcode->get_value('J') : 0;
+    float len = sqrtf(i * i + j * j);
+    uint32_t n = gcode->has_letter('N') ? gcode->get_uint('N') : 0;
+    float p = gcode->has_letter('P') ? THEROBOT->to_millimeters(gcode->get_value('P')) : 0;
+    if(gcode->has_letter('F')) rate_mm_s = THEROBOT->to_millimeters(gcode->get_value('F')) / THEROBOT->get_seconds_per_minute();
+
+    if(len < 0.00001F || p <= 0 || n == 0 || n > 65535 || rate_mm_s <= 0) {
+        gcode->stream->printf("Error: M660 needs a direction I J, pitch P, pixel count N and speed F\n");
+        return;
+    }
+    if(n > buffer_size) {
+        gcode->stream->printf("Error: M660 %lu pixels is more than laser_module_raster_buffer_size\n", (unsigned long)n);
+        return;
+    }
+    if(!THEROBOT->linear_arm) {
+        gcode->stream->printf("Error: M660 is not supported on this arm solution\n");
+        return;
+    }
+
+    if(gcode->has_letter('X') || gcode->has_letter('Y')) {
+        char buf[64];
+        int l = snprintf(buf, sizeof(buf), "G0");
+        if(gcode->has_letter('X')) l += snprintf(buf + l, sizeof(buf) - l, " X%1.4f", gcode->get_value('X'));
+        if(gcode->has_letter('Y')) l += snprintf(buf + l, sizeof(buf) - l, " Y%1.4f", gcode->get_value('Y'));
+        Gcode g(buf, gcode->stream);
+        THEKERNEL->call_event(ON_GCODE_RECEIVED, &g);
+    }
+
+    // wait for the scan lines already queued to free up some room
+    while(Block::raster_t::allocated + n > buffer_size && !THEKERNEL->is_halted()) {
+        THEKERNEL->call_event(ON_IDLE, this);
+    }
+    if(THEKERNEL->is_halted()) return;
+
+    direction[0] = i / len;
+    direction[1] = j / len;
+    pitch = p;
+    raster = new Block::raster_t(n);
+    received = 0;
+}
+
+void LaserRaster::on_console_line_received(void *argument)
+{
+    SerialMessage *msgp = static_cast<SerialMessage *>(argument);
+    const std::string& line = msgp->message;
+    if(line.empty() || line[0] != '@') return;
+
+    if(THEKERNEL->is_halted()) {
+        msgp->stream->printf("!!\r\n");
+        return;
+    }
+
+    if(raster == nullptr) {
+        msgp->stream->printf("ok - Unexpected raster data\r\n");
+        return;
+    }
+
+    if(!add_pixels(line)) {
+        delete raster;
+        raster = nullptr;
+        msgp->stream->printf("ok - Bad raster data, scan line dropped\r\n");
+        return;
+    }
+
+    if(received == raster->power.size()) queue_raster();
+    msgp->stream->printf("ok\r\n");
+}
+
+void LaserRaster::on_halt(void *argument)
+{
+    if(argument == nullptr) {
+        delete raster;
+        raster = nullptr;
+    }
+}
+
+static int base64_value(char c)
+{
+    if(c >= 'A' && c <= 'Z') return c - 'A';
+    if(c >= 'a' && c <= 'z') return c - 'a' + 26;
+    if(c >= '0' && c <= '9') return c - '0' + 52;
+    if(c == '+') return 62;
+    if(c == '/') return 63;
+    return -1;
+}
+
+// decodes the base64 after the @ into the pixels, anything past the end of the scan line is ignored
+bool LaserRaster::add_pixels(const std::string& data)
+{
+    uint32_t bits = 0;
+    int nbits = 0;
+    for (size_t i = 1; i < data.size(); ++i) {
+        char c = data[i];
+        if(c == '=') break;
+        if(c == ' ' || c == '\t' || c == '\r' || c == '\n') continue;
+        int v = base64_value(c);
+        if(v < 0) return false;
+
+        bits = (bits << 6) | v;
+        nbits += 6;
+        if(nbits >= 8) {
+            nbits -= 8;
+            if(received < raster->power.size()) raster->power[received++] = (bits >> nbits) & 0xFF;
+        }
+    }
+    return true;
+}
+
+void LaserRaster::queue_raster()
+{
+    float length = pitch * raster->power.size();
+    float delta[2] = {direction[0] * length, direction[1] * length};
+    if(!THEROBOT->raster_move(delta, rate_mm_s, raster)) {
+        // nothing was queued so it is still ours
+        delete raster;
+    }
+    raster = nullptr;
+}
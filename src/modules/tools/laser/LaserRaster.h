@@ -0,0 +1,38 @@
+/*
+      This file is part of Smoothie (http://smoothieware.org/). The motion control part is heavily based on Grbl (https://github.com/simen/grbl).
+      Smoothie is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+      Smoothie is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+      You should have received a copy of the GNU General Public License along with Smoothie. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "libs/Module.h"
+#include "Block.h"
+
+#include <stdint.h>
+#include <string>
+
+// Raster engraving without a G1 per pixel.
+// M660 declares a scan line, then the power of each pixel follows on data lines that start with @ and are base64 encoded,
+// once all the pixels are in the whole scan line is queued as one block and the step ticker moves the laser through them
+class LaserRaster : public Module {
+    public:
+        LaserRaster();
+        virtual ~LaserRaster() {};
+        void on_module_loaded();
+        void on_gcode_received(void *argument);
+        void on_console_line_received(void *argument);
+        void on_halt(void *argument);
+
+    private:
+        bool add_pixels(const std::string& data);
+        void queue_raster();
+
+        Block::raster_t *raster;    // the scan line being received
+        uint16_t received;          // pixels of it received so far
+        float direction[2];         // unit vector in XY
+        float pitch;                // mm per pixel
+        float rate_mm_s;            // speed of the scan lines, set with F on M660
+        uint32_t buffer_size;       // most pixels queued at once
+};
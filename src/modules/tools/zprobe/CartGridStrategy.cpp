@@ -53,6 +53,12 @@
     Display mode of current grid can be changed to human redable mode (table with coordinates) by using 
        leveling-strategy.rectangular-grid.human_readable  true
 
+    Each grid cell is split into subdivisions x subdivisions patches, with more than 1 the surface between the probe
+    points is a smooth (Catmull-Rom) one instead of straight lines between them. Every segment is compensated from
+    the one patch it is in, so it takes the same time however many there are, but each patch takes 16 bytes. They are
+    held to 8K, so a 7x7 grid goes up to 3, a bigger one lower
+       leveling-strategy.rectangular-grid.subdivisions  1
+
     Usage
     -----
     G29 test probes a rectangle which defaults to the width and height, can be overidden with Xnnn and Ynnn
@@ -108,6 +114,10 @@
 #define do_home_checksum             CHECKSUM("do_home")
 #define only_by_two_corners_checksum CHECKSUM("only_by_two_corners")
 #define human_readable_checksum      CHECKSUM("human_readable")
+#define subdivisions_checksum        CHECKSUM("subdivisions")
+
+// the most the patches may take, whatever subdivisions is set to
+#define MAX_PATCH_BYTES 8192
 
 #define GRIDFILE "/sd/cartesian.grid"
 #define GRIDFILE_NM "/sd/cartesian_nm.grid"
@@ -115,11 +125,15 @@
 CartGridStrategy::CartGridStrategy(ZProbe *zprobe) : LevelingStrategy(zprobe)
 {
     grid = nullptr;
+    patches = nullptr;
+    max_patches = 0;
+    patches_x = patches_y = 0;
 }
 
 CartGridStrategy::~CartGridStrategy()
 {
     if(grid != nullptr) AHB0.dealloc(grid);
+    free(patches);
 }
 
 bool CartGridStrategy::handleConfig()
@@ -133,6 +147,7 @@ bool CartGridStrategy::handleConfig()
     do_home = THEKERNEL->config->value(leveling_strategy_checksum, cart_grid_leveling_strategy_checksum, do_home_checksum)->by_default(true)->as_bool();
     only_by_two_corners = THEKERNEL->config->value(leveling_strategy_checksum, cart_grid_leveling_strategy_checksum, only_by_two_corners_checksum)->by_default(false)->as_bool();
     human_readable = THEKERNEL->config->value(leveling_strategy_checksum, cart_grid_leveling_strategy_checksum, human_readable_checksum)->by_default(false)->as_bool();
+    subdivisions = std::max(1, std::min(16, (int)THEKERNEL->config->value(leveling_strategy_checksum, cart_grid_leveling_strategy_checksum, subdivisions_checksum)->by_default(1)->as_number()));
 
     this->x_start = 0.0F;
     this->y_start = 0.0F;
@@ -164,6 +179,30 @@ bool CartGridStrategy::handleConfig()
         return false;
     }
 
+    // a grid probed with I and J never has more points than the configured one so it never has more cells either.
+    // The patches go on the heap, AHB0 is left for the block queue
+    int cells = std::max(0, configured_grid_x_size - 1) * std::max(0, configured_grid_y_size - 1);
+    if(cells > 0) {
+        int s = subdivisions;
+        while(s > 1 && cells * s * s * sizeof(patch_t) > MAX_PATCH_BYTES) s--;
+        max_patches = cells * s * s;
+        patches = (patch_t *)malloc(max_patches * sizeof(patch_t));
+        if(patches == nullptr && s > 1) {
+            // without subdivisions it is the same compensation as always
+            s = 1;
+            max_patches = cells;
+            patches = (patch_t *)malloc(max_patches * sizeof(patch_t));
+        }
+        if(patches == nullptr) {
+            THEKERNEL->streams->printf("Error: Not enough memory\n");
+            return false;
+        }
+        if(s != subdivisions) {
+            THEKERNEL->streams->printf("Warning: grid subdivisions reduced from %d to %d to fit in memory\n", subdivisions, s);
+            subdivisions = s;
+        }
+    }
+
     reset_bed_level();
 
     return true;
@@ -438,6 +477,7 @@ void CartGridStrategy::setAdjustFunction(bool on)
         // set the compensationTransform in robot
         using std::placeholders::_1;
         using std::placeholders::_2;
+        build_patches();
         THEROBOT->compensationTransform = std::bind(&CartGridStrategy::doCompensation, this, _1, _2); // [this](float *target, bool inverse) { doCompensation(target, inverse); };
     } else {
         // clear it
@@ -541,49 +581,104 @@ bool CartGridStrategy::doProbe(Gcode *gc)
     return true;
 }
 
+// the grid point at x, y, past the edges it carries on in a straight line from the two points at the edge
+float CartGridStrategy::grid_point(int x, int y) const
+{
+    if(x < 0) return 2 * grid_point(0, y) - grid_point(1, y);
+    if(x >= current_grid_x_size) return 2 * grid_point(current_grid_x_size - 1, y) - grid_point(current_grid_x_size - 2, y);
+    if(y < 0) return 2 * grid_point(x, 0) - grid_point(x, 1);
+    if(y >= current_grid_y_size) return 2 * grid_point(x, current_grid_y_size - 1) - grid_point(x, current_grid_y_size - 2);
+    return grid[x + (current_grid_x_size * y)];
+}
+
+// the curve through p1 at t=0 and p2 at t=1 with the slopes p0 to p2 and p1 to p3
+static float catmull_rom(float p0, float p1, float p2, float p3, float t)
+{
+    return p1 + 0.5F * t * (p2 - p0 + t * (2 * p0 - 5 * p1 + 4 * p2 - p3 + t * (3 * (p1 - p2) + p3 - p0)));
+}
+
+// height of the smooth surface through the grid points at tx, ty (0 to 1) into the cell at x, y
+float CartGridStrategy::surface_height(int x, float tx, int y, float ty) const
+{
+    // on a grid line the other points do not count, so an unsubdivided grid gives exactly the probed heights
+    if(ty == 0) {
+        if(tx == 0) return grid_point(x, y);
+        return catmull_rom(grid_point(x - 1, y), grid_point(x, y), grid_point(x + 1, y), grid_point(x + 2, y), tx);
+    }
+
+    float h[4];
+    for (int j = 0; j < 4; ++j) {
+        int yj = y + j - 1;
+        if(tx == 0) h[j] = grid_point(x, yj);
+        else h[j] = catmull_rom(grid_point(x - 1, yj), grid_point(x, yj), grid_point(x + 1, yj), grid_point(x + 2, yj), tx);
+    }
+    return catmull_rom(h[0], h[1], h[2], h[3], ty);
+}
+
+// works out the patches for the current grid, so compensating a segment is a lookup and a few multiplies
+void CartGridStrategy::build_patches()
+{
+    int s = subdivisions;
+    patches_x = (current_grid_x_size - 1) * s;
+    patches_y = (current_grid_y_size - 1) * s;
+    if(current_grid_x_size < 2 || current_grid_y_size < 2 || patches_x * patches_y > max_patches) {
+        patches_x = patches_y = 0;
+        return;
+    }
+
+    patch_x_scale = patches_x / this->x_size;
+    patch_y_scale = patches_y / this->y_size;
+    x_min = std::min(this->x_start, this->x_start + this->x_size);
+    x_max = std::max(this->x_start, this->x_start + this->x_size);
+    y_min = std::min(this->y_start, this->y_start + this->y_size);
+    y_max = std::max(this->y_start, this->y_start + this->y_size);
+
+    for (int py = 0; py < patches_y; py++) {
+        for (int px = 0; px < patches_x; px++) {
+            // corners z1 at px,py, z2 at px,py+1, z3 at px+1,py and z4 at px+1,py+1
+            float z1 = surface_height(px / s, (float)(px % s) / s, py / s, (float)(py % s) / s);
+            float z2 = surface_height(px / s, (float)(px % s) / s, (py + 1) / s, (float)((py + 1) % s) / s);
+            float z3 = surface_height((px + 1) / s, (float)((px + 1) % s) / s, py / s, (float)(py % s) / s);
+            float z4 = surface_height((px + 1) / s, (float)((px + 1) % s) / s, (py + 1) / s, (float)((py + 1) % s) / s);
+            patch_t &p = patches[px + (patches_x * py)];
+            p.a = z1;
+            p.b = z3 - z1;
+            p.c = z2 - z1;
+            p.d = z1 - z2 - z3 + z4;
+        }
+    }
+
+    // the next target looks its patch up
+    last_patch_x = last_patch_y = -2;
+    last_patch = nullptr;
+}
+
 void CartGridStrategy::doCompensation(float *target, bool inverse)
 {
-    // Adjust print surface height by linear interpolation over the bed_level array.
-    if ((std::min(this->x_start, this->x_start + this->x_size) <= target[X_AXIS]) && (target[X_AXIS] <= std::max(this->x_start, this->x_start + this->x_size)) && 
-        (std::min(this->y_start, this->y_start + this->y_size) <= target[Y_AXIS]) && (target[Y_AXIS] <= std::max(this->y_start, this->y_start + this->y_size))) {
-            
-            float grid_x = std::max(0.001F, (target[X_AXIS] - this->x_start) / (this->x_size / (this->current_grid_x_size - 1)));
-            float grid_y = std::max(0.001F, (target[Y_AXIS] - this->y_start) / (this->y_size / (this->current_grid_y_size - 1)));
-            int floor_x = floorf(grid_x);
-            int floor_y = floorf(grid_y);
-            float ratio_x = grid_x - floor_x;
-            float ratio_y = grid_y - floor_y;
-            float z1 = grid[(floor_x) + ((floor_y) * this->current_grid_x_size)];
-            float z2 = grid[(floor_x) + ((floor_y + 1) * this->current_grid_x_size)];
-            float z3 = grid[(floor_x + 1) + ((floor_y) * this->current_grid_x_size)];
-            float z4 = grid[(floor_x + 1) + ((floor_y + 1) * this->current_grid_x_size)];
-            float left = (1 - ratio_y) * z1 + ratio_y * z2;
-            float right = (1 - ratio_y) * z3 + ratio_y * z4;
-            float offset = (1 - ratio_x) * left + ratio_x * right;
-
-            if(inverse)
-                target[Z_AXIS] -= offset;
-            else
-                target[Z_AXIS] += offset;
-
-
-    /*
-        THEKERNEL->streams->printf("//DEBUG: TARGET: %f, %f, %f\n", target[0], target[1], target[2]);
-        THEKERNEL->streams->printf("//DEBUG: grid_x= %f\n", grid_x);
-        THEKERNEL->streams->printf("//DEBUG: grid_y= %f\n", grid_y);
-        THEKERNEL->streams->printf("//DEBUG: floor_x= %d\n", floor_x);
-        THEKERNEL->streams->printf("//DEBUG: floor_y= %d\n", floor_y);
-        THEKERNEL->streams->printf("//DEBUG: ratio_x= %f\n", ratio_x);
-        THEKERNEL->streams->printf("//DEBUG: ratio_y= %f\n", ratio_y);
-        THEKERNEL->streams->printf("//DEBUG: z1= %f\n", z1);
-        THEKERNEL->streams->printf("//DEBUG: z2= %f\n", z2);
-        THEKERNEL->streams->printf("//DEBUG: z3= %f\n", z3);
-        THEKERNEL->streams->printf("//DEBUG: z4= %f\n", z4);
-        THEKERNEL->streams->printf("//DEBUG: left= %f\n", left);
-        THEKERNEL->streams->printf("//DEBUG: right= %f\n", right);
-        THEKERNEL->streams->printf("//DEBUG: offset= %f\n", offset);
-    */
+    // Adjust print surface height by bilinear interpolation over the patch the target is in.
+    if (patches_x > 0 && x_min <= target[X_AXIS] && target[X_AXIS] <= x_max && y_min <= target[Y_AXIS] && target[Y_AXIS] <= y_max) {
+        float grid_x = (target[X_AXIS] - this->x_start) * patch_x_scale;
+        float grid_y = (target[Y_AXIS] - this->y_start) * patch_y_scale;
+
+        // most segments are in the same patch as the one before
+        float ratio_x = grid_x - last_patch_x;
+        float ratio_y = grid_y - last_patch_y;
+        if(ratio_x < 0 || ratio_x > 1 || ratio_y < 0 || ratio_y > 1) {
+            last_patch_x = std::max(0, std::min((int)grid_x, patches_x - 1));
+            last_patch_y = std::max(0, std::min((int)grid_y, patches_y - 1));
+            last_patch = &patches[last_patch_x + (patches_x * last_patch_y)];
+            ratio_x = grid_x - last_patch_x;
+            ratio_y = grid_y - last_patch_y;
         }
+
+        const patch_t *p = last_patch;
+        float offset = p->a + p->b * ratio_x + (p->c + p->d * ratio_x) * ratio_y;
+
+        if(inverse)
+            target[Z_AXIS] -= offset;
+        else
+            target[Z_AXIS] += offset;
+    }
 }
 
 
@@ -2,6 +2,7 @@
 
 #include "LevelingStrategy.h"
 
+#include <stdint.h>
 #include <string.h>
 #include <tuple>
 
@@ -25,6 +26,9 @@ private:
     void setAdjustFunction(bool on);
     void print_bed_level(StreamOutput *stream);
     void doCompensation(float *target, bool inverse);
+    void build_patches();
+    float grid_point(int x, int y) const;
+    float surface_height(int x, float tx, int y, float ty) const;
     void reset_bed_level();
     void save_grid(StreamOutput *stream);
     bool load_grid(StreamOutput *stream);
@@ -38,11 +42,24 @@ private:
     float x_start,y_start;
     float x_size,y_size;
 
+    // the compensation is done from bilinear patches worked out when the grid is probed or loaded,
+    // offset = a + b*rx + (c + d*rx)*ry where rx and ry go from 0 to 1 across the patch
+    using patch_t = struct { float a, b, c, d; };
+    patch_t *patches;
+    uint32_t max_patches;           // room allocated for this many
+    uint16_t patches_x, patches_y;  // patches in X and Y for the current grid
+    float patch_x_scale, patch_y_scale; // patches per mm
+    float x_min, x_max, y_min, y_max;   // the probed rectangle
+    // the patch the last target was in, consecutive segments mostly stay in the same one
+    int last_patch_x, last_patch_y;
+    const patch_t *last_patch;
+
     struct {
         uint8_t configured_grid_x_size:8;
         uint8_t configured_grid_y_size:8;
         uint8_t current_grid_x_size:8;
         uint8_t current_grid_y_size:8;
+        uint8_t subdivisions:8;
     };
 
     struct {
@@ -0,0 +1,72 @@
+/*
+      This file is part of Smoothie (http://smoothieware.org/). The motion control part is heavily based on Grbl (https://github.com/simen/grbl).
+      Smoothie is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+      Smoothie is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+      You should have received a copy of the GNU General Public License along with Smoothie. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "CompiledJob.h"
+
+#include <string.h>
+
+const char CompiledJob::magic[]= {'S', 'M', 'J', '1'};
+
+bool CompiledJob::is_compiled(const char *header)
+{
+    return header != nullptr && memcmp(header, magic, header_size) == 0;
+}
+
+int CompiledJob::read_record(LineReader& reader, record_t& rec)
+{
+    const uint8_t *p= (const uint8_t *)reader.peek(1);
+    if(p == nullptr) return 0;
+    rec.type= p[0];
+
+    if(rec.type == LINE) {
+        if((p= (const uint8_t *)reader.peek(2)) == nullptr) return -1;
+        size_t len= p[1];
+        if(len > LineReader::max_line || (p= (const uint8_t *)reader.peek(2 + len)) == nullptr) return -1;
+        memcpy(rec.line, p + 2, len);
+        rec.line[len]= '\0';
+        reader.skip(2 + len);
+        return 2 + len;
+    }
+
+    if(rec.type > G3 || (p= (const uint8_t *)reader.peek(3)) == nullptr) return -1;
+    uint16_t mask= p[1] | (p[2] << 8);
+    if(mask >> MoveWords::NUMBER_OF_WORDS) return -1;
+    size_t size= 3 + __builtin_popcount(mask) * sizeof(float);
+    if((p= (const uint8_t *)reader.peek(size)) == nullptr) return -1;
+
+    rec.words.mask= mask;
+    p += 3;
+    for (int w = 0; w < MoveWords::NUMBER_OF_WORDS; ++w) {
+        if(!rec.words.has((MoveWords::WORD)w)) continue;
+        memcpy(&rec.words.value[w], p, sizeof(float));
+        p += sizeof(float);
+    }
+    reader.skip(size);
+    return size;
+}
+
+size_t CompiledJob::write_move(uint8_t g, const MoveWords& words, uint8_t *buf)
+{
+    uint8_t *p= buf;
+    *p++= g;
+    *p++= words.mask & 0xFF;
+    *p++= words.mask >> 8;
+    for (int w = 0; w < MoveWords::NUMBER_OF_WORDS; ++w) {
+        if(!words.has((MoveWords::WORD)w)) continue;
+        memcpy(p, &words.value[w], sizeof(float));
+        p += sizeof(float);
+    }
+    return p - buf;
+}
+
+size_t CompiledJob::write_line(const char *line, size_t len, uint8_t *buf)
+{
+    buf[0]= LINE;
+    buf[1]= len;
+    memcpy(buf + 2, line, len);
+    return 2 + len;
+}
@@ -0,0 +1,49 @@
+/*
+      This file is part of Smoothie (http://smoothieware.org/). The motion control part is heavily based on Grbl (https://github.com/simen/grbl).
+      Smoothie is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+      Smoothie is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+      You should have received a copy of the GNU General Public License along with Smoothie. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "MoveWords.h"
+#include "LineReader.h"
+
+#include <stdint.h>
+#include <stddef.h>
+
+// A job file the host has already parsed, made from a Gcode file by sim/gcode2smj. It starts with the 4 bytes SMJ1
+// and then has a record per line:
+//
+//   G0-G3 move  type 0-3, a 16 bit mask of the MoveWords given, then a float for each of them in the order of the mask
+//   other line  type 0x10, the length, then the text without the end of line or comments
+//
+// Numbers are little endian, as on the board. The moves go straight to Robot, the other lines are played as they are.
+class CompiledJob {
+    public:
+        enum RECORD_TYPE {
+            G0= 0, G1, G2, G3,
+            LINE= 0x10
+        };
+
+        using record_t = struct {
+            uint8_t type;
+            MoveWords words;                        // of a move
+            char line[LineReader::max_line + 1];    // of a LINE
+        };
+
+        static const size_t header_size= 4;
+        static const size_t max_record= 3 + MoveWords::NUMBER_OF_WORDS * sizeof(float);
+
+        static bool is_compiled(const char *header);
+
+        // the bytes the next record took up, 0 at the end of the file and -1 if what follows is not a record
+        static int read_record(LineReader& reader, record_t& rec);
+
+        // put a record in buf, which is max_record long for a move and len + 2 for a line, and return its size
+        static size_t write_move(uint8_t g, const MoveWords& words, uint8_t *buf);
+        static size_t write_line(const char *line, size_t len, uint8_t *buf);
+
+        static const char magic[header_size];
+};
@@ -0,0 +1,92 @@
+/*
+      This file is part of Smoothie (http://smoothieware.org/). The motion control part is heavily based on Grbl (https://github.com/simen/grbl).
+      Smoothie is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+      Smoothie is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+      You should have received a copy of the GNU General Public License along with Smoothie. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "LineReader.h"
+
+#include <string.h>
+
+void LineReader::attach(FILE *fp, size_t skip)
+{
+    file= fp;
+    start= end= 0;
+    eof= false;
+    if(fp == nullptr) {
+        delete[] buf;
+        buf= nullptr;
+        return;
+    }
+
+    if(buf == nullptr) buf= new char[2 * sector_size + 1];
+    // the stdio buffer would only be copied out of again
+    setvbuf(fp, nullptr, _IONBF, 0);
+
+    if(skip > 0) {
+        fill();
+        start= skip < end ? skip : end;
+    }
+}
+
+// moves what is left to the front and reads the next sector after it
+bool LineReader::fill()
+{
+    if(eof) return false;
+    if(start > 0) {
+        memmove(buf, buf + start, end - start);
+        end -= start;
+        start= 0;
+    }
+    size_t n= fread(buf + end, 1, sector_size, file);
+    if(n < sector_size) eof= true;
+    end += n;
+    return n > 0;
+}
+
+size_t LineReader::next_line(char *&line)
+{
+    if(file == nullptr) return 0;
+
+    size_t skipped= 0;  // of a line too long for the buffer
+    char *nl;
+    while((nl= (char *)memchr(buf + start, '\n', end - start)) == nullptr) {
+        if(end - start > max_line) {
+            // too long to be played, throw away what there is of it and read on to its end
+            skipped += end - start;
+            start= end= 0;
+        }
+        if(!fill()) break;
+    }
+
+    size_t len;
+    if(nl == nullptr) {
+        // the last line has no end of line
+        if(start == end) {
+            line= nullptr;
+            return skipped;
+        }
+        nl= buf + end;
+        len= end - start;
+    } else {
+        len= nl - (buf + start) + 1;
+    }
+
+    line= buf + start;
+    start += len;
+    size_t n= nl - line;
+    *nl= '\0';
+    if(n > 0 && line[n - 1] == '\r') line[--n]= '\0';
+    if(skipped > 0 || n > max_line) line= nullptr;
+    return skipped + len;
+}
+
+const char *LineReader::peek(size_t n)
+{
+    if(file == nullptr) return nullptr;
+    while(end - start < n) {
+        if(!fill()) return nullptr;
+    }
+    return buf + start;
+}
@@ -0,0 +1,47 @@
+/*
+      This file is part of Smoothie (http://smoothieware.org/). The motion control part is heavily based on Grbl (https://github.com/simen/grbl).
+      Smoothie is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+      Smoothie is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+      You should have received a copy of the GNU General Public License along with Smoothie. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <stdio.h>
+#include <stddef.h>
+
+// Splits a file into lines, reading it ahead of them a whole sector at a time.
+// The file is unbuffered and read in sector sized pieces from a sector boundary, so FatFs reads the sectors straight
+// into the buffer instead of through its own. The buffer holds two sectors, what is left of the last one and the next,
+// so a line can run from one into the other.
+class LineReader {
+    public:
+        LineReader() : file(nullptr), buf(nullptr), start(0), end(0), eof(false) {}
+        ~LineReader() { delete[] buf; }
+
+        // reads fp from where it is, which must be a sector boundary, skipping the first skip bytes. nullptr frees the buffer
+        void attach(FILE *fp, size_t skip= 0);
+        FILE *get_file() const { return file; }
+
+        // the bytes the next line took up in the file, 0 at the end of it. line is set to the text without the end of
+        // line, or to nullptr if the line was longer than max_line and was skipped
+        size_t next_line(char *&line);
+
+        // the next n bytes of the file without reading past them, nullptr if the file ends before them. n is at most a
+        // sector, the bytes stay put until the next call
+        const char *peek(size_t n);
+        // reads past n bytes that were peeked at
+        void skip(size_t n) { start += n; }
+
+        static const size_t sector_size= 512;
+        static const size_t max_line= 128;
+
+    private:
+        bool fill();
+
+        FILE *file;
+        char *buf;      // two sectors and a terminator
+        size_t start;   // the unread part of buf
+        size_t end;
+        bool eof;
+};
@@ -9,6 +9,7 @@
 
 #include "libs/Kernel.h"
 #include "Robot.h"
+#include "GcodeDispatch.h"
 #include "libs/nuts_bolts.h"
 #include "libs/utils.h"
 #include "SerialConsole.h"
@@ -33,6 +34,8 @@
 #include <cstddef>
 #include <cmath>
 #include <algorithm>
+#include <fcntl.h>
+#include <unistd.h>
 
 #include "mbed.h"
 
@@ -41,6 +44,7 @@
 #define after_suspend_gcode_checksum      CHECKSUM("after_suspend_gcode")
 #define before_resume_gcode_checksum      CHECKSUM("before_resume_gcode")
 #define leave_heaters_on_suspend_checksum CHECKSUM("leave_heaters_on_suspend")
+#define player_time_budget_checksum       CHECKSUM("player_time_budget_ms")
 
 extern SDFAT mounter;
 
@@ -52,7 +56,11 @@ Player::Player()
     this->elapsed_secs = 0;
     this->reply_stream = nullptr;
     this->suspended= false;
+    this->compiled_job= false;
     this->suspend_loops= 0;
+    this->played_lines= 0;
+    this->budget_used_cnt= 0;
+    this->start_underrun_cnt= 0;
 }
 
 void Player::on_module_loaded()
@@ -73,6 +81,77 @@ void Player::on_module_loaded()
     std::replace( this->after_suspend_gcode.begin(), this->after_suspend_gcode.end(), '_', ' '); // replace _ with space
     std::replace( this->before_resume_gcode.begin(), this->before_resume_gcode.end(), '_', ' '); // replace _ with space
     this->leave_heaters_on = THEKERNEL->config->value(leave_heaters_on_suspend_checksum)->by_default(false)->as_bool();
+    // how long each main loop may feed lines from the file while the queue has room, 0 feeds one line per main loop
+    this->time_budget_us = THEKERNEL->config->value(player_time_budget_checksum)->by_default(10)->as_number() * 1000;
+}
+
+// opens a job file with its clusters mapped, so neither seeking to where a print resumes nor reading on through a
+// long file follows the FAT chain
+FILE *Player::open_file(const string& name)
+{
+    int fd = open(name.c_str(), O_RDONLY | O_FASTSEEK);
+    if(fd < 0) return NULL;
+    FILE *fp = fdopen(fd, "r");
+    if(fp == NULL) close(fd);
+    return fp;
+}
+
+// a file was opened and is read from the start
+void Player::file_opened()
+{
+    reader.attach(this->current_file_handler);
+    this->played_cnt = 0;
+    this->compiled_job = CompiledJob::is_compiled(reader.peek(CompiledJob::header_size));
+    if(this->compiled_job) {
+        reader.skip(CompiledJob::header_size);
+        this->played_cnt = CompiledJob::header_size;
+    }
+    this->elapsed_secs = 0;
+    this->played_lines = 0;
+    this->budget_used_cnt = 0;
+    this->start_underrun_cnt = THEKERNEL->conveyor->get_underrun_count();
+}
+
+// carries on reading the opened file from byte pos, which should be the start of a line as reported by M27
+bool Player::seek_file(unsigned long pos)
+{
+    if(this->current_file_handler == NULL || pos > (unsigned long)this->file_size) return false;
+    if(this->compiled_job && pos < CompiledJob::header_size) pos = CompiledJob::header_size;
+
+    // the reader starts on a sector boundary, it reads the sector pos is in and skips up to it
+    size_t skip = pos % LineReader::sector_size;
+    if(fseek(this->current_file_handler, pos - skip, SEEK_SET) != 0) return false;
+    reader.attach(this->current_file_handler, skip);
+    this->played_cnt = pos;
+    return true;
+}
+
+// the next line of a compiled job, like LineReader::next_line. A move is planned here and its line is empty
+size_t Player::next_record(char *&line)
+{
+    int len = CompiledJob::read_record(reader, record);
+    if(len < 0) {
+        // not something gcode2smj wrote, nothing after it can be trusted
+        THEKERNEL->streams->printf("Error: bad record in compiled job at byte %lu\r\n", played_cnt);
+        return 0;
+    }
+    if(len == 0) return 0;
+
+    if(record.type != CompiledJob::LINE) {
+        THEROBOT->compiled_move(record.type, record.words);
+        THEKERNEL->gcode_dispatch->set_modal_command(record.type);
+        played_lines++;
+        record.line[0] = '\0';
+    }
+    line = record.line;
+    return len;
+}
+
+void Player::close_file()
+{
+    fclose(this->current_file_handler);
+    this->current_file_handler = NULL;
+    reader.attach(nullptr);
 }
 
 void Player::on_halt(void* argument)
@@ -117,9 +196,9 @@ void Player::on_gcode_received(void *argument)
 
             if(this->current_file_handler != NULL) {
                 this->playing_file = false;
-                fclose(this->current_file_handler);
+                close_file();
             }
-            this->current_file_handler = fopen( this->filename.c_str(), "r");
+            this->current_file_handler = open_file(this->filename);
 
             if(this->current_file_handler == NULL) {
                 gcode->stream->printf("file.open failed: %s\r\n", this->filename.c_str());
@@ -138,9 +217,7 @@ void Player::on_gcode_received(void *argument)
                 gcode->stream->printf("File selected\r\n");
             }
 
-
-            this->played_cnt = 0;
-            this->elapsed_secs = 0;
+            file_opened();
 
         } else if (gcode->m == 24) { // start print
             if (this->current_file_handler != NULL) {
@@ -154,7 +231,7 @@ void Player::on_gcode_received(void *argument)
         } else if (gcode->m == 25) { // pause print
             this->playing_file = false;
 
-        } else if (gcode->m == 26) { // Reset print. Slightly different than M26 in Marlin and the rest
+        } else if (gcode->m == 26) { // Reset print. Slightly different than M26 in Marlin and the rest, M26 Snnn then resumes from byte nnn
             if(this->current_file_handler != NULL) {
                 string currentfn = this->filename.c_str();
                 unsigned long old_size = this->file_size;
@@ -164,7 +241,7 @@ void Player::on_gcode_received(void *argument)
 
                 if(!currentfn.empty()) {
                     // reload the last file opened
-                    this->current_file_handler = fopen(currentfn.c_str() , "r");
+                    this->current_file_handler = open_file(currentfn);
 
                     if(this->current_file_handler == NULL) {
                         gcode->stream->printf("file.open failed: %s\r\n", currentfn.c_str());
@@ -172,6 +249,10 @@ void Player::on_gcode_received(void *argument)
                         this->filename = currentfn;
                         this->file_size = old_size;
                         this->current_stream = nullptr;
+                        file_opened();
+                        if(gcode->has_letter('S') && !seek_file(gcode->get_uint('S'))) {
+                            gcode->stream->printf("Could not seek to %lu\r\n", (unsigned long)gcode->get_uint('S'));
+                        }
                     }
                 }
             } else {
@@ -188,10 +269,10 @@ void Player::on_gcode_received(void *argument)
 
             if(this->current_file_handler != NULL) {
                 this->playing_file = false;
-                fclose(this->current_file_handler);
+                close_file();
             }
 
-            this->current_file_handler = fopen( this->filename.c_str(), "r");
+            this->current_file_handler = open_file(this->filename);
             if(this->current_file_handler == NULL) {
                 gcode->stream->printf("file.open failed: %s\r\n", this->filename.c_str());
             } else {
@@ -205,11 +286,9 @@ void Player::on_gcode_received(void *argument)
                         file_size = ftell(this->current_file_handler);
                         fseek(this->current_file_handler, 0, SEEK_SET);
                 }
+                file_opened();
             }
 
-            this->played_cnt = 0;
-            this->elapsed_secs = 0;
-
         } else if (gcode->m == 600) { // suspend print, Not entirely Marlin compliant, M600.1 will leave the heaters on
             this->suspend_command((gcode->subcode == 1)?"h":"", gcode->stream);
 
@@ -277,10 +356,10 @@ void Player::play_command( string parameters, StreamOutput *stream )
     }
 
     if(this->current_file_handler != NULL) { // must have been a paused print
-        fclose(this->current_file_handler);
+        close_file();
     }
 
-    this->current_file_handler = fopen( this->filename.c_str(), "r");
+    this->current_file_handler = open_file(this->filename);
     if(this->current_file_handler == NULL) {
         stream->printf("File not found: %s\r\n", this->filename.c_str());
         return;
@@ -308,8 +387,7 @@ void Player::play_command( string parameters, StreamOutput *stream )
         fseek(this->current_file_handler, 0, SEEK_SET);
         stream->printf("  File size %ld\r\n", file_size);
     }
-    this->played_cnt = 0;
-    this->elapsed_secs = 0;
+    file_opened();
 }
 
 void Player::progress_command( string parameters, StreamOutput *stream )
@@ -347,6 +425,10 @@ void Player::progress_command( string parameters, StreamOutput *stream )
                 stream->printf(", est time: %02lu:%02lu:%02lu",  est / 3600, (est % 3600) / 60, est % 60);
             }
             stream->printf("\r\n");
+            // the queue running dry while the file still has moves means the lines are not being fed fast enough
+            stream->printf("lines: %lu, %lu lines/sec, queue ran dry %lu times, time budget used up %lu times\r\n", this->played_lines,
+                this->elapsed_secs > 0 ? this->played_lines / this->elapsed_secs : 0,
+                (unsigned long)(THEKERNEL->conveyor->get_underrun_count() - this->start_underrun_cnt), (unsigned long)this->budget_used_cnt);
         } else {
             stream->printf("SD printing byte %lu/%lu\r\n", played_cnt, file_size);
         }
@@ -368,8 +450,7 @@ void Player::abort_command( string parameters, StreamOutput *stream )
     file_size = 0;
     this->filename = "";
     this->current_stream = NULL;
-    fclose(current_file_handler);
-    current_file_handler = NULL;
+    close_file();
     if(parameters.empty()) {
         // clear out the block queue, will wait until queue is empty
         // MUST be called in on_main_loop to make sure there are no blocked main loops waiting to put something on the queue
@@ -405,36 +486,41 @@ void Player::on_main_loop(void *argument)
             return;
         }
 
-        char buf[130]; // lines upto 128 characters are allowed, anything longer is discarded
-        bool discard = false;
-
-        while(fgets(buf, sizeof(buf), this->current_file_handler) != NULL) {
-            int len = strlen(buf);
-            if(len == 0) continue; // empty line? should not be possible
-            if(buf[len - 1] == '\n' || feof(this->current_file_handler)) {
-                if(discard) { // we are discarding a long line
-                    discard = false;
-                    continue;
-                }
-                if(len == 1) continue; // empty line
+        // feed lines until the queue is full or the time is up, so the other modules still get their main loop while
+        // the file keeps the queue full. A line that needs more room than there is still waits in the conveyor
+        uint32_t start = us_ticker_read();
+        char *line;
+        size_t len;
+        // lines upto 128 characters are allowed, anything longer is discarded
+        while((len = this->compiled_job ? next_record(line) : reader.next_line(line)) > 0) {
+            played_cnt += len;
+            if(line == nullptr) {
+                // discard long line
+                if(this->current_stream != nullptr) { this->current_stream->printf("Warning: Discarded long line\n"); }
+                continue;
+            }
 
+            if(line[0] != '\0') {
                 if(this->current_stream != nullptr) {
-                    this->current_stream->printf("%s", buf);
+                    this->current_stream->printf("%s\n", line);
                 }
 
                 struct SerialMessage message;
-                message.message = buf;
+                message.message = line;
                 message.stream = this->current_stream == nullptr ? &(StreamOutput::NullStream) : this->current_stream;
 
                 // waits for the queue to have enough room
                 THEKERNEL->call_event(ON_CONSOLE_LINE_RECEIVED, &message);
-                played_cnt += len;
-                return; // we feed one line per main loop
+                played_lines++;
+            }
 
-            } else {
-                // discard long line
-                if(this->current_stream != nullptr) { this->current_stream->printf("Warning: Discarded long line\n"); }
-                discard = true;
+            // the line may have paused, suspended or aborted the file, or started another one which carries on here
+            if(!this->playing_file || THEKERNEL->is_halted()) return;
+
+            if(THEKERNEL->conveyor->is_queue_full()) return;
+            if(us_ticker_read() - start >= time_budget_us) {
+                budget_used_cnt++;
+                return;
             }
         }
 
@@ -442,8 +528,7 @@ void Player::on_main_loop(void *argument)
         this->filename = "";
         played_cnt = 0;
         file_size = 0;
-        fclose(this->current_file_handler);
-        current_file_handler = NULL;
+        close_file();
         this->current_stream = NULL;
 
         if(this->reply_stream != NULL) {
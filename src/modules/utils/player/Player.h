@@ -9,6 +9,8 @@
 #pragma once
 
 #include "Module.h"
+#include "LineReader.h"
+#include "CompiledJob.h"
 
 #include <stdio.h>
 #include <string>
@@ -39,6 +41,11 @@ class Player : public Module {
         void resume_command( string parameters, StreamOutput* stream );
         string extract_options(string& args);
         void suspend_part2();
+        FILE *open_file(const string& name);
+        void file_opened();
+        bool seek_file(unsigned long pos);
+        size_t next_record(char *&line);
+        void close_file();
 
         string filename;
         string after_suspend_gcode;
@@ -48,9 +55,15 @@ class Player : public Module {
         StreamOutput* reply_stream;
 
         FILE* current_file_handler;
+        LineReader reader;
+        CompiledJob::record_t record;   // the last one read from a compiled job
         long file_size;
         unsigned long played_cnt;
         unsigned long elapsed_secs;
+        unsigned long played_lines;
+        uint32_t time_budget_us;        // most time each main loop spends feeding lines when the queue has room
+        uint32_t budget_used_cnt;       // main loops that fed lines until the time ran out rather than the queue filled
+        uint32_t start_underrun_cnt;    // the conveyor's underrun count when the file was started
         float saved_position[3]; // only saves XYZ
         std::map<uint16_t, float> saved_temperatures;
         struct {
@@ -61,6 +74,7 @@ class Player : public Module {
             bool was_playing_file:1;
             bool leave_heaters_on:1;
             bool override_leave_heaters_on:1;
+            bool compiled_job:1;             // the file is a CompiledJob, not Gcode
             uint8_t suspend_loops:4;
         };
 };
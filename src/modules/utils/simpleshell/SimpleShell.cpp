@@ -12,6 +12,7 @@
 #include "libs/utils.h"
 #include "libs/SerialMessage.h"
 #include "libs/StreamOutput.h"
+#include "libs/Profiler.h"
 #include "modules/robot/Conveyor.h"
 #include "DirHandle.h"
 #include "mri.h"
@@ -75,6 +76,7 @@ const SimpleShell::ptentry_t SimpleShell::commands_table[] = {
     {"?",        SimpleShell::help_command},
     {"version",  SimpleShell::version_command},
     {"mem",      SimpleShell::mem_command},
+    {"profile",  SimpleShell::profile_command},
     {"get",      SimpleShell::get_command},
     {"set_temp", SimpleShell::set_temp_command},
     {"switch",   SimpleShell::switch_command},
@@ -591,8 +593,24 @@ void SimpleShell::mem_command( string parameters, StreamOutput *stream)
         AHB1.debug(stream);
     }
 
-    size_t n= sizeof(Block::tickinfo_t) * Block::n_actuators;
-    stream->printf("Block size: %u bytes\n", sizeof(Block) + n);
+    stream->printf("Block size: %u bytes\n", sizeof(Block));
+}
+
+// profile on|off|reset, prints the cycle counts with no parameters
+void SimpleShell::profile_command( string parameters, StreamOutput *stream)
+{
+    string cmd = shift_parameter( parameters );
+    if (cmd == "on") {
+        Profiler::enable(true);
+    } else if (cmd == "off") {
+        Profiler::enable(false);
+    } else if (cmd == "reset") {
+        Profiler::reset();
+    } else if (!cmd.empty()) {
+        stream->printf("usage: profile [on|off|reset]\r\n");
+        return;
+    }
+    Profiler::dump(stream);
 }
 
 static uint32_t getDeviceType()
@@ -1127,6 +1145,7 @@ void SimpleShell::help_command( string parameters, StreamOutput *stream )
     stream->printf("Commands:\r\n");
     stream->printf("version\r\n");
     stream->printf("mem [-v]\r\n");
+    stream->printf("profile [on|off|reset] - cycles spent in the interrupts, the planner and each module's event handlers\r\n");
     stream->printf("ls [-s] [folder]\r\n");
     stream->printf("cd folder\r\n");
     stream->printf("pwd\r\n");
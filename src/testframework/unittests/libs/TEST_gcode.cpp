@@ -60,3 +60,49 @@ TEST(GCodeTest,subcode)
     ASSERT_EQUALS_DELTA_V(2.3, gc4.get_value('Y'), 0.001);
 
 }
+
+TEST(GCodeTest,letters)
+{
+    // the G word is not an argument once stripped, a letter on the line twice gets the first value
+    Gcode gc1("G1 X1 Y2 X3 T1", nullptr);
+    ASSERT_TRUE(gc1.has_g);
+    ASSERT_EQUALS_V(1, gc1.g);
+    ASSERT_TRUE(!gc1.has_letter('G'));
+    ASSERT_TRUE(gc1.has_letter('T'));
+    ASSERT_TRUE(!gc1.has_letter('Z'));
+    ASSERT_EQUALS_V(3, gc1.get_num_args());
+    ASSERT_EQUALS_V(2, gc1.get_args().size());
+    ASSERT_EQUALS_DELTA_V(1.0, gc1.get_value('X'), 0.001);
+    ASSERT_EQUALS_V(1, gc1.get_int('T'));
+
+    // one that is also after the stripped G word is still there
+    Gcode gc2("G10 L20 G1", nullptr);
+    ASSERT_TRUE(gc2.has_letter('G'));
+    ASSERT_EQUALS_V(1, gc2.get_int('G'));
+
+    // not stripped the command is not an argument either, letters not in the table are looked for in the text
+    Gcode gc3("N10 M105*12", nullptr, false);
+    ASSERT_TRUE(gc3.has_m);
+    ASSERT_EQUALS_V(105, gc3.m);
+    ASSERT_EQUALS_V(10, gc3.get_int('N'));
+    ASSERT_EQUALS_V(1, gc3.get_num_args());
+    ASSERT_EQUALS_V(12, gc3.get_int('*'));
+    ASSERT_TRUE(!gc3.has_letter('X'));
+
+    // a letter with no value is there with a value of 0
+    Gcode gc4("G28 X Y", nullptr);
+    ASSERT_TRUE(gc4.has_letter('Y'));
+    ASSERT_EQUALS_DELTA_V(0.0, gc4.get_value('Y'), 0.001);
+
+    // too long for the Gcode itself
+    std::string s("G1");
+    for (int i = 0; i < 20; ++i) s += " X1.23456 Y2.34567";
+    s += " Z3";
+    Gcode gc5(s, nullptr);
+    Gcode gc6(gc5);
+    gc5= gc1;
+    ASSERT_EQUALS_V(1, gc6.g);
+    ASSERT_EQUALS_DELTA_V(3.0, gc6.get_value('Z'), 0.001);
+    ASSERT_EQUALS_V(41, gc6.get_num_args());
+    ASSERT_EQUALS_DELTA_V(1.0, gc5.get_value('X'), 0.001);
+}